@@ -24,12 +24,40 @@
 #include <fifi/log_table.hpp>
 #include <fifi/extended_log_table.hpp>
 #include <fifi/optimal_prime.hpp>
+#include <fifi/split_table.hpp>
+#include <fifi/carryless_online.hpp>
 #include <fifi/binary8.hpp>
 #include <fifi/binary16.hpp>
+#include <fifi/binary32.hpp>
 #include <fifi/prime2325.hpp>
+#include <fifi/region_backend.hpp>
+#include <fifi/region_thresholds.hpp>
 
 #include "stacks.hpp"
 
+/// Forces the backend of a stack with region dispatchers
+///
+/// @return True if the stack uses the backend for multiply-add
+template<class FieldImpl>
+auto select_backend(FieldImpl& field, fifi::region_backend backend, int)
+    -> decltype(field.set_backend(backend), bool())
+{
+    field.set_backend(backend);
+
+    return backend == fifi::region_backend::automatic ||
+        field.backend(fifi::region_thresholds::region_multiply_add) ==
+        backend;
+}
+
+/// Stacks without region dispatchers only have the automatic backend
+///
+/// @return True if the backend is the automatic backend
+template<class FieldImpl>
+bool select_backend(FieldImpl&, fifi::region_backend backend, long)
+{
+    return backend == fifi::region_backend::automatic;
+}
+
 /// Benchmark fixture for the arithmetic benchmark
 template<class FieldImpl>
 class arithmetic_setup : public gauge::time_benchmark
@@ -82,41 +110,58 @@ public:
         auto vectors = options["vectors"].as<std::vector<uint32_t>>();
         auto operations = options["operations"].as<std::vector<std::string>>();
         auto access = options["access"].as<std::vector<std::string>>();
+        auto backends = options["backends"].as<std::vector<std::string>>();
 
         assert(sizes.size() > 0);
         assert(vectors.size() > 0);
         assert(operations.size() > 0);
         assert(access.size() > 0);
+        assert(backends.size() > 0);
 
-        for (const auto& s : sizes)
+        for (const auto& b : backends)
         {
-            for (const auto& v : vectors)
+            fifi::region_backend backend;
+            if (!fifi::region_backend_from_name(b, &backend))
+            {
+                throw std::runtime_error("Unknown backend " + b);
+            }
+
+            // Skip the backends which the stack or the CPU does not
+            // support, so all backends can be listed for all stacks
+            if (!select_backend(m_field, backend, 0))
+                continue;
+
+            for (const auto& s : sizes)
             {
-                for (const auto& o : operations)
+                for (const auto& v : vectors)
                 {
-                    for (const auto& a : access)
+                    for (const auto& o : operations)
                     {
-                        // The encoding benchmark pattern is not applicable
-                        // to multiply_constant
-                        if (o == "multiply_constant" && a == "encoding")
-                            continue;
-
-                        gauge::config_set cs;
-                        cs.set_value<uint32_t>("vector_size", s);
-
-                        // Based on the desired vector size (in bytes)
-                        // we calculate the length of the vector in
-                        // field elements
-                        assert((s % sizeof(value_type)) == 0);
-                        uint32_t length = s / sizeof(value_type);
-                        assert(length > 0);
-
-                        cs.set_value<uint32_t>("vector_length", length);
-                        cs.set_value<uint32_t>("vectors", v);
-                        cs.set_value<std::string>("operation", o);
-                        cs.set_value<std::string>("data_access", a);
-
-                        add_configuration(cs);
+                        for (const auto& a : access)
+                        {
+                            // The encoding benchmark pattern is not applicable
+                            // to multiply_constant
+                            if (o == "multiply_constant" && a == "encoding")
+                                continue;
+
+                            gauge::config_set cs;
+                            cs.set_value<uint32_t>("vector_size", s);
+
+                            // Based on the desired vector size (in bytes)
+                            // we calculate the length of the vector in
+                            // field elements
+                            assert((s % sizeof(value_type)) == 0);
+                            uint32_t length = s / sizeof(value_type);
+                            assert(length > 0);
+
+                            cs.set_value<uint32_t>("vector_length", length);
+                            cs.set_value<uint32_t>("vectors", v);
+                            cs.set_value<std::string>("operation", o);
+                            cs.set_value<std::string>("data_access", a);
+                            cs.set_value<std::string>("backend", b);
+
+                            add_configuration(cs);
+                        }
                     }
                 }
             }
@@ -131,6 +176,11 @@ public:
         uint32_t length = cs.get_value<uint32_t>("vector_length");
         uint32_t vectors = cs.get_value<uint32_t>("vectors");
 
+        fifi::region_backend backend = fifi::region_backend::automatic;
+        fifi::region_backend_from_name(
+            cs.get_value<std::string>("backend"), &backend);
+        select_backend(m_field, backend, 0);
+
         // Prepare the continuous data blocks
         m_data_one.resize(vectors * length);
         m_data_two.resize(vectors * length);
@@ -439,6 +489,18 @@ BENCHMARK_OPTION(arithmetic_options)
     options.add_options()
         ("access", default_access, "Set the data access pattern");
 
+    std::vector<std::string> backends;
+    backends.push_back("automatic");
+
+    auto default_backends =
+        gauge::po::value<std::vector<std::string> >()->default_value(
+            backends, "")->multitoken();
+
+    options.add_options()
+        ("backends", default_backends,
+         "Set the backends of the region operations e.g. basic, ssse3 or "
+         "avx2, the backends not supported by a stack are skipped");
+
     gauge::runner::instance().register_options(options);
 }
 
@@ -532,6 +594,40 @@ BENCHMARK_F(setup_extended_log_table_binary16, arithmetic,
     benchmark();
 }
 
+//------------------------------------------------------------------
+// SplitTable
+//------------------------------------------------------------------
+
+typedef arithmetic_setup<fifi::split_table<fifi::binary16>>
+    setup_split_table_binary16;
+
+BENCHMARK_F(setup_split_table_binary16, arithmetic, split_table_binary16, 5)
+{
+    benchmark();
+}
+
+//------------------------------------------------------------------
+// CarrylessOnline
+//------------------------------------------------------------------
+
+typedef arithmetic_setup<fifi::carryless_online<fifi::binary16>>
+    setup_carryless_online_binary16;
+
+BENCHMARK_F(setup_carryless_online_binary16, arithmetic,
+            carryless_online_binary16, 5)
+{
+    benchmark();
+}
+
+typedef arithmetic_setup<fifi::carryless_online<fifi::binary32>>
+    setup_carryless_online_binary32;
+
+BENCHMARK_F(setup_carryless_online_binary32, arithmetic,
+            carryless_online_binary32, 5)
+{
+    benchmark();
+}
+
 //------------------------------------------------------------------
 // OptimalPrime
 //------------------------------------------------------------------
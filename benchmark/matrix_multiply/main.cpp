@@ -0,0 +1,338 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <ctime>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <sak/aligned_allocator.hpp>
+
+#include <gauge/gauge.hpp>
+#include <gauge/console_printer.hpp>
+#include <gauge/csv_printer.hpp>
+#include <gauge/python_printer.hpp>
+
+#include <fifi/carryless_online.hpp>
+#include <fifi/fifi_utils.hpp>
+#include <fifi/full_table.hpp>
+#include <fifi/matrix_multiply.hpp>
+#include <fifi/optimal_prime.hpp>
+#include <fifi/simple_online.hpp>
+#include <fifi/split_table.hpp>
+
+/// Benchmark fixture for the matrix multiplication benchmark. The
+/// product C = A * B corresponds to the systematic encoding of a
+/// generation, where A is the symbols x symbols coefficient matrix and
+/// B holds the symbols.
+template<class FieldImpl>
+class matrix_multiply_setup : public gauge::time_benchmark
+{
+public:
+
+    /// The field implementation used
+    typedef FieldImpl field_impl;
+
+    /// The field type e.g. binary, binary8 etc
+    typedef typename field_impl::field_type field_type;
+
+    /// The value type of a field element
+    typedef typename field_type::value_type value_type;
+
+public:
+
+    double measurement()
+    {
+        // Get the time spent per iteration
+        double time = gauge::time_benchmark::measurement();
+
+        gauge::config_set cs = get_current_configuration();
+
+        uint32_t size = cs.get_value<uint32_t>("symbol_size");
+        uint32_t symbols = cs.get_value<uint32_t>("symbols");
+
+        // The number of bytes processed by the multiply-add operations
+        // in each iteration, i.e. every symbol is multiplied into every
+        // row of the result
+        uint64_t bytes = (uint64_t) size * symbols * symbols;
+
+        // The time is measured in microseconds
+        return bytes / time / 1000.0; // GB/s for each iteration
+    }
+
+    void store_run(tables::table& results)
+    {
+        if (!results.has_column("throughput"))
+            results.add_column("throughput");
+
+        results.set_value("throughput", measurement());
+    }
+
+    std::string unit_text() const
+    {
+        return "GB/s";
+    }
+
+    void get_options(gauge::po::variables_map& options)
+    {
+        auto sizes = options["size"].as<std::vector<uint32_t>>();
+        auto symbols = options["symbols"].as<std::vector<uint32_t>>();
+        auto algorithms =
+            options["algorithms"].as<std::vector<std::string>>();
+
+        assert(sizes.size() > 0);
+        assert(symbols.size() > 0);
+        assert(algorithms.size() > 0);
+
+        for (const auto& s : sizes)
+        {
+            for (const auto& g : symbols)
+            {
+                for (const auto& a : algorithms)
+                {
+                    gauge::config_set cs;
+                    cs.set_value<uint32_t>("symbol_size", s);
+
+                    // Based on the desired symbol size (in bytes) we
+                    // calculate the length of the symbol in value_type
+                    // elements
+                    assert((s % sizeof(value_type)) == 0);
+                    uint32_t length = s / sizeof(value_type);
+                    assert(length > 0);
+
+                    cs.set_value<uint32_t>("symbol_length", length);
+                    cs.set_value<uint32_t>("symbols", g);
+                    cs.set_value<std::string>("algorithm", a);
+
+                    add_configuration(cs);
+                }
+            }
+        }
+    }
+
+    /// Prepares the matrices between each run
+    void setup()
+    {
+        gauge::config_set cs = get_current_configuration();
+
+        uint32_t length = cs.get_value<uint32_t>("symbol_length");
+        uint32_t symbols = cs.get_value<uint32_t>("symbols");
+
+        m_coefficients.resize(
+            symbols * fifi::elements_to_length<field_type>(symbols));
+        m_symbols.resize(symbols * length);
+        m_result.resize(symbols * length);
+
+        uint32_t elements = fifi::length_to_elements<field_type>(
+            (uint32_t) m_coefficients.size());
+
+        for (uint32_t i = 0; i < elements; ++i)
+        {
+            fifi::set_value<field_type>(m_coefficients.data(), i,
+                rand() % field_type::order);
+        }
+
+        elements = fifi::length_to_elements<field_type>(
+            (uint32_t) m_symbols.size());
+
+        for (uint32_t i = 0; i < elements; ++i)
+        {
+            fifi::set_value<field_type>(m_symbols.data(), i,
+                rand() % field_type::order);
+        }
+    }
+
+    /// Computes the product with one region_multiply_add() call per
+    /// coefficient, making a full pass over each row of the result for
+    /// every symbol
+    void run_naive()
+    {
+        gauge::config_set cs = get_current_configuration();
+        uint32_t length = cs.get_value<uint32_t>("symbol_length");
+        uint32_t symbols = cs.get_value<uint32_t>("symbols");
+
+        uint32_t coefficients_length =
+            fifi::elements_to_length<field_type>(symbols);
+
+        RUN
+        {
+            std::fill(m_result.begin(), m_result.end(), 0);
+
+            for (uint32_t i = 0; i < symbols; ++i)
+            {
+                const value_type* coefficients =
+                    &m_coefficients[i * coefficients_length];
+
+                for (uint32_t k = 0; k < symbols; ++k)
+                {
+                    value_type constant = fifi::pack_constant<field_type>(
+                        fifi::get_value<field_type>(coefficients, k));
+
+                    m_field.region_multiply_add(&m_result[i * length],
+                        &m_symbols[k * length], constant, length);
+                }
+            }
+        }
+    }
+
+    /// Computes the product with the cache-blocked matrix_multiply()
+    void run_blocked()
+    {
+        gauge::config_set cs = get_current_configuration();
+        uint32_t length = cs.get_value<uint32_t>("symbol_length");
+        uint32_t symbols = cs.get_value<uint32_t>("symbols");
+
+        RUN
+        {
+            fifi::matrix_multiply(m_field, m_result.data(),
+                m_coefficients.data(), m_symbols.data(), symbols,
+                symbols, length);
+        }
+    }
+
+    /// Starts a new benchmark according to the current configuration
+    void benchmark()
+    {
+        gauge::config_set cs = get_current_configuration();
+        std::string algorithm = cs.get_value<std::string>("algorithm");
+
+        if (algorithm == "naive")
+        {
+            run_naive();
+        }
+        else if (algorithm == "blocked")
+        {
+            run_blocked();
+        }
+        else
+        {
+            throw std::runtime_error("Unknown algorithm type");
+        }
+    }
+
+protected:
+
+    /// The field implementation
+    field_impl m_field;
+
+    /// Type of the aligned vector
+    typedef std::vector<value_type, sak::aligned_allocator<value_type>>
+        aligned_vector;
+
+    /// The coefficient matrix A
+    aligned_vector m_coefficients;
+
+    /// The symbol matrix B
+    aligned_vector m_symbols;
+
+    /// The result matrix C
+    aligned_vector m_result;
+};
+
+/// Using this macro we may specify options. For specifying options
+/// we use the boost program options library. So you may additional
+/// details on how to do it in the manual for that library.
+BENCHMARK_OPTION(matrix_multiply_options)
+{
+    gauge::po::options_description options;
+
+    std::vector<uint32_t> size;
+    size.push_back(1600);
+    size.push_back(16000);
+
+    auto default_size =
+        gauge::po::value<std::vector<uint32_t>>()->default_value(
+            size, "")->multitoken();
+
+    std::vector<uint32_t> symbols;
+    symbols.push_back(16);
+    symbols.push_back(64);
+    symbols.push_back(128);
+
+    auto default_symbols =
+        gauge::po::value<std::vector<uint32_t>>()->default_value(
+            symbols, "")->multitoken();
+
+    std::vector<std::string> algorithms;
+    algorithms.push_back("naive");
+    algorithms.push_back("blocked");
+
+    auto default_algorithms =
+        gauge::po::value<std::vector<std::string> >()->default_value(
+            algorithms, "")->multitoken();
+
+    options.add_options()
+        ("size", default_size, "Set the size of a symbol in bytes");
+
+    options.add_options()
+        ("symbols", default_symbols, "Set the number of symbols");
+
+    options.add_options()
+        ("algorithms", default_algorithms, "Set the algorithms");
+
+    gauge::runner::instance().register_options(options);
+}
+
+typedef matrix_multiply_setup<fifi::simple_online<fifi::binary>>
+    setup_simple_online_binary;
+
+BENCHMARK_F(setup_simple_online_binary, matrix_multiply, binary, 5)
+{
+    benchmark();
+}
+
+typedef matrix_multiply_setup<fifi::full_table<fifi::binary4>>
+    setup_full_table_binary4;
+
+BENCHMARK_F(setup_full_table_binary4, matrix_multiply, binary4, 5)
+{
+    benchmark();
+}
+
+typedef matrix_multiply_setup<fifi::full_table<fifi::binary8>>
+    setup_full_table_binary8;
+
+BENCHMARK_F(setup_full_table_binary8, matrix_multiply, binary8, 5)
+{
+    benchmark();
+}
+
+typedef matrix_multiply_setup<fifi::split_table<fifi::binary16>>
+    setup_split_table_binary16;
+
+BENCHMARK_F(setup_split_table_binary16, matrix_multiply, binary16, 5)
+{
+    benchmark();
+}
+
+typedef matrix_multiply_setup<fifi::carryless_online<fifi::binary32>>
+    setup_carryless_online_binary32;
+
+BENCHMARK_F(setup_carryless_online_binary32, matrix_multiply, binary32, 5)
+{
+    benchmark();
+}
+
+typedef matrix_multiply_setup<fifi::optimal_prime<fifi::prime2325>>
+    setup_optimal_prime2325;
+
+BENCHMARK_F(setup_optimal_prime2325, matrix_multiply, prime2325, 5)
+{
+    benchmark();
+}
+
+int main(int argc, const char* argv[])
+{
+    srand(static_cast<uint32_t>(time(0)));
+
+    gauge::runner::add_default_printers();
+
+    gauge::runner::run_benchmarks(argc, argv);
+
+    return 0;
+}
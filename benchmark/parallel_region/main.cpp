@@ -0,0 +1,285 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sak/aligned_allocator.hpp>
+
+#include <gauge/gauge.hpp>
+#include <gauge/console_printer.hpp>
+#include <gauge/csv_printer.hpp>
+#include <gauge/python_printer.hpp>
+
+#include <fifi/binary8.hpp>
+#include <fifi/binary16.hpp>
+#include <fifi/fifi_utils.hpp>
+#include <fifi/full_table.hpp>
+#include <fifi/optimal_prime.hpp>
+#include <fifi/prime2325.hpp>
+#include <fifi/region_parallel.hpp>
+#include <fifi/split_table.hpp>
+#include <fifi/thread_pool.hpp>
+
+/// Benchmark fixture for the parallel region benchmark. The region
+/// operations are computed on large buffers by a region_parallel stack
+/// using thread pools of different sizes, so the throughput shows how
+/// the operations scale with the number of threads.
+template<class FieldImpl>
+class parallel_region_setup : public gauge::time_benchmark
+{
+public:
+
+    /// The field implementation used
+    typedef fifi::region_parallel<FieldImpl> field_impl;
+
+    /// The field type e.g. binary, binary8 etc
+    typedef typename field_impl::field_type field_type;
+
+    /// The value type of a field element
+    typedef typename field_type::value_type value_type;
+
+public:
+
+    double measurement()
+    {
+        // Get the time spent per iteration
+        double time = gauge::time_benchmark::measurement();
+
+        gauge::config_set cs = get_current_configuration();
+        uint32_t size = cs.get_value<uint32_t>("size");
+
+        // The time is measured in microseconds
+        return size / time / 1000.0; // GB/s for each iteration
+    }
+
+    void store_run(tables::table& results)
+    {
+        if (!results.has_column("throughput"))
+            results.add_column("throughput");
+
+        results.set_value("throughput", measurement());
+    }
+
+    std::string unit_text() const
+    {
+        return "GB/s";
+    }
+
+    void get_options(gauge::po::variables_map& options)
+    {
+        auto sizes = options["size"].as<std::vector<uint32_t>>();
+        auto threads = options["threads"].as<std::vector<uint32_t>>();
+        auto operations =
+            options["operations"].as<std::vector<std::string>>();
+
+        assert(sizes.size() > 0);
+        assert(threads.size() > 0);
+        assert(operations.size() > 0);
+
+        for (const auto& s : sizes)
+        {
+            for (const auto& o : operations)
+            {
+                for (const auto& t : threads)
+                {
+                    gauge::config_set cs;
+                    cs.set_value<uint32_t>("size", s);
+
+                    // Based on the desired size (in bytes) we calculate
+                    // the length of the buffers in value_type elements
+                    assert((s % sizeof(value_type)) == 0);
+                    uint32_t length = s / sizeof(value_type);
+                    assert(length > 0);
+
+                    cs.set_value<uint32_t>("length", length);
+                    cs.set_value<std::string>("operation", o);
+                    cs.set_value<uint32_t>("threads", t);
+
+                    add_configuration(cs);
+                }
+            }
+        }
+    }
+
+    /// Prepares the buffers and the thread pool between each run
+    void setup()
+    {
+        gauge::config_set cs = get_current_configuration();
+
+        uint32_t length = cs.get_value<uint32_t>("length");
+        uint32_t threads = cs.get_value<uint32_t>("threads");
+
+        if (!m_field.pool() || m_field.pool()->threads() != threads)
+        {
+            m_field.set_pool(std::make_shared<fifi::thread_pool>(threads));
+        }
+
+        m_dest.resize(length);
+        m_src.resize(length);
+
+        uint32_t elements = fifi::length_to_elements<field_type>(length);
+
+        for (uint32_t i = 0; i < elements; ++i)
+        {
+            fifi::set_value<field_type>(m_dest.data(), i,
+                rand() % field_type::order);
+            fifi::set_value<field_type>(m_src.data(), i,
+                rand() % field_type::order);
+        }
+
+        m_constant = fifi::pack_constant<field_type>(
+            rand() % field_type::order);
+    }
+
+    /// Starts a new benchmark according to the current configuration
+    void benchmark()
+    {
+        gauge::config_set cs = get_current_configuration();
+
+        uint32_t length = cs.get_value<uint32_t>("length");
+        std::string operation = cs.get_value<std::string>("operation");
+
+        value_type* dest = m_dest.data();
+        const value_type* src = m_src.data();
+
+        if (operation == "add")
+        {
+            RUN
+            {
+                m_field.region_add(dest, src, length);
+            }
+        }
+        else if (operation == "multiply_constant")
+        {
+            RUN
+            {
+                m_field.region_multiply_constant(dest, m_constant, length);
+            }
+        }
+        else if (operation == "multiply_add")
+        {
+            RUN
+            {
+                m_field.region_multiply_add(dest, src, m_constant, length);
+            }
+        }
+        else
+        {
+            throw std::runtime_error("Unknown operation type");
+        }
+    }
+
+protected:
+
+    /// The field implementation
+    field_impl m_field;
+
+    /// Type of the aligned vector
+    typedef std::vector<value_type, sak::aligned_allocator<value_type>>
+        aligned_vector;
+
+    /// The destination buffer
+    aligned_vector m_dest;
+
+    /// The source buffer
+    aligned_vector m_src;
+
+    /// The packed constant
+    value_type m_constant;
+};
+
+/// Using this macro we may specify options. For specifying options
+/// we use the boost program options library. So you may additional
+/// details on how to do it in the manual for that library.
+BENCHMARK_OPTION(parallel_region_options)
+{
+    gauge::po::options_description options;
+
+    std::vector<uint32_t> size;
+    size.push_back(1 << 20);
+    size.push_back(1 << 24);
+
+    auto default_size =
+        gauge::po::value<std::vector<uint32_t>>()->default_value(
+            size, "")->multitoken();
+
+    // One thread and then doubling up to the number of hardware threads
+    uint32_t hardware_threads =
+        std::max(std::thread::hardware_concurrency(), 1U);
+
+    std::vector<uint32_t> threads;
+    for (uint32_t t = 1; t < hardware_threads; t *= 2)
+    {
+        threads.push_back(t);
+    }
+    threads.push_back(hardware_threads);
+
+    auto default_threads =
+        gauge::po::value<std::vector<uint32_t>>()->default_value(
+            threads, "")->multitoken();
+
+    std::vector<std::string> operations;
+    operations.push_back("add");
+    operations.push_back("multiply_constant");
+    operations.push_back("multiply_add");
+
+    auto default_operations =
+        gauge::po::value<std::vector<std::string> >()->default_value(
+            operations, "")->multitoken();
+
+    options.add_options()
+        ("size", default_size, "Set the size of the buffers in bytes");
+
+    options.add_options()
+        ("threads", default_threads, "Set the number of threads");
+
+    options.add_options()
+        ("operations", default_operations, "Set the operations");
+
+    gauge::runner::instance().register_options(options);
+}
+
+typedef parallel_region_setup<fifi::full_table<fifi::binary8>>
+    setup_full_table_binary8;
+
+BENCHMARK_F(setup_full_table_binary8, parallel_region, binary8, 5)
+{
+    benchmark();
+}
+
+typedef parallel_region_setup<fifi::split_table<fifi::binary16>>
+    setup_split_table_binary16;
+
+BENCHMARK_F(setup_split_table_binary16, parallel_region, binary16, 5)
+{
+    benchmark();
+}
+
+typedef parallel_region_setup<fifi::optimal_prime<fifi::prime2325>>
+    setup_optimal_prime2325;
+
+BENCHMARK_F(setup_optimal_prime2325, parallel_region, prime2325, 5)
+{
+    benchmark();
+}
+
+int main(int argc, const char* argv[])
+{
+    srand(static_cast<uint32_t>(time(0)));
+
+    gauge::runner::add_default_printers();
+
+    gauge::runner::run_benchmarks(argc, argv);
+
+    return 0;
+}
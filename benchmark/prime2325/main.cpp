@@ -3,8 +3,11 @@
 // See accompanying file LICENSE.rst or
 // http://www.steinwurf.com/licensing
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
+#include <memory>
+#include <thread>
 #include <vector>
 #include <ctime>
 #include <cmath>
@@ -13,8 +16,12 @@
 #include <gauge/console_printer.hpp>
 #include <gauge/python_printer.hpp>
 
+#include <fifi/prime2325_apply_prefix.hpp>
 #include <fifi/prime2325_binary_search.hpp>
 #include <fifi/prime2325_bitmap.hpp>
+#include <fifi/prime2325_mapper.hpp>
+#include <fifi/prime2325_prefix_tracker.hpp>
+#include <fifi/thread_pool.hpp>
 
 std::vector<uint32_t> block_lengths()
 {
@@ -89,6 +96,122 @@ BENCHMARK_F(run_prime2325_bitmap, prime2325_bitmap, find_prefix, 5)
     (void)prefix;
 }
 
+/// Measures the pass over the data of the bitmap search alone, i.e.
+/// marking the prefixes of all values in the bitmap
+BENCHMARK_F(run_prime2325_bitmap, prime2325_bitmap, data_pass, 5)
+{
+
+    gauge::config_set cs = get_current_configuration();
+
+    uint32_t length = cs.get_value<uint32_t>("block_length");
+
+    fifi::prime2325_bitmap bitmap_search(length);
+
+    // This is where the clock runs
+    RUN
+    {
+        bitmap_search.build_bitmap(sak::storage(m_block));
+    }
+}
+
+/// Measures the search of the bitmap alone. The block holds the lowest
+/// prefixes, so the unused prefix is found after all the used ones,
+/// which is the worst case for the search.
+BENCHMARK_F(run_prime2325_bitmap, prime2325_bitmap, bitmap_scan, 5)
+{
+
+    gauge::config_set cs = get_current_configuration();
+
+    uint32_t length = cs.get_value<uint32_t>("block_length");
+
+    fifi::prime2325_bitmap bitmap_search(length);
+
+    for (uint32_t i = 0; i < length; ++i)
+        m_block[i] = i << bitmap_search.m_shift_prefix;
+
+    bitmap_search.build_bitmap(sak::storage(m_block));
+
+    volatile uint32_t prefix = 0;
+    // This is where the clock runs
+    RUN
+    {
+        uint32_t found = 0;
+        bitmap_search.find_in_bitmap(&found);
+        prefix = found;
+    }
+
+    (void)prefix;
+}
+
+/// Adds the block to a prime2325_prefix_tracker in packets of 1500
+/// bytes and finds the prefix once all packets have been added
+BENCHMARK_F(run_prime2325_bitmap, prime2325_prefix_tracker, add_packets, 5)
+{
+
+    gauge::config_set cs = get_current_configuration();
+
+    uint32_t length = cs.get_value<uint32_t>("block_length");
+    uint32_t packet = 1500 / 4;
+
+    fifi::prime2325_prefix_tracker tracker(length);
+
+    volatile uint32_t prefix = 0;
+    // This is where the clock runs
+    RUN
+    {
+        tracker.reset();
+
+        for (uint32_t offset = 0; offset < length; offset += packet)
+        {
+            tracker.add(&m_block[offset], std::min(packet, length - offset));
+        }
+
+        prefix = tracker.prefix();
+    }
+
+    (void)prefix;
+}
+
+/// Maps a copy of the block by copying it, finding the prefix and
+/// applying it, i.e. the mapping without a prime2325_mapper
+BENCHMARK_F(run_prime2325_bitmap, prime2325_mapper, copy_find_apply, 5)
+{
+
+    gauge::config_set cs = get_current_configuration();
+
+    uint32_t length = cs.get_value<uint32_t>("block_length");
+
+    fifi::prime2325_bitmap bitmap_search(length);
+    std::vector<uint32_t> dest(length);
+
+    // This is where the clock runs
+    RUN
+    {
+        std::copy(m_block.begin(), m_block.end(), dest.begin());
+
+        uint32_t prefix = bitmap_search.find_prefix(sak::storage(dest));
+        fifi::apply_prefix(sak::storage(dest), ~prefix);
+    }
+}
+
+/// Maps the block to a destination buffer with a prime2325_mapper
+BENCHMARK_F(run_prime2325_bitmap, prime2325_mapper, map_to, 5)
+{
+
+    gauge::config_set cs = get_current_configuration();
+
+    uint32_t length = cs.get_value<uint32_t>("block_length");
+
+    fifi::prime2325_mapper<fifi::prime2325_bitmap> mapper(length);
+    std::vector<uint32_t> dest(length);
+
+    // This is where the clock runs
+    RUN
+    {
+        mapper.map_to(sak::storage(m_block), dest.data());
+    }
+}
+
 /// This test shows how you can create configurations
 /// for the benchmarks. This could be different string
 /// lengths or similar
@@ -148,6 +271,31 @@ BENCHMARK_F(run_prime2325_binary_search,
     (void)prefix;
 }
 
+/// Splits the passes over the data across all hardware threads
+BENCHMARK_F(run_prime2325_binary_search,
+            prime2325_binary_search, find_prefix_parallel, 5)
+{
+
+    gauge::config_set cs = get_current_configuration();
+
+    uint32_t length = cs.get_value<uint32_t>("block_length");
+    uint32_t k = cs.get_value<uint32_t>("k");
+
+    uint32_t threads = std::max(std::thread::hardware_concurrency(), 1U);
+
+    fifi::prime2325_binary_search search(length, k);
+    search.set_pool(std::make_shared<fifi::thread_pool>(threads));
+
+    volatile uint32_t prefix = 0;
+    // This is where the clock runs
+    RUN
+    {
+        prefix = search.find_prefix(sak::storage(m_block));
+    }
+
+    (void)prefix;
+}
+
 int main(int argc, const char* argv[])
 {
     srand(static_cast<uint32_t>(time(0)));
@@ -0,0 +1,338 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <platform/config.hpp>
+#include <cpuid/cpuinfo.hpp>
+
+// Include x86 intrinsics for GCC-compatible compilers on x86/x86_64
+#if defined(PLATFORM_GCC_COMPATIBLE_X86)
+    #include <x86intrin.h>
+#endif
+
+#include "avx2_prime2325.hpp"
+
+namespace fifi
+{
+
+#ifdef PLATFORM_AVX2
+
+    namespace
+    {
+        /// Subtracts the elements of b from the elements of a modulo
+        /// 2^32 - 5. This is the vectorized version of
+        /// optimal_prime_arithmetic::subtract()
+        inline __m256i subtract(__m256i a, __m256i b, __m256i prime)
+        {
+            // a >= b holds in the lanes where max(a, b) equals a
+            __m256i no_underflow =
+                _mm256_cmpeq_epi32(_mm256_max_epu32(a, b), a);
+
+            // An underflow wraps modulo 2^32 so we add the prime in
+            // those lanes to get the result modulo 2^32 - 5
+            return _mm256_add_epi32(_mm256_sub_epi32(a, b),
+                                 _mm256_andnot_si256(no_underflow, prime));
+        }
+
+        /// Adds the elements of a and b modulo 2^32 - 5
+        inline __m256i add(__m256i a, __m256i b, __m256i prime)
+        {
+            // a + b is computed as a - (prime - b) which avoids
+            // detecting the 32 bit overflow of the sum
+            return subtract(a, _mm256_sub_epi32(prime, b), prime);
+        }
+
+        /// Reduces the 64 bit products in each lane modulo 2^32 - 5
+        /// using that 2^32 = 5 modulo 2^32 - 5. The result is left in
+        /// the low 32 bits of each lane.
+        inline __m256i reduce(__m256i c, __m256i low_mask, __m256i five)
+        {
+            // Fold the high 32 bits, the sum is below 6 * 2^32
+            c = _mm256_add_epi64(_mm256_and_si256(c, low_mask),
+                              _mm256_mul_epu32(_mm256_srli_epi64(c, 32), five));
+
+            // Fold again, the sum is now below 2^32 + 25
+            c = _mm256_add_epi64(_mm256_and_si256(c, low_mask),
+                              _mm256_mul_epu32(_mm256_srli_epi64(c, 32), five));
+
+            // If c >= 2^32 - 5 then c + 5 carries into the high 32
+            // bits, in which case subtracting the prime is the same as
+            // adding 5 to the low 32 bits
+            __m256i carry = _mm256_srli_epi64(_mm256_add_epi64(c, five), 32);
+            return _mm256_add_epi64(c, _mm256_mul_epu32(carry, five));
+        }
+
+        /// Multiplies the elements with the constant modulo 2^32 - 5
+        inline __m256i multiply(__m256i v, __m256i constant,
+            __m256i low_mask, __m256i five)
+        {
+            // _mm256_mul_epu32 multiplies the even elements so the odd
+            // elements are shifted down before they are multiplied
+            __m256i even = _mm256_mul_epu32(v, constant);
+            __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(v, 32), constant);
+
+            even = reduce(even, low_mask, five);
+            odd = reduce(odd, low_mask, five);
+
+            // Move the odd results back in place and merge them with the
+            // even results
+            return _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+        }
+    }
+
+    void avx2_prime2325::region_add(
+        value_type* dest, const value_type* src, uint32_t length) const
+    {
+        assert(dest != 0);
+        assert(src != 0);
+        assert(length > 0);
+        assert((length % granularity()) == 0);
+
+        // We loop 8 elements at-a-time so we calculate how many loops we need
+        uint32_t avx2_size = length / granularity();
+        assert(avx2_size > 0);
+
+        __m256i prime = _mm256_set1_epi32(field_type::prime);
+
+        __m256i* src_ptr = (__m256i*)src;
+        __m256i* dest_ptr = (__m256i*)dest;
+        for (uint32_t i = 0; i < avx2_size; i++, src_ptr++, dest_ptr++)
+        {
+            // Load the next 32-bytes of the destination and source buffers
+            __m256i ymm0 = _mm256_loadu_si256(dest_ptr);
+            __m256i ymm1 = _mm256_loadu_si256(src_ptr);
+            // Add these values together
+            ymm0 = add(ymm0, ymm1, prime);
+            // Store the result in the destination buffer
+            _mm256_storeu_si256(dest_ptr, ymm0);
+        }
+    }
+
+    void avx2_prime2325::region_subtract(
+        value_type* dest, const value_type* src, uint32_t length) const
+    {
+        assert(dest != 0);
+        assert(src != 0);
+        assert(length > 0);
+        assert((length % granularity()) == 0);
+
+        // We loop 8 elements at-a-time so we calculate how many loops we need
+        uint32_t avx2_size = length / granularity();
+        assert(avx2_size > 0);
+
+        __m256i prime = _mm256_set1_epi32(field_type::prime);
+
+        __m256i* src_ptr = (__m256i*)src;
+        __m256i* dest_ptr = (__m256i*)dest;
+        for (uint32_t i = 0; i < avx2_size; i++, src_ptr++, dest_ptr++)
+        {
+            // Load the next 32-bytes of the destination and source buffers
+            __m256i ymm0 = _mm256_loadu_si256(dest_ptr);
+            __m256i ymm1 = _mm256_loadu_si256(src_ptr);
+            // Subtract the source values from the destination values
+            ymm0 = subtract(ymm0, ymm1, prime);
+            // Store the result in the destination buffer
+            _mm256_storeu_si256(dest_ptr, ymm0);
+        }
+    }
+
+    void avx2_prime2325::region_multiply_constant(
+        value_type* dest, value_type constant, uint32_t length) const
+    {
+        assert(dest != 0);
+        assert(length > 0);
+        assert((length % granularity()) == 0);
+
+        // We loop 8 elements at-a-time so we calculate how many loops we need
+        uint32_t avx2_size = length / granularity();
+        assert(avx2_size > 0);
+
+        __m256i c = _mm256_set1_epi32(constant);
+        __m256i low_mask = _mm256_set1_epi64x(0xffffffff);
+        __m256i five = _mm256_set1_epi64x(5);
+
+        __m256i* dest_ptr = (__m256i*)dest;
+        for (uint32_t i = 0; i < avx2_size; i++, dest_ptr++)
+        {
+            // Load the next 32-bytes of the destination buffer
+            __m256i ymm0 = _mm256_loadu_si256(dest_ptr);
+            // Multiply the elements with the constant
+            ymm0 = multiply(ymm0, c, low_mask, five);
+            // Store the result in the destination buffer
+            _mm256_storeu_si256(dest_ptr, ymm0);
+        }
+    }
+
+    void avx2_prime2325::region_multiply_add(value_type* dest,
+        const value_type* src, value_type constant, uint32_t length) const
+    {
+        assert(dest != 0);
+        assert(src != 0);
+        assert(length > 0);
+        assert((length % granularity()) == 0);
+
+        // We loop 8 elements at-a-time so we calculate how many loops we need
+        uint32_t avx2_size = length / granularity();
+        assert(avx2_size > 0);
+
+        __m256i c = _mm256_set1_epi32(constant);
+        __m256i low_mask = _mm256_set1_epi64x(0xffffffff);
+        __m256i five = _mm256_set1_epi64x(5);
+        __m256i prime = _mm256_set1_epi32(field_type::prime);
+
+        __m256i* src_ptr = (__m256i*)src;
+        __m256i* dest_ptr = (__m256i*)dest;
+        for (uint32_t i = 0; i < avx2_size; i++, src_ptr++, dest_ptr++)
+        {
+            // Load the next 32-bytes of the source buffer
+            __m256i ymm0 = _mm256_loadu_si256(src_ptr);
+            // Multiply the src with the constant
+            ymm0 = multiply(ymm0, c, low_mask, five);
+            // Load the next 32-bytes of the destination buffer
+            __m256i ymm1 = _mm256_loadu_si256(dest_ptr);
+            // Add the multiplication result to the destination value
+            ymm0 = add(ymm1, ymm0, prime);
+            // Store the result in the destination buffer
+            _mm256_storeu_si256(dest_ptr, ymm0);
+        }
+    }
+
+    void avx2_prime2325::region_multiply_subtract(value_type* dest,
+        const value_type* src, value_type constant, uint32_t length) const
+    {
+        assert(dest != 0);
+        assert(src != 0);
+        assert(length > 0);
+        assert((length % granularity()) == 0);
+
+        // We loop 8 elements at-a-time so we calculate how many loops we need
+        uint32_t avx2_size = length / granularity();
+        assert(avx2_size > 0);
+
+        __m256i c = _mm256_set1_epi32(constant);
+        __m256i low_mask = _mm256_set1_epi64x(0xffffffff);
+        __m256i five = _mm256_set1_epi64x(5);
+        __m256i prime = _mm256_set1_epi32(field_type::prime);
+
+        __m256i* src_ptr = (__m256i*)src;
+        __m256i* dest_ptr = (__m256i*)dest;
+        for (uint32_t i = 0; i < avx2_size; i++, src_ptr++, dest_ptr++)
+        {
+            // Load the next 32-bytes of the source buffer
+            __m256i ymm0 = _mm256_loadu_si256(src_ptr);
+            // Multiply the src with the constant
+            ymm0 = multiply(ymm0, c, low_mask, five);
+            // Load the next 32-bytes of the destination buffer
+            __m256i ymm1 = _mm256_loadu_si256(dest_ptr);
+            // Subtract the multiplication result from the destination value
+            ymm0 = subtract(ymm1, ymm0, prime);
+            // Store the result in the destination buffer
+            _mm256_storeu_si256(dest_ptr, ymm0);
+        }
+    }
+
+    uint32_t avx2_prime2325::alignment() const
+    {
+        return sizeof(value_type);
+    }
+
+    uint32_t avx2_prime2325::max_alignment() const
+    {
+        return alignment();
+    }
+
+    uint32_t avx2_prime2325::granularity() const
+    {
+        // We are working over 32 bytes at a time i.e. 256 bits so we
+        // require a length granularity of 8 elements. We expect that
+        // prime2325 uses uint32_t as value_type
+        static_assert(std::is_same<value_type, uint32_t>::value,
+                      "Here we expect prime2325 to use uint32_t as value_type");
+        return 8U;
+    }
+
+    uint32_t avx2_prime2325::max_granularity() const
+    {
+        return granularity();
+    }
+
+    bool avx2_prime2325::enabled() const
+    {
+        static cpuid::cpuinfo info;
+        return info.has_avx2();
+    }
+
+#else
+
+    void avx2_prime2325::region_add(
+        value_type*, const value_type*, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
+    void avx2_prime2325::region_subtract(
+        value_type*, const value_type*, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
+    void avx2_prime2325::region_multiply_constant(
+        value_type*, value_type, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
+    void avx2_prime2325::region_multiply_add(
+        value_type*, const value_type*, value_type, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
+    void avx2_prime2325::region_multiply_subtract(
+        value_type*, const value_type*, value_type, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
+    uint32_t avx2_prime2325::alignment() const
+    {
+        // Not implemented
+        assert(0);
+        return 0;
+    }
+
+    uint32_t avx2_prime2325::max_alignment() const
+    {
+        // Not implemented
+        assert(0);
+        return 0;
+    }
+
+    uint32_t avx2_prime2325::granularity() const
+    {
+        // Not implemented
+        assert(0);
+        return 0;
+    }
+
+    uint32_t avx2_prime2325::max_granularity() const
+    {
+        // Not implemented
+        assert(0);
+        return 0;
+    }
+
+    bool avx2_prime2325::enabled() const
+    {
+        return false;
+    }
+
+#endif
+
+}
@@ -0,0 +1,125 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <platform/config.hpp>
+#include <cpuid/cpuinfo.hpp>
+
+// Include x86 intrinsics for GCC-compatible compilers on x86/x86_64
+#if defined(PLATFORM_GCC_COMPATIBLE_X86)
+    #include <x86intrin.h>
+#endif
+
+#include "avx2_prime2325_bitmap.hpp"
+
+namespace fifi
+{
+
+#ifdef PLATFORM_AVX2
+
+    namespace
+    {
+        /// Updates the bitmaps with the number of bitmaps known at
+        /// compile-time, so each of the eight values computed together
+        /// goes to a fixed bitmap
+        template<uint32_t Bitmaps>
+        void update(uint32_t* bitmaps, uint32_t bitmap_words,
+            const uint32_t* data, uint32_t size, uint32_t shift_prefix)
+        {
+            uint32_t* bitmap[Bitmaps];
+            for (uint32_t i = 0; i < Bitmaps; ++i)
+            {
+                bitmap[i] = bitmaps + i * bitmap_words;
+            }
+
+            // The index of the word is the prefix divided by 32 and the
+            // bit is the prefix modulo 32
+            __m128i shift_word = _mm_cvtsi32_si128(shift_prefix + 5);
+            __m128i shift_bit = _mm_cvtsi32_si128(shift_prefix);
+            __m256i mask = _mm256_set1_epi32(31);
+            __m256i one = _mm256_set1_epi32(1);
+
+            alignas(32) uint32_t index[8];
+            alignas(32) uint32_t bit[8];
+
+            uint32_t i = 0;
+            for (; i + 8 <= size; i += 8)
+            {
+                __m256i v = _mm256_loadu_si256((const __m256i*)(data + i));
+
+                __m256i w = _mm256_srl_epi32(v, shift_word);
+                __m256i b = _mm256_sllv_epi32(one,
+                    _mm256_and_si256(_mm256_srl_epi32(v, shift_bit), mask));
+
+                _mm256_store_si256((__m256i*)index, w);
+                _mm256_store_si256((__m256i*)bit, b);
+
+                for (uint32_t k = 0; k < 8; ++k)
+                {
+                    bitmap[k % Bitmaps][index[k]] |= bit[k];
+                }
+            }
+
+            // Update the bitmap with the remaining values
+            for (; i < size; ++i)
+            {
+                uint32_t prefix = data[i] >> shift_prefix;
+                assert((prefix >> 5) < bitmap_words);
+                bitmap[0][prefix >> 5] |= 1U << (prefix & 31);
+            }
+        }
+    }
+
+    void avx2_prime2325_bitmap::update_bitmaps(mapping_type* bitmaps,
+        uint32_t bitmap_words, uint32_t bitmap_count, const uint32_t* data,
+        uint32_t size, uint32_t shift_prefix) const
+    {
+        assert(bitmaps != 0);
+        assert(bitmap_words > 0);
+        assert(data != 0 || size == 0);
+        assert(shift_prefix < 32);
+
+        switch (bitmap_count)
+        {
+        case 1:
+            update<1>(bitmaps, bitmap_words, data, size, shift_prefix);
+            break;
+        case 2:
+            update<2>(bitmaps, bitmap_words, data, size, shift_prefix);
+            break;
+        case 4:
+            update<4>(bitmaps, bitmap_words, data, size, shift_prefix);
+            break;
+        case 8:
+            update<8>(bitmaps, bitmap_words, data, size, shift_prefix);
+            break;
+        default:
+            assert(0 && "The number of bitmaps must be 1, 2, 4 or 8");
+            break;
+        }
+    }
+
+    bool avx2_prime2325_bitmap::enabled() const
+    {
+        static cpuid::cpuinfo info;
+        return info.has_avx2();
+    }
+
+#else
+
+    void avx2_prime2325_bitmap::update_bitmaps(mapping_type*, uint32_t,
+        uint32_t, const uint32_t*, uint32_t, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
+    bool avx2_prime2325_bitmap::enabled() const
+    {
+        return false;
+    }
+
+#endif
+
+}
@@ -0,0 +1,60 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+namespace fifi
+{
+    /// avx2_prime2325_bitmap
+    ///
+    /// AVX2 accelerated update of the bitmaps used by prime2325_bitmap.
+    /// The prefixes of eight values are computed at a time, and the
+    /// values are spread over a number of private bitmaps, so consecutive
+    /// values with the same prefix do not wait for each other's
+    /// read-modify-write of the same bitmap word. The private bitmaps are
+    /// OR-merged by the caller. The following intrinsics are used
+    /// available in the following SIMD versions:
+    ///
+    /// _mm_cvtsi32_si128 (SSE2)
+    /// _mm256_loadu_si256 (AVX)
+    /// _mm256_set1_epi32 (AVX)
+    /// _mm256_store_si256 (AVX)
+    /// _mm256_srl_epi32 (AVX2)
+    /// _mm256_sllv_epi32 (AVX2)
+    /// _mm256_and_si256 (AVX2)
+    ///
+    /// Based on this we see that the minimum required instruction for this
+    /// optimization is the Advanced Vector Extensions 2 (AVX2).
+    class avx2_prime2325_bitmap
+    {
+    public:
+
+        /// The data type used for the bitmaps
+        typedef uint32_t mapping_type;
+
+    public:
+
+        /// Marks the prefixes of the values as used. Value i updates
+        /// bitmap i % bitmaps.
+        ///
+        /// @param bitmaps The bitmaps stored one after the other
+        /// @param bitmap_words The number of words in each bitmap
+        /// @param bitmap_count The number of bitmaps, must be 1, 2, 4 or 8
+        /// @param data The values
+        /// @param size The number of values
+        /// @param shift_prefix The amount to shift a value to get its
+        ///        prefix
+        void update_bitmaps(mapping_type* bitmaps, uint32_t bitmap_words,
+            uint32_t bitmap_count, const uint32_t* data, uint32_t size,
+            uint32_t shift_prefix) const;
+
+        /// @return true if the executable was built with AVX2
+        ///         prime2325 bitmap support
+        bool enabled() const;
+    };
+}
@@ -0,0 +1,23 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <platform/config.hpp>
+
+// This file causes double definition warnings with MSVC
+#if !defined(PLATFORM_MSVC)
+
+#include "binary32.hpp"
+
+namespace fifi
+{
+    const binary32::value_type binary32::max_value;
+    const binary32::value_type binary32::min_value;
+    const binary32::order_type binary32::order;
+    const binary32::degree_type binary32::degree;
+    const binary32::value_type binary32::prime;
+    const bool binary32::is_exact;
+}
+
+#endif
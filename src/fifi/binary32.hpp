@@ -0,0 +1,55 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+
+namespace fifi
+{
+    /// A binary extension field with 2^32 elements
+    struct binary32
+    {
+        /// The data type used for each element
+        typedef uint32_t value_type;
+
+        /// Pointer to a value_type
+        typedef value_type* value_ptr;
+
+        /// Reference to a value_type
+        typedef value_type& value_ref;
+
+        /// The data type used to hold the order of the field
+        /// i.e. the number of elements. The order does not fit in
+        /// the value_type so a 64 bit type is used.
+        typedef uint64_t order_type;
+
+        /// The data type used to hold the degree of the field
+        typedef value_type degree_type;
+
+        /// The maximum decimal value of any field element
+        const static value_type max_value = 4294967295U;
+
+        /// The minimum decimal value for any field element
+        const static value_type min_value = 0;
+
+        /// The field order i.e. number of field elements
+        const static order_type order = 4294967296ULL;
+
+        /// The field degree
+        const static degree_type degree = 32;
+
+        /// X^32+X^22+X^2+X+1 = 4299161607 We do not need the top bit
+        /// so we just use: X^22+X^2+X+1 = 4194311 We do not need the
+        /// top bit since this bit is not representable in the
+        /// field. Our algorithms should manage whether it it necessary
+        /// to reduce an element, if needed only lower bits of the
+        /// prime is needed.
+        const static value_type prime = 4194311U;
+
+        /// A boolean determing whether the fields value type is exact
+        const static bool is_exact = true;
+    };
+}
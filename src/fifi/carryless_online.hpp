@@ -0,0 +1,39 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "binary4_packed_arithmetic.hpp"
+#include "final.hpp"
+#include "packed_arithmetic.hpp"
+#include "pclmul_binary16_online.hpp"
+#include "pclmul_binary32_online.hpp"
+#include "region_arithmetic.hpp"
+#include "region_dispatcher.hpp"
+#include "region_divide_granularity.hpp"
+#include "region_info.hpp"
+#include "simple_online_arithmetic.hpp"
+
+namespace fifi
+{
+    /// The carry-less online stack. This stack does not use any
+    /// look-up tables which makes it usable for the binary32 field
+    /// where tables are not feasible. The region operations are
+    /// dispatched to stacks using the carry-less multiplication
+    /// instruction with Barrett reduction, while the remaining
+    /// computations are done by the simple online arithmetic.
+    template<class Field>
+    class carryless_online : public
+        region_divide_granularity<
+        region_dispatcher<pclmul_binary16_online,
+        region_dispatcher<pclmul_binary32_online,
+        region_arithmetic<
+        region_info<
+        binary4_packed_arithmetic<Field,
+        packed_arithmetic<
+        simple_online_arithmetic<
+        final<Field> > > > > > > > >
+    { };
+}
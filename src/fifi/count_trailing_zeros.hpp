@@ -0,0 +1,44 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+#include <platform/config.hpp>
+
+#if defined(PLATFORM_MSVC)
+    #include <intrin.h>
+#endif
+
+namespace fifi
+{
+    /// Counts the zero bits below the lowest set bit of a value, using
+    /// the bit scan instruction of the CPU where the compiler exposes it
+    ///
+    /// @param value The value, must not be zero
+    /// @return The index of the lowest set bit of the value
+    inline uint32_t count_trailing_zeros(uint32_t value)
+    {
+        assert(value != 0);
+
+#if defined(PLATFORM_GCC_COMPATIBLE)
+        return (uint32_t) __builtin_ctz(value);
+#elif defined(PLATFORM_MSVC)
+        unsigned long index;
+        _BitScanForward(&index, value);
+        return (uint32_t) index;
+#else
+        uint32_t count = 0;
+        while ((value & 1U) == 0)
+        {
+            value >>= 1;
+            ++count;
+        }
+        return count;
+#endif
+    }
+}
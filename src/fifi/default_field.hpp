@@ -8,12 +8,15 @@
 #include "binary.hpp"
 #include "binary4.hpp"
 #include "binary16.hpp"
+#include "binary32.hpp"
 #include "binary8.hpp"
+#include "carryless_online.hpp"
 #include "extended_log_table.hpp"
 #include "full_table.hpp"
 #include "optimal_prime.hpp"
 #include "prime2325.hpp"
 #include "simple_online.hpp"
+#include "split_table.hpp"
 
 namespace fifi
 {
@@ -53,7 +56,15 @@ namespace fifi
     struct default_field<binary16>
     {
         /// default field implementation type
-        typedef extended_log_table<binary16> type;
+        typedef split_table<binary16> type;
+    };
+
+    /// For the binary32 field
+    template<>
+    struct default_field<binary32>
+    {
+        /// default field implementation type
+        typedef carryless_online<binary32> type;
     };
 
     /// For the prime2325 field
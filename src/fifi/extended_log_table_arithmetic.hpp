@@ -6,13 +6,17 @@
 #pragma once
 
 #include <cassert>
+#include <type_traits>
 #include <vector>
 
 #include <boost/static_assert.hpp>
 
 #include "binary.hpp"
+#include "binary32.hpp"
+#include "field_tables.hpp"
 #include "is_valid_element.hpp"
 #include "prime2325.hpp"
+#include "shared_table.hpp"
 
 namespace fifi
 {
@@ -41,44 +45,67 @@ namespace fifi
         static_assert(!std::is_same<binary, field_type>::value,
             "This layer does not support the binary field");
 
+        /// Check for binary32 field, the tables would not fit in memory
+        static_assert(!std::is_same<binary32, field_type>::value,
+            "This layer does not support the binary32 field");
+
     public:
 
-        /// Constructor
-        extended_log_table_arithmetic()
+        /// The log and extended antilog tables for fields without
+        /// generated tables @see field_tables. The tables are built
+        /// once and shared by all instances @see shared_table()
+        struct tables
         {
-            m_log_data.resize(field_type::order, '\0');
-            m_antilog_data.resize((3 * field_type::order) - 5, '\0');
+            /// Builds the tables using the arithmetics of Super
+            tables()
+            {
+                Super field;
 
-            // Array offsets
-            uint32_t low_offset  = 0;
-            uint32_t mid_offset  = low_offset + field_type::order - 2;
-            uint32_t high_offset = mid_offset + field_type::order - 1;
+                m_log_data.resize(field_type::order, '\0');
+                m_antilog_data.resize((3 * field_type::order) - 5, '\0');
 
-            // initial value corresponds x^0
-            value_type power = 1;
+                // Array offsets
+                uint32_t low_offset  = 0;
+                uint32_t mid_offset  = low_offset + field_type::order - 2;
+                uint32_t high_offset = mid_offset + field_type::order - 1;
 
-            for (order_type i = 0; i < field_type::order - 1; ++i)
-            {
-                m_log_data[power] = i;
-                m_antilog_data[mid_offset + i] = power;
+                // initial value corresponds x^0
+                value_type power = 1;
 
-                // The decimal value 2 corresponds to the
-                // polynomial element 'x'
-                power = Super::multiply(2U, power);
-            }
+                for (order_type i = 0; i < field_type::order - 1; ++i)
+                {
+                    m_log_data[power] = i;
+                    m_antilog_data[mid_offset + i] = power;
 
-            for (order_type i = 0; i < field_type::order - 2; ++i)
-            {
-                m_antilog_data[low_offset  + i] =
-                    m_antilog_data[mid_offset + i + 1];
+                    // The decimal value 2 corresponds to the
+                    // polynomial element 'x'
+                    power = field.multiply(2U, power);
+                }
+
+                for (order_type i = 0; i < field_type::order - 2; ++i)
+                {
+                    m_antilog_data[low_offset  + i] =
+                        m_antilog_data[mid_offset + i + 1];
 
-                m_antilog_data[high_offset + i] =
-                    m_antilog_data[mid_offset + i];
+                    m_antilog_data[high_offset + i] =
+                        m_antilog_data[mid_offset + i];
+                }
             }
 
-            // Set the pointers
-            m_log = &m_log_data[0];
-            m_antilog = &m_antilog_data[0] + field_type::order - 2;
+            /// The Log table
+            std::vector<value_type> m_log_data;
+
+            /// The AntiLog table
+            std::vector<value_type> m_antilog_data;
+        };
+
+    public:
+
+        /// Constructor
+        extended_log_table_arithmetic()
+        {
+            initialize_tables(std::integral_constant<bool,
+                field_tables<field_type>::available>());
         }
 
         /// @copydoc layer::multiply(value_type, value_type) const
@@ -122,19 +149,33 @@ namespace fifi
 
     private:
 
-        /// The Log table
-        std::vector<value_type> m_log_data;
+        /// Uses the tables generated at compile-time
+        void initialize_tables(std::true_type)
+        {
+            m_log = field_tables<field_type>::log();
+            m_antilog = field_tables<field_type>::extended_antilog() +
+                field_type::order - 2;
+        }
+
+        /// Uses the tables built at run-time
+        void initialize_tables(std::false_type)
+        {
+            const tables& shared = shared_table<tables>();
+
+            // Set the pointers
+            m_log = &shared.m_log_data[0];
+            m_antilog = &shared.m_antilog_data[0] + field_type::order - 2;
+        }
 
-        /// Pointer to the Log table data
-        value_type* m_log;
+    private:
 
-        /// The AntiLog table
-        std::vector<value_type> m_antilog_data;
+        /// Pointer to the shared Log table data
+        const value_type* m_log;
 
-        /// Pointer to the AntiLog table data, adjusted so that
+        /// Pointer to the shared AntiLog table data, adjusted so that
         /// negative exponent sums are handled.
         /// I.e. m_antilog[-1] is valid.
-        value_type* m_antilog;
+        const value_type* m_antilog;
 
     };
 }
@@ -0,0 +1,329 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <cstdint>
+
+#include "field_tables.hpp"
+
+namespace fifi
+{
+    namespace
+    {
+        /// A compile-time sequence of indices, the tables are generated
+        /// by expanding the indices of their entries
+        template<uint32_t... Indices>
+        struct index_sequence
+        {
+            typedef index_sequence type;
+        };
+
+        /// Joins two index sequences, the second of which is offset by
+        /// the size of the first
+        template<class First, class Second>
+        struct concat_sequence;
+
+        template<uint32_t... First, uint32_t... Second>
+        struct concat_sequence<index_sequence<First...>,
+                               index_sequence<Second...>>
+            : index_sequence<First..., (sizeof...(First) + Second)...>
+        { };
+
+        /// Creates the index sequence 0, 1, ..., Size - 1. The sequence
+        /// is split in halves to keep the instantiation depth
+        /// logarithmic in the size
+        template<uint32_t Size>
+        struct make_index_sequence : concat_sequence<
+            typename make_index_sequence<Size / 2>::type,
+            typename make_index_sequence<Size - (Size / 2)>::type>
+        { };
+
+        template<>
+        struct make_index_sequence<0> : index_sequence<>
+        { };
+
+        template<>
+        struct make_index_sequence<1> : index_sequence<0>
+        { };
+
+        /// A table which can be constant initialized. The tables are 16
+        /// byte aligned as required by the SIMD stacks.
+        template<class Value, uint32_t Size>
+        struct alignas(16) table
+        {
+            Value m_values[Size];
+        };
+
+        /// @return The product of the element and the element 'x' i.e.
+        ///         the polynomial shifted one degree up and reduced
+        template<class Field>
+        constexpr uint32_t multiply_by_x(uint32_t a)
+        {
+            return ((a << 1) & Field::max_value) ^
+                (((a >> (Field::degree - 1)) & 1) ? Field::prime : 0);
+        }
+
+        /// @return The element 2^exponent
+        template<class Field>
+        constexpr uint32_t power(uint32_t exponent)
+        {
+            return exponent == 0 ? 1 :
+                multiply_by_x<Field>(power<Field>(exponent - 1));
+        }
+
+        /// @return The exponent of the non-zero element, found by
+        ///         searching from the given exponent and its power
+        template<class Field>
+        constexpr uint32_t find_log(uint32_t a, uint32_t exponent,
+                                    uint32_t current)
+        {
+            return current == a ? exponent :
+                find_log<Field>(a, exponent + 1, multiply_by_x<Field>(current));
+        }
+
+        /// Generates the tables of a field. The log and antilog tables
+        /// are generated from the powers of 'x', and the other tables
+        /// are generated using these
+        template<class Field>
+        struct generator
+        {
+            /// The value type of the field
+            typedef typename Field::value_type value_type;
+
+            /// The field order
+            static const uint32_t order = Field::order;
+
+            /// A table with an entry per element
+            typedef table<value_type, order> element_table;
+
+            /// A table with an entry per exponent of the extended
+            /// antilog table
+            typedef table<value_type, (3 * order) - 5> extended_table;
+
+            /// A table with a row per element
+            typedef table<table<value_type, order>, order> square_table;
+
+            /// A table with a row of 16 entries per element
+            typedef table<table<value_type, 16>, order> simd_table;
+
+            /// A row of a square table
+            typedef table<value_type, order> square_row;
+
+            /// A row of a SIMD table
+            typedef table<value_type, 16> simd_row;
+
+            template<uint32_t... I>
+            static constexpr element_table make_log(index_sequence<I...>)
+            {
+                // The entry of zero is not used
+                return {{ (value_type)
+                    (I == 0 ? 0 : find_log<Field>(I, 0, 1))... }};
+            }
+
+            template<uint32_t... I>
+            static constexpr element_table make_antilog(index_sequence<I...>)
+            {
+                // The exponent max_value maps to 1 since 2^max_value = 1
+                return {{ (value_type) power<Field>(I)... }};
+            }
+
+            template<uint32_t... I>
+            static constexpr extended_table make_extended_antilog(
+                index_sequence<I...>)
+            {
+                // The entry I holds 2^(I - (order - 2)) and the exponent
+                // is reduced modulo max_value
+                return {{ (value_type)
+                    power<Field>((I + 1) % Field::max_value)... }};
+            }
+
+            /// The log table
+            static constexpr element_table log_table =
+                make_log(typename make_index_sequence<order>::type());
+
+            /// The antilog table
+            static constexpr element_table antilog_table =
+                make_antilog(typename make_index_sequence<order>::type());
+
+            /// @return The product of the two elements
+            static constexpr uint32_t multiply(uint32_t a, uint32_t b)
+            {
+                return (a == 0 || b == 0) ? 0 : antilog_table.m_values[
+                    (log_table.m_values[a] + log_table.m_values[b]) %
+                    Field::max_value];
+            }
+
+            /// @return The quotient of the two elements, division by zero
+            ///         gives zero
+            static constexpr uint32_t divide(uint32_t a, uint32_t b)
+            {
+                return (a == 0 || b == 0) ? 0 : antilog_table.m_values[
+                    (log_table.m_values[a] + Field::max_value -
+                     log_table.m_values[b]) % Field::max_value];
+            }
+
+            /// @return The product of the element with the high-half of a
+            ///         byte. For binary4 the high-half is an element
+            ///         itself, for binary8 it is part of an element.
+            static constexpr uint32_t multiply_high(uint32_t a, uint32_t b)
+            {
+                return Field::degree == 4 ?
+                    ((multiply(a, b) << 4) & 0xf0) : multiply(a, b << 4);
+            }
+
+            template<uint32_t... J>
+            static constexpr square_row multiplication_row(
+                uint32_t a, index_sequence<J...>)
+            {
+                return {{ (value_type) multiply(a, J)... }};
+            }
+
+            template<uint32_t... J>
+            static constexpr square_row division_row(
+                uint32_t a, index_sequence<J...>)
+            {
+                return {{ (value_type) divide(a, J)... }};
+            }
+
+            template<uint32_t... J>
+            static constexpr simd_row simd_row_one(
+                uint32_t a, index_sequence<J...>)
+            {
+                return {{ (value_type) multiply(a, J)... }};
+            }
+
+            template<uint32_t... J>
+            static constexpr simd_row simd_row_two(
+                uint32_t a, index_sequence<J...>)
+            {
+                return {{ (value_type) multiply_high(a, J)... }};
+            }
+
+            template<uint32_t... I>
+            static constexpr square_table make_multiplication(
+                index_sequence<I...>)
+            {
+                return {{ multiplication_row(I,
+                    typename make_index_sequence<order>::type())... }};
+            }
+
+            template<uint32_t... I>
+            static constexpr square_table make_division(index_sequence<I...>)
+            {
+                return {{ division_row(I,
+                    typename make_index_sequence<order>::type())... }};
+            }
+
+            template<uint32_t... I>
+            static constexpr simd_table make_simd_one(index_sequence<I...>)
+            {
+                return {{ simd_row_one(I,
+                    typename make_index_sequence<16>::type())... }};
+            }
+
+            template<uint32_t... I>
+            static constexpr simd_table make_simd_two(index_sequence<I...>)
+            {
+                return {{ simd_row_two(I,
+                    typename make_index_sequence<16>::type())... }};
+            }
+
+            /// The extended antilog table
+            static constexpr extended_table extended_antilog_table =
+                make_extended_antilog(
+                    typename make_index_sequence<(3 * order) - 5>::type());
+
+            /// The multiplication table
+            static constexpr square_table multiplication_table =
+                make_multiplication(
+                    typename make_index_sequence<order>::type());
+
+            /// The division table
+            static constexpr square_table division_table =
+                make_division(typename make_index_sequence<order>::type());
+
+            /// The low-half SIMD table
+            static constexpr simd_table simd_table_one =
+                make_simd_one(typename make_index_sequence<order>::type());
+
+            /// The high-half SIMD table
+            static constexpr simd_table simd_table_two =
+                make_simd_two(typename make_index_sequence<order>::type());
+        };
+
+        template<class Field>
+        constexpr typename generator<Field>::element_table
+            generator<Field>::log_table;
+
+        template<class Field>
+        constexpr typename generator<Field>::element_table
+            generator<Field>::antilog_table;
+
+        template<class Field>
+        constexpr typename generator<Field>::extended_table
+            generator<Field>::extended_antilog_table;
+
+        template<class Field>
+        constexpr typename generator<Field>::square_table
+            generator<Field>::multiplication_table;
+
+        template<class Field>
+        constexpr typename generator<Field>::square_table
+            generator<Field>::division_table;
+
+        template<class Field>
+        constexpr typename generator<Field>::simd_table
+            generator<Field>::simd_table_one;
+
+        template<class Field>
+        constexpr typename generator<Field>::simd_table
+            generator<Field>::simd_table_two;
+    }
+
+    template<class Field>
+    auto generated_field_tables<Field>::multiplication() -> const value_type*
+    {
+        return &generator<Field>::multiplication_table.m_values[0].m_values[0];
+    }
+
+    template<class Field>
+    auto generated_field_tables<Field>::division() -> const value_type*
+    {
+        return &generator<Field>::division_table.m_values[0].m_values[0];
+    }
+
+    template<class Field>
+    auto generated_field_tables<Field>::log() -> const value_type*
+    {
+        return &generator<Field>::log_table.m_values[0];
+    }
+
+    template<class Field>
+    auto generated_field_tables<Field>::antilog() -> const value_type*
+    {
+        return &generator<Field>::antilog_table.m_values[0];
+    }
+
+    template<class Field>
+    auto generated_field_tables<Field>::extended_antilog()
+        -> const value_type*
+    {
+        return &generator<Field>::extended_antilog_table.m_values[0];
+    }
+
+    template<class Field>
+    auto generated_field_tables<Field>::simd_table_one() -> const value_type*
+    {
+        return &generator<Field>::simd_table_one.m_values[0].m_values[0];
+    }
+
+    template<class Field>
+    auto generated_field_tables<Field>::simd_table_two() -> const value_type*
+    {
+        return &generator<Field>::simd_table_two.m_values[0].m_values[0];
+    }
+
+    template struct generated_field_tables<binary4>;
+    template struct generated_field_tables<binary8>;
+}
@@ -0,0 +1,85 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "binary4.hpp"
+#include "binary8.hpp"
+
+namespace fifi
+{
+    /// Look-up tables for a field which are generated at compile-time.
+    /// Fields without generated tables have available set to false, in
+    /// which case the table layers build their tables at run-time
+    /// @see shared_table()
+    ///
+    /// @tparam Field The field type
+    template<class Field>
+    struct field_tables
+    {
+        /// False since no tables are generated for the field
+        static const bool available = false;
+    };
+
+    /// The tables generated at compile-time. The tables are constant
+    /// initialized in field_tables.cpp and therefore placed in the
+    /// read-only data of the library, so creating a stack does not
+    /// build any tables and the pages are shared between processes.
+    /// The tables are only generated for the binary4 and binary8 fields.
+    ///
+    /// @tparam Field The field type
+    template<class Field>
+    struct generated_field_tables
+    {
+        /// True since the tables are generated for the field
+        static const bool available = true;
+
+        /// @copydoc layer::value_type
+        typedef typename Field::value_type value_type;
+
+        /// @return The order x order multiplication table, the product
+        ///         a * b is found at index (a << degree) + b
+        static const value_type* multiplication();
+
+        /// @return The order x order division table, the quotient a / b
+        ///         is found at index (a << degree) + b
+        static const value_type* division();
+
+        /// @return The log table with order entries, the entry for zero
+        ///         is not used
+        static const value_type* log();
+
+        /// @return The antilog table with order entries, the last entry
+        ///         maps the exponent max_value to 1
+        static const value_type* antilog();
+
+        /// @return The extended antilog table with (3 * order) - 5
+        ///         entries, the entry at index (order - 2) + e holds
+        ///         2^e for the exponents -(order - 2) <= e <= 2 * (order - 2)
+        static const value_type* extended_antilog();
+
+        /// @return The 16 byte aligned low-half tables used by the
+        ///         SIMD full table stacks, with 16 entries per element
+        static const value_type* simd_table_one();
+
+        /// @return The 16 byte aligned high-half tables used by the
+        ///         SIMD full table stacks, with 16 entries per element
+        static const value_type* simd_table_two();
+    };
+
+    /// The generated tables of the binary4 field. The SIMD tables hold
+    /// the products of an element with the 16 elements in the low-half
+    /// and the high-half of a byte respectively
+    template<>
+    struct field_tables<binary4> : public generated_field_tables<binary4>
+    { };
+
+    /// The generated tables of the binary8 field. The SIMD tables hold
+    /// the products of an element with the 16 values of the low-half and
+    /// the high-half of a byte respectively
+    template<>
+    struct field_tables<binary8> : public generated_field_tables<binary8>
+    { };
+}
@@ -12,6 +12,7 @@
 #include "binary4.hpp"
 #include "binary8.hpp"
 #include "binary16.hpp"
+#include "binary32.hpp"
 #include "prime2325.hpp"
 #include "is_valid_element.hpp"
 
@@ -313,6 +314,7 @@ namespace fifi
     {
         static_assert(std::is_same<Field, binary8>::value ||
                       std::is_same<Field, binary16>::value ||
+                      std::is_same<Field, binary32>::value ||
                       std::is_same<Field, prime2325>::value,
                       "The generic version is only supported by "
                       "field guaranteed to be packed");
@@ -8,10 +8,11 @@
 #include <cassert>
 #include <cstdint>
 #include <type_traits>
-#include <vector>
 
 #include "binary.hpp"
 #include "binary16.hpp"
+#include "binary32.hpp"
+#include "field_tables.hpp"
 #include "is_valid_element.hpp"
 #include "prime2325.hpp"
 
@@ -45,37 +46,30 @@ namespace fifi
             !std::is_same<binary16, field_type>::value,
             "This layer does not support the binary16 field");
 
+        // The same goes for binary32
+        static_assert(
+            !std::is_same<binary32, field_type>::value,
+            "This layer does not support the binary32 field");
+
         // Static check for the prime2325 field, the full lookup table
         // only works with binary extension fields
         static_assert(
             !std::is_same<prime2325, field_type>::value,
             "This layer does not support the 2^32 - 5 prime field");
 
+        // The tables are generated at compile-time for the fields
+        // supported by this layer
+        static_assert(field_tables<field_type>::available,
+            "The tables are not generated for this field");
+
     public:
 
         /// Constructor
         full_table_arithmetic()
-        {
-            m_multiplication_table.resize(
-                field_type::order * field_type::order, '\0');
-            m_division_table.resize(
-                field_type::order * field_type::order, '\0');
-
-            for (uint32_t i = 0; i < field_type::order; ++i)
-            {
-                int offset = i * field_type::order;
-
-                for (uint32_t j = 0; j < field_type::order; ++j)
-                {
-                    m_multiplication_table[offset + j] = Super::multiply(i,j);
-
-                    if (j == 0) // Cannot divide by zero
-                        continue;
-
-                    m_division_table[offset + j] = Super::divide(i,j);
-                }
-            }
-        }
+            : m_multiplication_table(
+                  field_tables<field_type>::multiplication()),
+              m_division_table(field_tables<field_type>::division())
+        { }
 
         /// @copydoc layer::multiply(value_type, value_type) const
         value_type multiply(value_type a, value_type b) const
@@ -123,10 +117,11 @@ namespace fifi
         }
 
     private:
-        /// The multiplication table.
-        std::vector<value_type> m_multiplication_table;
 
-        /// The division table
-        std::vector<value_type> m_division_table;
+        /// Pointer to the generated multiplication table
+        const value_type* m_multiplication_table;
+
+        /// Pointer to the generated division table
+        const value_type* m_division_table;
     };
 }
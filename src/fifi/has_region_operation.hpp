@@ -0,0 +1,63 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+
+#include "has_region_add.hpp"
+#include "has_region_subtract.hpp"
+#include "has_region_multiply.hpp"
+#include "has_region_divide.hpp"
+#include "has_region_multiply_constant.hpp"
+#include "has_region_multiply_add.hpp"
+#include "has_region_multiply_subtract.hpp"
+#include "has_region_linear_combination.hpp"
+#include "has_region_multiply_add_many.hpp"
+#include "region_thresholds.hpp"
+
+namespace fifi
+{
+    /// Run-time counterpart of the has_region_xxx type traits, which
+    /// detects whether T supports an operation given as a value.
+    ///
+    /// Example:
+    ///
+    /// if (has_region_operation<MyStack>(region_thresholds::region_add))
+    /// {
+    ///     // Do something here
+    /// }
+    ///
+    /// @param op The region operation
+    /// @return True if T has the member function of the operation
+    template<class T>
+    inline bool has_region_operation(region_thresholds::operation op)
+    {
+        switch (op)
+        {
+        case region_thresholds::region_add:
+            return has_region_add<T>::value;
+        case region_thresholds::region_subtract:
+            return has_region_subtract<T>::value;
+        case region_thresholds::region_multiply:
+            return has_region_multiply<T>::value;
+        case region_thresholds::region_divide:
+            return has_region_divide<T>::value;
+        case region_thresholds::region_multiply_constant:
+            return has_region_multiply_constant<T>::value;
+        case region_thresholds::region_multiply_add:
+            return has_region_multiply_add<T>::value;
+        case region_thresholds::region_multiply_subtract:
+            return has_region_multiply_subtract<T>::value;
+        case region_thresholds::region_linear_combination:
+            return has_region_linear_combination<T>::value;
+        case region_thresholds::region_multiply_add_many:
+            return has_region_multiply_add_many<T>::value;
+        default:
+            assert(0);
+            return false;
+        }
+    }
+}
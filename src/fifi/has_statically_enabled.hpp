@@ -0,0 +1,38 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+
+namespace fifi
+{
+    /// Type trait helper for compile time detection of whether a
+    /// dispatch stack defines the static constant statically_enabled,
+    /// i.e. whether it is known at compile-time if the stack is enabled.
+    ///
+    /// Example:
+    ///
+    /// if(has_statically_enabled<MyStack>::value)
+    /// {
+    ///     // Do something here
+    /// }
+    ///
+    template<typename T>
+    class has_statically_enabled
+    {
+        typedef uint8_t yes;
+        typedef uint32_t no;
+
+        template <typename U>
+        static yes check(decltype(&U::statically_enabled));
+
+        template <typename U> static no check(...);
+
+    public:
+
+        enum { value = (sizeof(check<T>(0)) == sizeof(yes)) };
+    };
+}
@@ -0,0 +1,324 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "fifi_utils.hpp"
+
+namespace fifi
+{
+    /// Incremental Gaussian elimination of a system of linear equations,
+    /// as found in the decoder of a linear network code. Coded rows, each
+    /// consisting of a coefficient vector and a symbol, are added one at
+    /// a time. Each row is reduced against the rows already stored which
+    /// keeps the stored rows in echelon form.
+    ///
+    /// The symbols are only updated once per added row: the pivots of
+    /// the stored rows are first applied to the coefficient vector, and
+    /// all the collected pivot rows are then applied to the symbol in a
+    /// single region_linear_combination() call. Back-substitution is
+    /// delayed until the system has full rank, where every symbol is
+    /// again computed with a single region_linear_combination() call.
+    ///
+    /// @tparam Stack The field stack providing the arithmetics
+    template<class Stack>
+    class incremental_elimination
+    {
+    public:
+
+        /// The field stack type
+        typedef Stack stack_type;
+
+        /// @copydoc layer::field_type
+        typedef typename Stack::field_type field_type;
+
+        /// @copydoc layer::value_type
+        typedef typename Stack::value_type value_type;
+
+    public:
+
+        /// Creates a new elimination with no rows
+        /// @param symbols The number of symbols i.e. the number of
+        ///        field elements in a coefficient vector
+        /// @param symbol_length The length of a symbol in value_type
+        ///        elements
+        incremental_elimination(uint32_t symbols, uint32_t symbol_length)
+            : m_symbols(symbols),
+              m_symbol_length(symbol_length),
+              m_coefficients_length(elements_to_length<field_type>(symbols)),
+              m_rank(0),
+              m_pivots(symbols, false),
+              m_coefficient_data(m_coefficients_length * (symbols + 1), 0),
+              m_symbol_data(symbol_length * (symbols + 1), 0),
+              m_symbol_rows(symbols + 1)
+        {
+            assert(m_symbols > 0);
+            assert(m_symbol_length > 0);
+
+            // The last row is used as scratch space
+            for (uint32_t i = 0; i <= m_symbols; ++i)
+            {
+                m_symbol_rows[i] = &m_symbol_data[i * m_symbol_length];
+            }
+
+            m_sources.reserve(m_symbols + 1);
+            m_constants.reserve(m_symbols + 1);
+        }
+
+        /// @return The number of symbols
+        uint32_t symbols() const
+        {
+            return m_symbols;
+        }
+
+        /// @return The length of a symbol in value_type elements
+        uint32_t symbol_length() const
+        {
+            return m_symbol_length;
+        }
+
+        /// @return The length of a coefficient vector in value_type
+        ///         elements
+        uint32_t coefficients_length() const
+        {
+            return m_coefficients_length;
+        }
+
+        /// @return The number of linearly independent rows added
+        uint32_t rank() const
+        {
+            return m_rank;
+        }
+
+        /// @return True if the system has full rank and all symbols have
+        ///         been decoded
+        bool is_complete() const
+        {
+            return m_rank == m_symbols;
+        }
+
+        /// @param index The index of a symbol
+        /// @return True if a stored row has its pivot at the index
+        bool is_pivot(uint32_t index) const
+        {
+            assert(index < m_symbols);
+            return m_pivots[index];
+        }
+
+        /// Adds a coded row to the system. The row is reduced against the
+        /// rows already stored and stored if it is linearly independent
+        /// of these. When the last independent row is added the stored
+        /// rows are back-substituted so that the decoded symbols are
+        /// available from symbol().
+        ///
+        /// @param coefficients The coefficient vector of the row with
+        ///        coefficients_length() value_type elements
+        /// @param symbol The symbol of the row with symbol_length()
+        ///        value_type elements
+        /// @return True if the row increased the rank, otherwise false
+        bool add_row(const value_type* coefficients, const value_type* symbol)
+        {
+            assert(coefficients != 0);
+            assert(symbol != 0);
+
+            if (is_complete())
+                return false;
+
+            // The scratch coefficient vector follows the stored ones
+            value_type* vector = coefficients_row(m_symbols);
+            std::copy_n(coefficients, m_coefficients_length, vector);
+
+            m_sources.clear();
+            m_constants.clear();
+
+            // Eliminate the pivots of the stored rows from the
+            // coefficient vector. The pivot rows and the coefficients
+            // used are collected so that they can be applied to the
+            // symbol in one pass.
+            uint32_t pivot = m_symbols;
+
+            for (uint32_t i = 0; i < m_symbols; ++i)
+            {
+                value_type coefficient = get_value<field_type>(vector, i);
+
+                if (coefficient == 0)
+                    continue;
+
+                if (!m_pivots[i])
+                {
+                    pivot = i;
+                    break;
+                }
+
+                // The stored row has a one at position i and zeros
+                // before it, so only positions after i are changed
+                m_stack.region_multiply_subtract(vector, coefficients_row(i),
+                    pack_constant<field_type>(coefficient),
+                    m_coefficients_length);
+
+                m_sources.push_back(m_symbol_rows[i]);
+                m_constants.push_back(m_stack.subtract(0, coefficient));
+            }
+
+            if (pivot == m_symbols)
+            {
+                // The row was linearly dependent of the stored rows
+                return false;
+            }
+
+            // Normalize the row so that it has a one at the pivot
+            value_type inverse =
+                m_stack.invert(get_value<field_type>(vector, pivot));
+
+            m_stack.region_multiply_constant(vector,
+                pack_constant<field_type>(inverse), m_coefficients_length);
+
+            std::copy_n(vector, m_coefficients_length,
+                        coefficients_row(pivot));
+
+            // The symbol of the stored row is
+            // inverse * (symbol - sum_j coefficient_j * pivot_row_j)
+            m_sources.insert(m_sources.begin(), symbol);
+            m_constants.insert(m_constants.begin(), 1);
+
+            for (auto& constant : m_constants)
+            {
+                constant = pack_constant<field_type>(
+                    m_stack.multiply(inverse, constant));
+            }
+
+            m_stack.region_linear_combination(m_symbol_rows[pivot],
+                m_sources.data(), m_constants.data(),
+                (uint32_t) m_sources.size(), m_symbol_length);
+
+            m_pivots[pivot] = true;
+            ++m_rank;
+
+            if (is_complete())
+            {
+                back_substitute();
+            }
+
+            return true;
+        }
+
+        /// @param index The index of the symbol
+        /// @return The decoded symbol, only available when the system has
+        ///         full rank
+        const value_type* symbol(uint32_t index) const
+        {
+            assert(is_complete());
+            assert(index < m_symbols);
+            return m_symbol_rows[index];
+        }
+
+    private:
+
+        /// @param index The index of a stored row or m_symbols for the
+        ///        scratch row
+        /// @return The coefficient vector of the row
+        value_type* coefficients_row(uint32_t index)
+        {
+            assert(index <= m_symbols);
+            return &m_coefficient_data[index * m_coefficients_length];
+        }
+
+        /// Eliminates the coefficients above the diagonal of the stored
+        /// rows. The rows are processed from the last to the first, so
+        /// all rows after the current one are already decoded and the
+        /// current row is computed with a single linear combination.
+        void back_substitute()
+        {
+            assert(is_complete());
+
+            value_type* scratch = m_symbol_rows[m_symbols];
+
+            for (uint32_t i = m_symbols; i-- > 0;)
+            {
+                const value_type* vector = coefficients_row(i);
+
+                m_sources.clear();
+                m_constants.clear();
+
+                m_sources.push_back(m_symbol_rows[i]);
+                m_constants.push_back(pack_constant<field_type>(1));
+
+                for (uint32_t j = i + 1; j < m_symbols; ++j)
+                {
+                    value_type coefficient = get_value<field_type>(vector, j);
+
+                    if (coefficient == 0)
+                        continue;
+
+                    m_sources.push_back(m_symbol_rows[j]);
+                    m_constants.push_back(pack_constant<field_type>(
+                        m_stack.subtract(0, coefficient)));
+                }
+
+                if (m_sources.size() == 1)
+                    continue;
+
+                // The decoded symbol is written to the scratch row which
+                // then takes the place of the row
+                m_stack.region_linear_combination(scratch,
+                    m_sources.data(), m_constants.data(),
+                    (uint32_t) m_sources.size(), m_symbol_length);
+
+                std::swap(m_symbol_rows[i], scratch);
+            }
+
+            m_symbol_rows[m_symbols] = scratch;
+
+            // The coefficient matrix is now the identity matrix
+            std::fill(m_coefficient_data.begin(), m_coefficient_data.end(), 0);
+
+            for (uint32_t i = 0; i < m_symbols; ++i)
+            {
+                set_value<field_type>(coefficients_row(i), i, 1);
+            }
+        }
+
+    private:
+
+        /// The field stack
+        Stack m_stack;
+
+        /// The number of symbols
+        uint32_t m_symbols;
+
+        /// The length of a symbol in value_type elements
+        uint32_t m_symbol_length;
+
+        /// The length of a coefficient vector in value_type elements
+        uint32_t m_coefficients_length;
+
+        /// The number of stored rows
+        uint32_t m_rank;
+
+        /// Tracks which pivots have a stored row
+        std::vector<bool> m_pivots;
+
+        /// The coefficient vectors of the stored rows and the scratch row
+        std::vector<value_type> m_coefficient_data;
+
+        /// The symbols of the stored rows and the scratch row
+        std::vector<value_type> m_symbol_data;
+
+        /// The symbol rows indexed by their pivot, the last row is the
+        /// scratch row
+        std::vector<value_type*> m_symbol_rows;
+
+        /// The sources of the current linear combination
+        std::vector<const value_type*> m_sources;
+
+        /// The constants of the current linear combination
+        std::vector<value_type> m_constants;
+    };
+}
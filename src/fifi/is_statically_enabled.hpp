@@ -0,0 +1,34 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <type_traits>
+
+#include "has_statically_enabled.hpp"
+
+namespace fifi
+{
+    /// Type trait helper which is true if a dispatch stack is known to
+    /// be enabled at compile-time. Stacks which do not define the
+    /// static constant statically_enabled are never statically enabled.
+    ///
+    /// Example:
+    ///
+    /// if(is_statically_enabled<MyStack>::value)
+    /// {
+    ///     // Do something here
+    /// }
+    ///
+    template<class T, bool = has_statically_enabled<T>::value>
+    struct is_statically_enabled :
+        public std::integral_constant<bool, T::statically_enabled>
+    { };
+
+    /// Specialization for stacks without the statically_enabled constant
+    template<class T>
+    struct is_statically_enabled<T, false> : public std::false_type
+    { };
+}
@@ -6,11 +6,15 @@
 #pragma once
 
 #include <cassert>
+#include <type_traits>
 #include <vector>
 
 #include "is_valid_element.hpp"
 #include "binary.hpp"
+#include "binary32.hpp"
+#include "field_tables.hpp"
 #include "prime2325.hpp"
+#include "shared_table.hpp"
 #include "sum_modulo.hpp"
 
 namespace fifi
@@ -38,33 +42,59 @@ namespace fifi
         static_assert(!std::is_same<binary, field_type>::value,
             "This layer does not support the binary field");
 
+        /// Check for binary32 field, the tables would not fit in memory
+        static_assert(!std::is_same<binary32, field_type>::value,
+            "This layer does not support the binary32 field");
+
     public:
 
-        /// Constructor
-        log_table_arithmetic()
+        /// The log and antilog tables for fields without generated
+        /// tables @see field_tables. The tables are built once and
+        /// shared by all instances @see shared_table()
+        struct tables
         {
-            m_log.resize(Field::order, '\0');
-            m_antilog.resize(Field::order, '\0');
+            /// Builds the tables using the arithmetics of Super
+            tables()
+            {
+                Super field;
 
-            // initial value corresponds x^0
-            value_type power = 1;
+                m_log.resize(Field::order, '\0');
+                m_antilog.resize(Field::order, '\0');
 
-            for (order_type i = 0; i < Field::order - 1; ++i)
-            {
-                m_log[power] = i;
-                m_antilog[i] = power;
+                // initial value corresponds x^0
+                value_type power = 1;
+
+                for (order_type i = 0; i < Field::order - 1; ++i)
+                {
+                    m_log[power] = i;
+                    m_antilog[i] = power;
 
-                // The decimal value 2 corresponds to the
-                // polynomial element 'x'
-                power = Super::multiply(2U, power);
+                    // The decimal value 2 corresponds to the
+                    // polynomial element 'x'
+                    power = field.multiply(2U, power);
+                }
+
+                // This handles the special case where the sum of two
+                // exponents hit the maximum value and should be reduced
+                // to zero. Instead of doing this we map this entry to
+                // the same entry as if the sum had been zero.
+                m_antilog[Field::max_value] = 1;
             }
 
-            // This handles the special case where the sum of two
-            // exponents hit the maximum value and should be reduced
-            // to zero. Instead of doing this we map this entry to
-            // the same entry as if the sum had been zero.
-            m_antilog[Field::max_value] = 1;
+            /// The Log table
+            std::vector<value_type> m_log;
+
+            /// The AntiLog table
+            std::vector<value_type> m_antilog;
+        };
 
+    public:
+
+        /// Constructor
+        log_table_arithmetic()
+        {
+            initialize_tables(std::integral_constant<bool,
+                field_tables<field_type>::available>());
         }
 
         /// @copydoc layer::multiply(value_type, value_type) const
@@ -136,10 +166,28 @@ namespace fifi
 
     private:
 
-        /// The Log table
-        std::vector<value_type> m_log;
+        /// Uses the tables generated at compile-time
+        void initialize_tables(std::true_type)
+        {
+            m_log = field_tables<field_type>::log();
+            m_antilog = field_tables<field_type>::antilog();
+        }
+
+        /// Uses the tables built at run-time
+        void initialize_tables(std::false_type)
+        {
+            const tables& shared = shared_table<tables>();
+
+            m_log = &shared.m_log[0];
+            m_antilog = &shared.m_antilog[0];
+        }
+
+    private:
+
+        /// Pointer to the shared Log table
+        const value_type* m_log;
 
-        /// The AntiLog table
-        std::vector<value_type> m_antilog;
+        /// Pointer to the shared AntiLog table
+        const value_type* m_antilog;
     };
 }
@@ -0,0 +1,114 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+#include "fifi_utils.hpp"
+
+namespace fifi
+{
+    /// The size in bytes of the column tiles used by matrix_multiply().
+    /// A tile of a row of C is updated once for every row of B, so it
+    /// is chosen to stay in the L1 cache.
+    const uint32_t matrix_multiply_tile_size = 4096;
+
+    /// The number of rows of B in the tiles used by matrix_multiply().
+    /// A tile of B is used once for every row of C, so it is chosen to
+    /// stay in the L2 cache i.e. 32 rows of 4096 bytes.
+    const uint32_t matrix_multiply_tile_rows = 32;
+
+    /// Computes the matrix product C = A * B using the region arithmetics
+    /// of a field stack. Systematic encoding of a batch of symbols is an
+    /// example of this product where A holds the coding coefficients and
+    /// B the symbols.
+    ///
+    /// The product is computed in tiles so that a tile of B is reused
+    /// from the cache for all rows of C, and a tile of a row of C is
+    /// reused from the cache for all rows of the tile of B. Inside a
+    /// tile the rows of B are multiplied and added to the rows of C with
+    /// region_multiply_add(). Zero coefficients are skipped.
+    ///
+    /// All matrices are stored row by row without padding between the
+    /// rows, the rows of A contain packed field elements as used by
+    /// get_value().
+    ///
+    /// @param stack The field stack used for the region arithmetics
+    /// @param c The rows x length matrix C, its content is overwritten
+    /// @param a The rows x inner matrix A of field elements, each row is
+    ///        elements_to_length(inner) value_type elements long
+    /// @param b The inner x length matrix B
+    /// @param rows The number of rows in A and C
+    /// @param inner The number of columns in A and rows in B
+    /// @param length The length of the rows of B and C in value_type
+    ///        elements
+    template<class Stack>
+    inline void matrix_multiply(const Stack& stack,
+                                typename Stack::value_type* c,
+                                const typename Stack::value_type* a,
+                                const typename Stack::value_type* b,
+                                uint32_t rows,
+                                uint32_t inner,
+                                uint32_t length)
+    {
+        typedef typename Stack::field_type field_type;
+        typedef typename Stack::value_type value_type;
+
+        assert(c != 0);
+        assert(a != 0);
+        assert(b != 0);
+        assert(rows > 0);
+        assert(inner > 0);
+        assert(length > 0);
+
+        std::fill_n(c, rows * length, 0);
+
+        // The column tiles are a multiple of the granularity so only the
+        // last tile of a row may need the unoptimized tail arithmetics
+        uint32_t granularity = stack.max_granularity();
+        assert(granularity > 0);
+
+        uint32_t tile_length =
+            size_to_length<field_type>(matrix_multiply_tile_size);
+        tile_length = std::max(tile_length - (tile_length % granularity),
+                               granularity);
+
+        uint32_t a_length = elements_to_length<field_type>(inner);
+
+        for (uint32_t column = 0; column < length; column += tile_length)
+        {
+            uint32_t columns = std::min(tile_length, length - column);
+
+            for (uint32_t first = 0; first < inner;
+                 first += matrix_multiply_tile_rows)
+            {
+                uint32_t last =
+                    std::min(first + matrix_multiply_tile_rows, inner);
+
+                for (uint32_t i = 0; i < rows; ++i)
+                {
+                    const value_type* a_row = a + i * a_length;
+                    value_type* c_tile = c + i * length + column;
+
+                    for (uint32_t k = first; k < last; ++k)
+                    {
+                        value_type coefficient =
+                            get_value<field_type>(a_row, k);
+
+                        if (coefficient == 0)
+                            continue;
+
+                        stack.region_multiply_add(c_tile,
+                            b + k * length + column,
+                            pack_constant<field_type>(coefficient), columns);
+                    }
+                }
+            }
+        }
+    }
+}
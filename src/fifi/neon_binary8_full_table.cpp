@@ -3,7 +3,9 @@
 // See accompanying file LICENSE.rst or
 // http://www.steinwurf.com/licensing
 
+#include <algorithm>
 #include <cstdio>
+
 #include <platform/config.hpp>
 #include <cpuid/cpuinfo.hpp>
 
@@ -12,8 +14,7 @@
 #include <arm_neon.h>
 #endif
 
-#include "simple_online_arithmetic.hpp"
-#include "final.hpp"
+#include "field_tables.hpp"
 
 #include "neon_binary8_full_table.hpp"
 
@@ -22,32 +23,148 @@ namespace fifi
 
 #ifdef PLATFORM_NEON
 
-    neon_binary8_full_table::neon_binary8_full_table()
+    namespace
     {
-        simple_online_arithmetic<final<binary8>> field;
+        /// The number of sources processed in a single pass over the
+        /// destination. The two look-up tables of each source are kept
+        /// in registers during the pass.
+        const uint32_t sources_per_pass = 4;
+
+        /// Makes a single pass over the destination adding the products
+        /// of the sources and their constants. If overwrite is true the
+        /// destination is not read but set to the sum of the products.
+        ///
+        /// @param dest The destination buffer
+        /// @param srcs Array with Sources pointers to the source buffers
+        /// @param rows_one The table_one rows of the Sources constants
+        /// @param rows_two The table_two rows of the Sources constants
+        /// @param simd_size The number of 16 byte blocks to process
+        /// @param overwrite Whether the destination should be overwritten
+        template<uint32_t Sources>
+        inline void linear_combination_pass(uint8_t* dest,
+            const uint8_t* const* srcs, const uint8_t* const* rows_one,
+            const uint8_t* const* rows_two, uint32_t simd_size,
+            bool overwrite)
+        {
+            // Convert to uint8x8x2_t as vtbl2_u8 expects two 8-byte arrays
+            uint8x8x2_t table1[Sources];
+            uint8x8x2_t table2[Sources];
 
-        m_table_one.resize(256 * 16);
-        m_table_two.resize(256 * 16);
+            for (uint32_t k = 0; k < Sources; ++k)
+            {
+                uint8x16_t t1 = vld1q_u8(rows_one[k]);
+                table1[k].val[0] = vget_low_u8(t1);
+                table1[k].val[1] = vget_high_u8(t1);
 
-        assert(((uintptr_t) &m_table_one[0] % 16) == 0);
-        assert(((uintptr_t) &m_table_two[0] % 16) == 0);
+                uint8x16_t t2 = vld1q_u8(rows_two[k]);
+                table2[k].val[0] = vget_low_u8(t2);
+                table2[k].val[1] = vget_high_u8(t2);
+            }
+
+            // Create low and high bitmasks by replicating the mask values
+            // 16 times
+            uint8x16_t mask1 = vdupq_n_u8((uint8_t)0x0f);
+            uint8x16_t mask2 = vdupq_n_u8((uint8_t)0xf0);
+
+            for (uint32_t i = 0; i < simd_size; i++, dest+=16)
+            {
+                // Start from zero or from the sum of the previous passes
+                uint8x16_t result = overwrite ?
+                    vdupq_n_u8((uint8_t)0) : vld1q_u8(dest);
+
+                for (uint32_t k = 0; k < Sources; ++k)
+                {
+                    // Load the next 16-bytes of the k'th source buffer
+                    uint8x16_t q0 = vld1q_u8(srcs[k] + i * 16);
+                    // Multiply the low-half and the high-half of the data
+                    // The lookups are performed twice due to NEON
+                    // restrictions
+                    uint8x16_t l = vandq_u8(q0, mask1);
+                    l = vcombine_u8(vtbl2_u8(table1[k], vget_low_u8(l)),
+                        vtbl2_u8(table1[k], vget_high_u8(l)));
+                    uint8x16_t h = vshrq_n_u8(vandq_u8(q0, mask2), 4);
+                    h = vcombine_u8(vtbl2_u8(table2[k], vget_low_u8(h)),
+                        vtbl2_u8(table2[k], vget_high_u8(h)));
+                    // Add the product to the sum kept in the register
+                    result = veorq_u8(result, veorq_u8(h, l));
+                }
+
+                // Store the sum in the destination buffer
+                vst1q_u8(dest, result);
+            }
+        }
 
-        // Iterate over all elements in the field
-        for (uint32_t i = 0; i < 256; ++i)
+        /// The number of destinations updated in a single pass over the
+        /// source. The two look-up tables of each destination are kept
+        /// in registers during the pass.
+        const uint32_t dests_per_pass = 4;
+
+        /// Makes a single pass over the source adding its products with
+        /// the constants of the Dests destinations to these.
+        ///
+        /// @param dests Array with Dests pointers to the destination buffers
+        /// @param src The source buffer
+        /// @param rows_one The table_one rows of the Dests constants
+        /// @param rows_two The table_two rows of the Dests constants
+        /// @param simd_size The number of 16 byte blocks to process
+        template<uint32_t Dests>
+        inline void multiply_add_many_pass(uint8_t* const* dests,
+            const uint8_t* src, const uint8_t* const* rows_one,
+            const uint8_t* const* rows_two, uint32_t simd_size)
         {
-            // Only take the constants whose first 4 bits are zero
-            for (uint32_t j = 0; j < 16; ++j)
+            // Convert to uint8x8x2_t as vtbl2_u8 expects two 8-byte arrays
+            uint8x8x2_t table1[Dests];
+            uint8x8x2_t table2[Dests];
+
+            for (uint32_t k = 0; k < Dests; ++k)
             {
-                // Calculate 8-bit product with the low-half
-                auto v1 = field.multiply(i, j);
-                m_table_one[i * 16 + j] = v1;
-                // Calculate 8-bit product with the high-half
-                auto v2 = field.multiply(i, j << 4);
-                m_table_two[i * 16 + j] = v2;
+                uint8x16_t t1 = vld1q_u8(rows_one[k]);
+                table1[k].val[0] = vget_low_u8(t1);
+                table1[k].val[1] = vget_high_u8(t1);
+
+                uint8x16_t t2 = vld1q_u8(rows_two[k]);
+                table2[k].val[0] = vget_low_u8(t2);
+                table2[k].val[1] = vget_high_u8(t2);
+            }
+
+            // Create low and high bitmasks by replicating the mask values
+            // 16 times
+            uint8x16_t mask1 = vdupq_n_u8((uint8_t)0x0f);
+            uint8x16_t mask2 = vdupq_n_u8((uint8_t)0xf0);
+
+            for (uint32_t i = 0; i < simd_size; i++, src+=16)
+            {
+                // Load the next 16-bytes of the source buffer and split
+                // it in the low-half and the high-half only once
+                uint8x16_t q0 = vld1q_u8(src);
+                uint8x16_t l = vandq_u8(q0, mask1);
+                uint8x16_t h = vshrq_n_u8(vandq_u8(q0, mask2), 4);
+
+                for (uint32_t k = 0; k < Dests; ++k)
+                {
+                    // Multiply the source with the k'th constant
+                    // The lookups are performed twice due to NEON
+                    // restrictions
+                    uint8x16_t pl = vcombine_u8(
+                        vtbl2_u8(table1[k], vget_low_u8(l)),
+                        vtbl2_u8(table1[k], vget_high_u8(l)));
+                    uint8x16_t ph = vcombine_u8(
+                        vtbl2_u8(table2[k], vget_low_u8(h)),
+                        vtbl2_u8(table2[k], vget_high_u8(h)));
+                    // Add the product to the k'th destination buffer
+                    uint8_t* dest = dests[k] + i * 16;
+                    uint8x16_t q1 = vld1q_u8(dest);
+                    vst1q_u8(dest, veorq_u8(q1, veorq_u8(ph, pl)));
+                }
             }
         }
     }
 
+    neon_binary8_full_table::neon_binary8_full_table()
+        : m_table_one(field_tables<binary8>::simd_table_one()),
+          m_table_two(field_tables<binary8>::simd_table_two())
+    { }
+
     void neon_binary8_full_table::region_add(
         value_type* dest, const value_type* src, uint32_t length) const
     {
@@ -196,6 +313,120 @@ namespace fifi
         region_multiply_add(dest, src, constant, length);
     }
 
+    void neon_binary8_full_table::region_linear_combination(value_type* dest,
+        const value_type* const* srcs, const value_type* constants,
+        uint32_t count, uint32_t length) const
+    {
+        assert(dest != 0);
+        assert(srcs != 0);
+        assert(constants != 0);
+        assert(count > 0);
+        assert(length > 0);
+        assert((length % granularity()) == 0);
+
+        // We loop 16 bytes at-a-time so we calculate how many loops we need
+        uint32_t simd_size = length / granularity();
+        assert(simd_size > 0);
+
+        // The sources are processed in blocks, so the destination is
+        // only loaded and stored once per block instead of once per
+        // source
+        for (uint32_t j = 0; j < count; j += sources_per_pass)
+        {
+            uint32_t sources = std::min(count - j, sources_per_pass);
+
+            const uint8_t* rows_one[sources_per_pass];
+            const uint8_t* rows_two[sources_per_pass];
+
+            for (uint32_t k = 0; k < sources; ++k)
+            {
+                value_type constant = constants[j + k];
+                rows_one[k] = &m_table_one[0] + (constant * 16);
+                rows_two[k] = &m_table_two[0] + (constant * 16);
+            }
+
+            bool overwrite = (j == 0);
+
+            switch (sources)
+            {
+            case 4:
+                linear_combination_pass<4>(dest, srcs + j, rows_one,
+                    rows_two, simd_size, overwrite);
+                break;
+            case 3:
+                linear_combination_pass<3>(dest, srcs + j, rows_one,
+                    rows_two, simd_size, overwrite);
+                break;
+            case 2:
+                linear_combination_pass<2>(dest, srcs + j, rows_one,
+                    rows_two, simd_size, overwrite);
+                break;
+            case 1:
+                linear_combination_pass<1>(dest, srcs + j, rows_one,
+                    rows_two, simd_size, overwrite);
+                break;
+            default:
+                assert(0);
+            }
+        }
+    }
+
+    void neon_binary8_full_table::region_multiply_add_many(
+        value_type* const* dests, const value_type* src,
+        const value_type* constants, uint32_t count, uint32_t length) const
+    {
+        assert(dests != 0);
+        assert(src != 0);
+        assert(constants != 0);
+        assert(count > 0);
+        assert(length > 0);
+        assert((length % granularity()) == 0);
+
+        // We loop 16 bytes at-a-time so we calculate how many loops we need
+        uint32_t simd_size = length / granularity();
+        assert(simd_size > 0);
+
+        // The destinations are processed in blocks, so the source is
+        // only loaded and split once per block instead of once per
+        // destination
+        for (uint32_t j = 0; j < count; j += dests_per_pass)
+        {
+            uint32_t destinations = std::min(count - j, dests_per_pass);
+
+            const uint8_t* rows_one[dests_per_pass];
+            const uint8_t* rows_two[dests_per_pass];
+
+            for (uint32_t k = 0; k < destinations; ++k)
+            {
+                value_type constant = constants[j + k];
+                rows_one[k] = &m_table_one[0] + (constant * 16);
+                rows_two[k] = &m_table_two[0] + (constant * 16);
+            }
+
+            switch (destinations)
+            {
+            case 4:
+                multiply_add_many_pass<4>(dests + j, src, rows_one,
+                    rows_two, simd_size);
+                break;
+            case 3:
+                multiply_add_many_pass<3>(dests + j, src, rows_one,
+                    rows_two, simd_size);
+                break;
+            case 2:
+                multiply_add_many_pass<2>(dests + j, src, rows_one,
+                    rows_two, simd_size);
+                break;
+            case 1:
+                multiply_add_many_pass<1>(dests + j, src, rows_one,
+                    rows_two, simd_size);
+                break;
+            default:
+                assert(0);
+            }
+        }
+    }
+
     uint32_t neon_binary8_full_table::alignment() const
     {
         return 1U;
@@ -230,6 +461,8 @@ namespace fifi
 #else
 
     neon_binary8_full_table::neon_binary8_full_table()
+        : m_table_one(0),
+          m_table_two(0)
     { }
 
     void neon_binary8_full_table::region_add(
@@ -267,6 +500,20 @@ namespace fifi
         assert(0);
     }
 
+    void neon_binary8_full_table::region_linear_combination(value_type*,
+        const value_type* const*, const value_type*, uint32_t, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
+    void neon_binary8_full_table::region_multiply_add_many(value_type* const*,
+        const value_type*, const value_type*, uint32_t, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
     uint32_t neon_binary8_full_table::alignment() const
     {
         // Not implemented
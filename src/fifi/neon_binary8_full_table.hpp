@@ -7,11 +7,10 @@
 
 #include <cassert>
 #include <cstdint>
-#include <vector>
-
-#include <sak/aligned_allocator.hpp>
 
 #include "binary8.hpp"
+#include "region_backend.hpp"
+#include "target_instruction_set.hpp"
 
 namespace fifi
 {
@@ -29,6 +28,14 @@ namespace fifi
         /// @copydoc layer::value_type
         typedef binary8::value_type value_type;
 
+        /// True if the build targets NEON, in which case the stack is
+        /// known to be enabled @see target_instruction_set
+        static const bool statically_enabled =
+            target_instruction_set::neon;
+
+        /// The backend of the stack @see region_backend
+        static const region_backend backend = region_backend::neon;
+
     public:
 
         /// Constructor for the stack
@@ -59,6 +66,20 @@ namespace fifi
         void region_multiply_subtract(value_type* dest, const value_type* src,
             value_type constant, uint32_t length) const;
 
+        /// @copydoc layer::region_linear_combination(value_type*,
+        ///     const value_type* const*, const value_type*, uint32_t,
+        ///     uint32_t) const
+        void region_linear_combination(value_type* dest,
+            const value_type* const* srcs, const value_type* constants,
+            uint32_t count, uint32_t length) const;
+
+        /// @copydoc layer::region_multiply_add_many(value_type* const*,
+        ///     const value_type*, const value_type*, uint32_t,
+        ///     uint32_t) const
+        void region_multiply_add_many(value_type* const* dests,
+            const value_type* src, const value_type* constants,
+            uint32_t count, uint32_t length) const;
+
         /// @copydoc layer::alignment() const
         uint32_t alignment() const;
 
@@ -77,14 +98,10 @@ namespace fifi
 
     private:
 
-        /// The storage type
-        typedef std::vector<uint8_t, sak::aligned_allocator<uint8_t>>
-            aligned_vector;
-
-        /// Storage for the high 4 bit multiplication table
-        aligned_vector m_table_one;
+        /// Pointer to the generated low 4 bit multiplication table
+        const uint8_t* m_table_one;
 
-        /// Storage for the low 4 bit multiplication table
-        aligned_vector m_table_two;
+        /// Pointer to the generated high 4 bit multiplication table
+        const uint8_t* m_table_two;
     };
 }
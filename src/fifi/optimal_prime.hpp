@@ -5,23 +5,32 @@
 
 #pragma once
 
+#include "avx2_prime2325.hpp"
 #include "final.hpp"
 #include "optimal_prime_arithmetic.hpp"
 #include "packed_arithmetic.hpp"
 #include "region_arithmetic.hpp"
+#include "region_dispatcher.hpp"
+#include "region_divide_granularity.hpp"
 #include "region_info.hpp"
+#include "sse41_prime2325.hpp"
 
 namespace fifi
 {
     /// This implementation allows finite field arithmetics in the
     /// prime fields in this case where the characteristic of the
-    /// field is different than two.
+    /// field is different than two. The region operations are
+    /// dispatched to SIMD stacks vectorizing the 2^32 - 5 arithmetic
+    /// when supported by the CPU.
     template<class Field>
-    class optimal_prime :
-        public region_arithmetic<
-               region_info<
-               packed_arithmetic<
-               optimal_prime_arithmetic<
-               final<Field> > > > >
+    class optimal_prime : public
+        region_divide_granularity<
+        region_dispatcher<avx2_prime2325,
+        region_dispatcher<sse41_prime2325,
+        region_arithmetic<
+        region_info<
+        packed_arithmetic<
+        optimal_prime_arithmetic<
+        final<Field> > > > > > > >
     { };
 }
@@ -0,0 +1,304 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <platform/config.hpp>
+#include <cpuid/cpuinfo.hpp>
+
+// Include x86 intrinsics for GCC-compatible compilers on x86/x86_64
+#if defined(PLATFORM_GCC_COMPATIBLE_X86)
+    #include <x86intrin.h>
+#endif
+
+#include "pclmul_binary16_online.hpp"
+
+namespace fifi
+{
+
+#if defined(PLATFORM_GCC_COMPATIBLE_X86) && defined(__PCLMUL__)
+
+    namespace
+    {
+        /// Carry-less multiplies the two 64-bit halves of a with the
+        /// low 64 bits of b and keeps the low 64 bits of each product
+        inline __m128i clmul_halves(__m128i a, __m128i b)
+        {
+            return _mm_unpacklo_epi64(
+                _mm_clmulepi64_si128(a, b, 0x00),
+                _mm_clmulepi64_si128(a, b, 0x01));
+        }
+
+        /// Multiplies four elements stored in the low 16 bits of each
+        /// 32-bit slot with the constant and reduces the products
+        inline __m128i multiply_slots(__m128i a, __m128i constant,
+            __m128i barrett, __m128i polynomial)
+        {
+            // The products have degree at most 30 so the product of
+            // one slot never spills into the next one
+            __m128i product = clmul_halves(a, constant);
+
+            // Barrett reduction: the quotient is estimated from the
+            // high half of the product and the Barrett constant
+            __m128i quotient = _mm_srli_epi32(product, 16);
+            quotient = clmul_halves(quotient, barrett);
+            quotient = _mm_srli_epi32(quotient, 16);
+
+            // Subtract quotient times the field polynomial, this clears
+            // the high half of each slot leaving the remainder
+            return _mm_xor_si128(product, clmul_halves(quotient, polynomial));
+        }
+
+        /// Multiplies eight elements with the constant
+        inline __m128i multiply(__m128i xmm0, __m128i constant,
+            __m128i barrett, __m128i polynomial)
+        {
+            __m128i zero = _mm_setzero_si128();
+
+            // Spread the elements into 32-bit slots
+            __m128i l = _mm_unpacklo_epi16(xmm0, zero);
+            __m128i h = _mm_unpackhi_epi16(xmm0, zero);
+
+            l = multiply_slots(l, constant, barrett, polynomial);
+            h = multiply_slots(h, constant, barrett, polynomial);
+
+            // Pack the 32-bit slots back into 16-bit elements. SSE2 only
+            // provides a signed saturating pack, so the values are
+            // biased into the signed range and restored afterwards
+            __m128i bias = _mm_set1_epi32(0x8000);
+            l = _mm_sub_epi32(l, bias);
+            h = _mm_sub_epi32(h, bias);
+
+            return _mm_xor_si128(_mm_packs_epi32(l, h),
+                                 _mm_set1_epi16((short)0x8000));
+        }
+    }
+
+    pclmul_binary16_online::pclmul_binary16_online()
+    {
+        m_polynomial = (1U << 16) | binary16::prime;
+
+        // Find the Barrett constant by long division of x^32 with the
+        // field polynomial
+        uint64_t remainder = 1ULL << 32;
+        m_barrett = 0;
+
+        for (int32_t i = 16; i >= 0; --i)
+        {
+            if (remainder & (1ULL << (i + 16)))
+            {
+                m_barrett |= 1U << i;
+                remainder ^= ((uint64_t) m_polynomial) << i;
+            }
+        }
+    }
+
+    void pclmul_binary16_online::region_add(
+        value_type* dest, const value_type* src, uint32_t length) const
+    {
+        assert(dest != 0);
+        assert(src != 0);
+        assert(length > 0);
+        assert((length % granularity()) == 0);
+
+        // We loop 8 elements at-a-time so we calculate how many loops we need
+        uint32_t sse_size = length / granularity();
+        assert(sse_size > 0);
+
+        __m128i* src_ptr = (__m128i*)src;
+        __m128i* dest_ptr = (__m128i*)dest;
+        for (uint32_t i = 0; i < sse_size; i++, src_ptr++, dest_ptr++)
+        {
+            // Load the next 16-bytes of the destination and source buffers
+            __m128i xmm0 = _mm_loadu_si128(dest_ptr);
+            __m128i xmm1 = _mm_loadu_si128(src_ptr);
+            // Xor these values together
+            xmm0 = _mm_xor_si128(xmm0, xmm1);
+            // Store the result in the destination buffer
+            _mm_storeu_si128(dest_ptr, xmm0);
+        }
+    }
+
+    void pclmul_binary16_online::region_subtract(
+        value_type* dest, const value_type* src, uint32_t length) const
+    {
+        // In a binary extension field addition is the same as subtraction
+        region_add(dest, src, length);
+    }
+
+    void pclmul_binary16_online::region_multiply_constant(
+        value_type* dest, value_type constant, uint32_t length) const
+    {
+        assert(dest != 0);
+        assert(length > 0);
+        assert((length % granularity()) == 0);
+
+        // We loop 8 elements at-a-time so we calculate how many loops we need
+        uint32_t sse_size = length / granularity();
+        assert(sse_size > 0);
+
+        // The operands of the carry-less multiplications
+        __m128i c = _mm_cvtsi32_si128(constant);
+        __m128i barrett = _mm_cvtsi32_si128(m_barrett);
+        __m128i polynomial = _mm_cvtsi32_si128(m_polynomial);
+
+        __m128i* dest_ptr = (__m128i*)dest;
+        for (uint32_t i = 0; i < sse_size; i++, dest_ptr++)
+        {
+            // Load the next 16-bytes of the destination buffer
+            __m128i xmm0 = _mm_loadu_si128(dest_ptr);
+            // Multiply the elements with the constant
+            xmm0 = multiply(xmm0, c, barrett, polynomial);
+            // Store the result in the destination buffer
+            _mm_storeu_si128(dest_ptr, xmm0);
+        }
+    }
+
+    void pclmul_binary16_online::region_multiply_add(value_type* dest,
+        const value_type* src, value_type constant, uint32_t length) const
+    {
+        assert(dest != 0);
+        assert(src != 0);
+        assert(length > 0);
+        assert((length % granularity()) == 0);
+
+        // We loop 8 elements at-a-time so we calculate how many loops we need
+        uint32_t sse_size = length / granularity();
+        assert(sse_size > 0);
+
+        // The operands of the carry-less multiplications
+        __m128i c = _mm_cvtsi32_si128(constant);
+        __m128i barrett = _mm_cvtsi32_si128(m_barrett);
+        __m128i polynomial = _mm_cvtsi32_si128(m_polynomial);
+
+        __m128i* src_ptr = (__m128i*)src;
+        __m128i* dest_ptr = (__m128i*)dest;
+        for (uint32_t i = 0; i < sse_size; i++, src_ptr++, dest_ptr++)
+        {
+            // Load the next 16-bytes of the source buffer
+            __m128i xmm0 = _mm_loadu_si128(src_ptr);
+            // Multiply the src with the constant
+            xmm0 = multiply(xmm0, c, barrett, polynomial);
+            // Load the next 16-bytes of the destination buffer
+            __m128i xmm1 = _mm_loadu_si128(dest_ptr);
+            // Xor the multiplication result and the destination value
+            xmm0 = _mm_xor_si128(xmm0, xmm1);
+            // Store the result in the destination buffer
+            _mm_storeu_si128(dest_ptr, xmm0);
+        }
+    }
+
+    void pclmul_binary16_online::region_multiply_subtract(value_type* dest,
+        const value_type* src, value_type constant, uint32_t length) const
+    {
+        // In a binary extension field addition is the same as subtraction
+        region_multiply_add(dest, src, constant, length);
+    }
+
+    uint32_t pclmul_binary16_online::alignment() const
+    {
+        return sizeof(value_type);
+    }
+
+    uint32_t pclmul_binary16_online::max_alignment() const
+    {
+        return alignment();
+    }
+
+    uint32_t pclmul_binary16_online::granularity() const
+    {
+        // We are working over 16 bytes at a time i.e. 128 bits so we
+        // require a length granularity of 8 elements. We expect that
+        // binary16 uses uint16_t as value_type
+        static_assert(std::is_same<value_type, uint16_t>::value,
+                      "Here we expect binary16 to use uint16_t as value_type");
+        return 8U;
+    }
+
+    uint32_t pclmul_binary16_online::max_granularity() const
+    {
+        return granularity();
+    }
+
+    bool pclmul_binary16_online::enabled() const
+    {
+        static cpuid::cpuinfo info;
+        return info.has_pclmulqdq();
+    }
+
+#else
+
+    pclmul_binary16_online::pclmul_binary16_online()
+    { }
+
+    void pclmul_binary16_online::region_add(
+        value_type*, const value_type*, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
+    void pclmul_binary16_online::region_subtract(
+        value_type*, const value_type*, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
+    void pclmul_binary16_online::region_multiply_constant(
+        value_type*, value_type, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
+    void pclmul_binary16_online::region_multiply_add(
+        value_type*, const value_type*, value_type, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
+    void pclmul_binary16_online::region_multiply_subtract(
+        value_type*, const value_type*, value_type, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
+    uint32_t pclmul_binary16_online::alignment() const
+    {
+        // Not implemented
+        assert(0);
+        return 0;
+    }
+
+    uint32_t pclmul_binary16_online::max_alignment() const
+    {
+        // Not implemented
+        assert(0);
+        return 0;
+    }
+
+    uint32_t pclmul_binary16_online::granularity() const
+    {
+        // Not implemented
+        assert(0);
+        return 0;
+    }
+
+    uint32_t pclmul_binary16_online::max_granularity() const
+    {
+        // Not implemented
+        assert(0);
+        return 0;
+    }
+
+    bool pclmul_binary16_online::enabled() const
+    {
+        return false;
+    }
+
+#endif
+
+}
@@ -0,0 +1,116 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+#include "binary32.hpp"
+#include "region_backend.hpp"
+#include "target_instruction_set.hpp"
+
+namespace fifi
+{
+    /// pclmul_binary32_online
+    ///
+    /// Stack implementing PCLMULQDQ accelerated finite field
+    /// arithmetic for the binary32 field. The elements are spread
+    /// into 64-bit slots and multiplied with the constant using the
+    /// carry-less multiplication instruction. The 63-bit products are
+    /// reduced with Barrett reduction, which needs two additional
+    /// carry-less multiplications and no look-up tables. The
+    /// following intrinsics are used available in the following SIMD
+    /// versions:
+    ///
+    /// _mm_loadu_si128 (SSE2)
+    /// _mm_setzero_si128 (SSE2)
+    /// _mm_cvtsi32_si128 (SSE2)
+    /// _mm_set_epi32 (SSE2)
+    /// _mm_unpacklo_epi32 (SSE2)
+    /// _mm_unpackhi_epi32 (SSE2)
+    /// _mm_unpacklo_epi64 (SSE2)
+    /// _mm_srli_epi64 (SSE2)
+    /// _mm_shuffle_epi32 (SSE2)
+    /// _mm_xor_si128 (SSE2)
+    /// _mm_storeu_si128 (SSE2)
+    /// _mm_clmulepi64_si128 (PCLMULQDQ)
+    ///
+    /// Based on this we see that the minimum required instruction for this
+    /// optimization is the carry-less multiplication (PCLMULQDQ).
+    class pclmul_binary32_online
+    {
+    public:
+
+        /// @copydoc layer::field_type
+        typedef binary32 field_type;
+
+        /// @copydoc layer::value_type
+        typedef binary32::value_type value_type;
+
+        /// True if the build targets PCLMULQDQ, in which case the stack is
+        /// known to be enabled @see target_instruction_set
+        static const bool statically_enabled =
+            target_instruction_set::pclmul;
+
+        /// The backend of the stack @see region_backend
+        static const region_backend backend = region_backend::pclmul;
+
+    public:
+
+        /// Constructor
+        pclmul_binary32_online();
+
+        /// @copydoc layer::region_add(
+        ///     value_type*, value_type*, uint32_t) const
+        void region_add(
+            value_type* dest, const value_type* src, uint32_t length) const;
+
+        /// @copydoc layer::region_subtract(
+        ///     value_type*, value_type*, uint32_t) const
+        void region_subtract(
+            value_type* dest, const value_type* src, uint32_t length) const;
+
+        /// @copydoc layer::region_multiply_constant(
+        ///      value_type*, value_type, uint32_t) const
+        void region_multiply_constant(
+            value_type* dest, value_type constant, uint32_t length) const;
+
+        /// @copydoc layer::region_multiply_add(
+        ///     value_type*, const value_type*, value_type, uint32_t) const
+        void region_multiply_add(value_type* dest, const value_type* src,
+            value_type constant, uint32_t length) const;
+
+        /// @copydoc layer::region_multiply_subtract(
+        ///     value_type*, const value_type*, value_type, uint32_t) const
+        void region_multiply_subtract(value_type* dest, const value_type* src,
+            value_type constant, uint32_t length) const;
+
+        /// @copydoc layer::alignment() const
+        uint32_t alignment() const;
+
+        /// @copydoc layer::max_alignment() const
+        uint32_t max_alignment() const;
+
+        /// @copydoc layer::granularity() const
+        uint32_t granularity() const;
+
+        /// @copydoc layer::max_granularity() const
+        uint32_t max_granularity() const;
+
+        /// @return true if the executable was built with PCLMULQDQ
+        ///         binary32 support
+        bool enabled() const;
+
+    private:
+
+        /// The field polynomial including the x^32 term
+        uint64_t m_polynomial;
+
+        /// The Barrett constant i.e. the quotient of x^64 divided by
+        /// the field polynomial
+        uint64_t m_barrett;
+    };
+}
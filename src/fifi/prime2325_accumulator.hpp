@@ -0,0 +1,192 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "prime2325.hpp"
+
+namespace fifi
+{
+    /// Accumulator for long chains of multiply-add operations in the
+    /// 2^32 - 5 prime field. Instead of fully reducing every element
+    /// after each multiplication, as optimal_prime_arithmetic does, the
+    /// products are folded once into 64 bit partial sums. The partial
+    /// sums are reduced modulo 2^32 - 5 only when the result is
+    /// finalized. The final result is the same as the one produced by
+    /// the corresponding chain of region_multiply_add() calls.
+    ///
+    /// Typical use when computing a linear combination:
+    ///
+    ///     fifi::prime2325_accumulator accumulator(length);
+    ///     accumulator.add(dest);
+    ///     accumulator.multiply_add(src_one, constant_one);
+    ///     accumulator.multiply_add(src_two, constant_two);
+    ///     accumulator.finalize(dest);
+    class prime2325_accumulator
+    {
+    public:
+
+        /// The field type
+        typedef prime2325 field_type;
+
+        /// The value type
+        typedef prime2325::value_type value_type;
+
+        /// The data type used for the partial sums
+        typedef uint64_t sum_type;
+
+    public:
+
+        /// Creates a new accumulator with all partial sums set to zero
+        /// @param length the number of elements in the accumulated regions
+        prime2325_accumulator(uint32_t length)
+            : m_sums(length, 0),
+              m_terms(0)
+        {
+            assert(length > 0);
+        }
+
+        /// @return the number of elements in the accumulated regions
+        uint32_t length() const
+        {
+            return (uint32_t) m_sums.size();
+        }
+
+        /// Sets all partial sums to zero
+        void clear()
+        {
+            std::fill(m_sums.begin(), m_sums.end(), 0);
+            m_terms = 0;
+        }
+
+        /// Adds the elements of a region to the partial sums
+        /// @param src the region with length() elements to add
+        void add(const value_type* src)
+        {
+            assert(src != 0);
+
+            make_room();
+
+            for (uint32_t i = 0; i < m_sums.size(); ++i)
+            {
+                assert(src[i] < field_type::prime);
+                m_sums[i] += src[i];
+            }
+
+            ++m_terms;
+        }
+
+        /// Multiplies the elements of a region with a constant and adds
+        /// the products to the partial sums
+        /// @param src the region with length() elements to multiply
+        /// @param constant the constant to multiply with
+        void multiply_add(const value_type* src, value_type constant)
+        {
+            assert(src != 0);
+            assert(constant < field_type::prime);
+
+            make_room();
+
+            for (uint32_t i = 0; i < m_sums.size(); ++i)
+            {
+                assert(src[i] < field_type::prime);
+                m_sums[i] += fold((uint64_t) src[i] * constant);
+            }
+
+            ++m_terms;
+        }
+
+        /// Multiplies the elements of a region with a constant and
+        /// subtracts the products from the partial sums
+        /// @param src the region with length() elements to multiply
+        /// @param constant the constant to multiply with
+        void multiply_subtract(const value_type* src, value_type constant)
+        {
+            assert(constant < field_type::prime);
+
+            // Subtracting c * src is the same as adding (prime - c) * src
+            value_type negated =
+                constant == 0 ? 0 : field_type::prime - constant;
+
+            multiply_add(src, negated);
+        }
+
+        /// Reduces the partial sums modulo 2^32 - 5 and writes the
+        /// result. The accumulator is cleared afterwards so it can be
+        /// reused for the next chain.
+        /// @param dest the region with length() elements to write
+        void finalize(value_type* dest)
+        {
+            assert(dest != 0);
+
+            for (uint32_t i = 0; i < m_sums.size(); ++i)
+            {
+                dest[i] = reduce(m_sums[i]);
+            }
+
+            clear();
+        }
+
+        /// @return the maximum number of terms which can be accumulated
+        ///         before the partial sums have to be reduced. A folded
+        ///         product is below 6 * 2^32 so 2^29 terms fit in 64 bits.
+        static uint32_t max_terms()
+        {
+            return 1U << 29;
+        }
+
+    private:
+
+        /// Folds a 64 bit value using that 2^32 = 5 modulo 2^32 - 5
+        /// @param c the value to fold
+        /// @return a value below 6 * 2^32 which is congruent with c
+        static sum_type fold(sum_type c)
+        {
+            return (c & 0xffffffff) + (c >> 32) * 5;
+        }
+
+        /// Reduces a 64 bit value modulo 2^32 - 5
+        /// @param c the value to reduce
+        /// @return the reduced value
+        static value_type reduce(sum_type c)
+        {
+            // After the first fold c is below 6 * 2^32 and after the
+            // second below 2^32 + 25 so one subtraction is enough
+            c = fold(fold(c));
+            c = c >= field_type::prime ? c - field_type::prime : c;
+
+            return static_cast<value_type>(c);
+        }
+
+        /// Reduces the partial sums in place if the next term could
+        /// overflow them. This only happens for extremely long chains.
+        void make_room()
+        {
+            if (m_terms < max_terms())
+                return;
+
+            for (uint32_t i = 0; i < m_sums.size(); ++i)
+            {
+                m_sums[i] = reduce(m_sums[i]);
+            }
+
+            // The reduced sums count as a single term
+            m_terms = 1;
+        }
+
+    private:
+
+        /// The 64 bit partial sums
+        std::vector<sum_type> m_sums;
+
+        /// The number of terms accumulated since the last reduction
+        uint32_t m_terms;
+    };
+}
@@ -5,17 +5,24 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 #include <sak/storage.hpp>
 
 #include "prime2325.hpp"
 #include "prime2325_prefix_length.hpp"
+#include "thread_pool.hpp"
 
 namespace fifi
 {
+    /// The default size in bytes of the smallest blocks searched in
+    /// parallel by a prime2325_binary_search
+    const uint32_t prime2325_binary_search_parallel_size = 262144;
+
     /// Binary search algorithms for finding an unused bit prefix in arbitrary
     /// binary data. The algorithms can search for the prefix using k passes.
     /// When k = 2 the algorithms will have to pass over the entire block of
@@ -24,6 +31,12 @@ namespace fifi
     /// smaller the memory consumption becomes.
     /// Using the found prefix we may map arbitrary data to the 2^32 - 5 prime
     /// field an approach which was suggested by Crowley et al.
+    ///
+    /// When a thread pool is set, the passes over large blocks are split
+    /// across the threads of the pool. Each thread counts the values of
+    /// its part of the block in a private set of buckets, and the buckets
+    /// are summed before the prefix is updated, so the prefix found is
+    /// the same as without the pool.
     struct prime2325_binary_search
     {
         /// The data type used for the bitmap
@@ -39,7 +52,8 @@ namespace fifi
         prime2325_binary_search(uint32_t max_block_length, uint32_t k_pass = 2)
             : m_max_block_length(max_block_length),
               m_max_block_size(m_max_block_length * 4),
-              m_k_pass(k_pass)
+              m_k_pass(k_pass),
+              m_parallel_threshold(prime2325_binary_search_parallel_size / 4)
         {
             assert(m_max_block_length <= prime2325::max_block_length);
             assert(m_max_block_length > 0);
@@ -159,6 +173,29 @@ namespace fifi
 
             uint32_t prefix = 0;
 
+            if (is_parallel(size / 4))
+            {
+                // The storage objects are collected once and split
+                // across the threads in every pass
+                m_segments.clear();
+                for (StorageIterator it = first; it != last; ++it)
+                {
+                    assert((it->m_size % 4) == 0);
+
+                    segment s = { sak::cast_storage<uint32_t>(*it),
+                                  it->m_size / 4 };
+                    m_segments.push_back(s);
+                }
+
+                for (uint32_t k = 0; k < m_k_pass; ++k)
+                {
+                    update_buckets_parallel(size / 4, k, prefix);
+                    update_prefix(k, &prefix);
+                }
+
+                return prefix;
+            }
+
             for (uint32_t k = 0; k < m_k_pass; ++k)
             {
                 update_buckets(first, last, k, prefix);
@@ -168,6 +205,43 @@ namespace fifi
             return prefix;
         }
 
+        /// @param pool The thread pool counting the values of large
+        ///        blocks, or an empty pointer to count all values on the
+        ///        calling thread
+        void set_pool(const std::shared_ptr<thread_pool>& pool)
+        {
+            m_pool = pool;
+        }
+
+        /// @return The thread pool counting the values of large blocks,
+        ///         empty if no pool is set
+        const std::shared_ptr<thread_pool>& pool() const
+        {
+            return m_pool;
+        }
+
+        /// @param length The block length in uint32_t elements below
+        ///        which blocks are searched on the calling thread
+        void set_parallel_threshold(uint32_t length)
+        {
+            m_parallel_threshold = length;
+        }
+
+        /// @return The block length in uint32_t elements below which
+        ///         blocks are searched on the calling thread
+        uint32_t parallel_threshold() const
+        {
+            return m_parallel_threshold;
+        }
+
+        /// @param length The block length in uint32_t elements
+        /// @return True if a block of the length is searched in parallel
+        bool is_parallel(uint32_t length) const
+        {
+            return m_pool && m_pool->threads() > 1 &&
+                length >= m_parallel_threshold;
+        }
+
         /// Iterates through the bitmap looking for the unused prefix
         /// @param k denotes the current pass this controls where in the
         ///        prefix the bit pattern found should be placed
@@ -213,12 +287,6 @@ namespace fifi
             // Empty buckets
             std::fill(m_buckets.begin(), m_buckets.end(), 0);
 
-            uint32_t shift_prefix = m_shift_prefix[k];
-            assert(shift_prefix < 32);
-
-            uint32_t shift_mask = m_shift_mask[k];
-            uint32_t prefix_mask = m_prefix_mask[k];
-
             while (first != last)
             {
                 // Size must be multiple of 4 bytes due to the field 2^32-5
@@ -228,22 +296,104 @@ namespace fifi
                 const uint32_t* block_data =
                     sak::cast_storage<uint32_t>(*first);
 
-                for (uint32_t i = 0; i < block_size; ++i)
+                count_values(block_data, block_size, k, prefix,
+                             m_buckets.data());
+
+                ++first;
+            }
+        }
+
+        /// Updates the bucket counters using the values of the storage
+        /// objects collected by find_prefix(). The values are split in
+        /// one part per thread of the pool, which is counted in private
+        /// buckets, and the private buckets are summed in m_buckets.
+        /// @param length the total number of values
+        /// @param k the current pass
+        /// @param prefix the current prefix
+        void update_buckets_parallel(uint32_t length, uint32_t k,
+                                     uint32_t prefix)
+        {
+            assert(m_pool);
+
+            const uint32_t tasks = m_pool->threads();
+            const uint32_t buckets = (uint32_t) m_buckets.size();
+
+            m_thread_buckets.resize(tasks * buckets);
+
+            m_pool->run(tasks, [&](uint32_t task)
+            {
+                counter_type* task_buckets =
+                    m_thread_buckets.data() + task * buckets;
+                std::fill(task_buckets, task_buckets + buckets, 0);
+
+                uint32_t begin =
+                    (uint32_t) ((uint64_t) length * task / tasks);
+                uint32_t end =
+                    (uint32_t) ((uint64_t) length * (task + 1) / tasks);
+
+                // Count the values of the segments overlapping the part
+                // [begin, end) of the block
+                uint32_t offset = 0;
+                for (const segment& s : m_segments)
                 {
-                    // We only count for values which match the already
-                    // found prefix
-                    if ((block_data[i] & prefix_mask) == prefix)
+                    uint32_t first = std::max(begin, offset);
+                    uint32_t last = std::min(end, offset + s.m_size);
+
+                    if (first < last)
                     {
-                        uint32_t bucket_index =
-                            (block_data[i] >> shift_prefix) & shift_mask;
+                        count_values(s.m_data + (first - offset),
+                            last - first, k, prefix, task_buckets);
+                    }
 
-                        assert(bucket_index < m_buckets.size());
+                    offset += s.m_size;
+                }
+            });
 
-                        ++m_buckets[bucket_index];
-                    }
+            std::fill(m_buckets.begin(), m_buckets.end(), 0);
+
+            for (uint32_t task = 0; task < tasks; ++task)
+            {
+                const counter_type* task_buckets =
+                    m_thread_buckets.data() + task * buckets;
+
+                for (uint32_t i = 0; i < buckets; ++i)
+                {
+                    m_buckets[i] += task_buckets[i];
                 }
+            }
+        }
 
-                ++first;
+        /// Counts the values which match the prefix found so far in the
+        /// buckets of the current pass
+        /// @param data the values
+        /// @param size the number of values
+        /// @param k the current pass
+        /// @param prefix the current prefix
+        /// @param buckets the bucket counters
+        void count_values(const uint32_t* data, uint32_t size, uint32_t k,
+                          uint32_t prefix, counter_type* buckets) const
+        {
+            assert(buckets != 0);
+
+            uint32_t shift_prefix = m_shift_prefix[k];
+            assert(shift_prefix < 32);
+
+            uint32_t shift_mask = m_shift_mask[k];
+            uint32_t prefix_mask = m_prefix_mask[k];
+
+            for (uint32_t i = 0; i < size; ++i)
+            {
+                // We only count for values which match the already
+                // found prefix
+                if ((data[i] & prefix_mask) == prefix)
+                {
+                    uint32_t bucket_index =
+                        (data[i] >> shift_prefix) & shift_mask;
+
+                    assert(bucket_index < m_buckets.size());
+
+                    ++buckets[bucket_index];
+                }
             }
         }
 
@@ -272,5 +422,28 @@ namespace fifi
         /// The bitmap storing info about whether a specific prefix was found
         std::vector<counter_type> m_buckets;
 
+        /// A storage object collected for the parallel passes
+        struct segment
+        {
+            /// The values
+            const uint32_t* m_data;
+
+            /// The number of values
+            uint32_t m_size;
+        };
+
+        /// The thread pool counting the values of large blocks
+        std::shared_ptr<thread_pool> m_pool;
+
+        /// The block length below which blocks are searched on the
+        /// calling thread
+        uint32_t m_parallel_threshold;
+
+        /// The storage objects of the block being searched in parallel
+        std::vector<segment> m_segments;
+
+        /// The private buckets of the threads stored one after the other
+        std::vector<counter_type> m_thread_buckets;
+
     };
 }
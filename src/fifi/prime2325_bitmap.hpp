@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <limits>
@@ -12,11 +13,18 @@
 
 #include <sak/storage.hpp>
 
+#include "avx2_prime2325_bitmap.hpp"
+#include "count_trailing_zeros.hpp"
 #include "prime2325.hpp"
 #include "prime2325_prefix_length.hpp"
 
 namespace fifi
 {
+    /// The largest size in bytes of four private bitmaps of a
+    /// prime2325_bitmap for which four are used, i.e. while they fit in
+    /// the L1 cache, otherwise two are used
+    const uint32_t prime2325_bitmap_accumulators_size = 32768;
+
     /// Bitmap algorithm for finding the an unused bit prefix within a block of
     /// data, using the prefix we may map arbitrary data to the 2^32 - 5 prime
     /// field a approach which was suggested by Crowley et al.
@@ -63,6 +71,20 @@ namespace fifi
             // ceil(x/y) = ((x - 1) / y) + 1
             uint32_t bitmap_elements = ((bytes - 1) / sizeof(mapping_type)) + 1;
             m_bitmap.resize(bitmap_elements);
+
+            // With AVX2 the values are spread over private bitmaps which
+            // are merged after the pass over the data, @see
+            // avx2_prime2325_bitmap
+            m_accumulators = 1;
+            if (m_avx2.enabled())
+            {
+                uint32_t size = bitmap_elements * sizeof(mapping_type);
+                m_accumulators =
+                    4 * size <= prime2325_bitmap_accumulators_size ? 4 : 2;
+
+                m_accumulator_bitmaps.resize(
+                    m_accumulators * bitmap_elements);
+            }
         }
 
         /// @param block_length the length of a block
@@ -106,7 +128,35 @@ namespace fifi
             assert(size <= m_max_block_size);
             assert(size > 0);
 
-            std::fill(m_bitmap.begin(), m_bitmap.end(), 0);
+            build_bitmap(first, last);
+
+            uint32_t prefix = 0;
+            bool found = find_in_bitmap(&prefix);
+
+            assert(found);
+
+            return prefix;
+
+        }
+
+        /// Clears the bitmap and marks the prefixes of all values in the
+        /// storage sequence as used
+        /// @param sequence a storage sequence @see sak::storage_list
+        template<class StorageSequence>
+        void build_bitmap(const StorageSequence& sequence)
+        {
+            build_bitmap(sequence.begin(), sequence.end());
+        }
+
+        /// Clears the bitmap and marks the prefixes of all values in the
+        /// storage objects as used, i.e. the pass over the data made by
+        /// find_prefix()
+        /// @param first iterator to a storage object
+        /// @param last iterator to the last storage object
+        template<class StorageIterator>
+        void build_bitmap(StorageIterator first, StorageIterator last)
+        {
+            clear_bitmap();
 
             // Update the bitmap
             while (first != last)
@@ -118,44 +168,137 @@ namespace fifi
                 const uint32_t* block_data =
                     sak::cast_storage<uint32_t>(*first);
 
-                for (uint32_t i = 0; i < block_size; ++i)
-                {
-                    update_bitmap(block_data[i]);
-                }
+                update_bitmap(block_data, block_size);
 
                 ++first;
             }
 
-            uint32_t prefix = 0;
-            bool found = find_in_bitmap(&prefix);
-
-            assert(found);
-
-            return prefix;
-
+            merge_accumulators();
         }
 
-        /// Iterates through the bitmap looking for the unused prefix
+        /// Iterates through the bitmap looking for the unused prefix. The
+        /// lowest unused prefix is returned. Chunks of 256 bits in which
+        /// all prefixes are used are skipped with a single comparison,
+        /// which the compiler can vectorize, and the unused prefix is
+        /// located in the first word with a zero bit by counting the
+        /// trailing ones.
+        ///
         /// @param prefix will contain the unused prefix
         /// @return returns true if the prefix was found otherwise false
         bool find_in_bitmap(uint32_t* prefix) const
         {
-            // Find the missing prefix in the bitmap
-            for (uint32_t i = 0; i < m_bitmap.size(); ++i)
+            assert(prefix != 0);
+
+            const mapping_type full = std::numeric_limits<mapping_type>::max();
+            const uint32_t words = (uint32_t) m_bitmap.size();
+            const mapping_type* bitmap = m_bitmap.data();
+
+            // The number of words in a 256 bit chunk
+            const uint32_t chunk_words = 256 / m_mapping_bits;
+
+            uint32_t i = 0;
+            for (; i + chunk_words <= words; i += chunk_words)
             {
-                for (uint32_t j = 0; j < m_mapping_bits; ++j)
+                mapping_type used = full;
+                for (uint32_t k = 0; k < chunk_words; ++k)
                 {
-                    if ((m_bitmap[i] & (1 << j)) == 0)
-                    {
-                        *prefix = (i * m_mapping_bits + j) << m_shift_prefix;
-                        return true;
-                    }
+                    used &= bitmap[i + k];
+                }
+
+                if (used != full)
+                {
+                    break;
+                }
+            }
+
+            // Find the missing prefix in the remaining words
+            for (; i < words; ++i)
+            {
+                if (bitmap[i] != full)
+                {
+                    uint32_t j = count_trailing_zeros(~bitmap[i]);
+                    *prefix = (i * m_mapping_bits + j) << m_shift_prefix;
+                    return true;
                 }
             }
 
             return false;
         }
 
+        /// Marks all prefixes as unused. With more than one accumulator
+        /// the private bitmaps are cleared, and merge_accumulators() must
+        /// be called before the bitmap is searched.
+        void clear_bitmap()
+        {
+            // The bitmap is overwritten when the private bitmaps are
+            // merged, so only the bitmaps which are updated are cleared
+            if (m_accumulators == 1)
+            {
+                std::fill(m_bitmap.begin(), m_bitmap.end(), 0);
+            }
+            else
+            {
+                std::fill(m_accumulator_bitmaps.begin(),
+                          m_accumulator_bitmaps.end(), 0);
+            }
+        }
+
+        /// Updates the bitmap so that it reflects that the values have been
+        /// found. With more than one accumulator the private bitmaps are
+        /// updated, and merge_accumulators() must be called afterwards.
+        /// @param data the values
+        /// @param size the number of values
+        void update_bitmap(const uint32_t* data, uint32_t size)
+        {
+            if (m_accumulators > 1)
+            {
+                m_avx2.update_bitmaps(m_accumulator_bitmaps.data(),
+                    (uint32_t) m_bitmap.size(), m_accumulators, data, size,
+                    m_shift_prefix);
+                return;
+            }
+
+            // The stores to the bitmap may alias the members, so they are
+            // read once instead of for every value
+            const uint32_t shift_prefix = m_shift_prefix;
+            const uint32_t mapping_bits =
+                std::numeric_limits<mapping_type>::digits;
+            mapping_type* bitmap = m_bitmap.data();
+
+            for (uint32_t i = 0; i < size; ++i)
+            {
+                uint32_t prefix_value = data[i] >> shift_prefix;
+                bitmap[prefix_value / mapping_bits] |=
+                    1U << (prefix_value % mapping_bits);
+            }
+        }
+
+        /// Sets the bitmap to the OR of the private bitmaps
+        void merge_accumulators()
+        {
+            if (m_accumulators == 1)
+            {
+                return;
+            }
+
+            const uint32_t words = (uint32_t) m_bitmap.size();
+            mapping_type* bitmap = m_bitmap.data();
+
+            std::copy(m_accumulator_bitmaps.begin(),
+                      m_accumulator_bitmaps.begin() + words, m_bitmap.begin());
+
+            for (uint32_t a = 1; a < m_accumulators; ++a)
+            {
+                const mapping_type* accumulator =
+                    m_accumulator_bitmaps.data() + a * words;
+
+                for (uint32_t i = 0; i < words; ++i)
+                {
+                    bitmap[i] |= accumulator[i];
+                }
+            }
+        }
+
         /// Updates the bitmap so that it reflects that the value has been found
         void update_bitmap(uint32_t value)
         {
@@ -182,5 +325,16 @@ namespace fifi
 
         /// The bitmap storing info about whether a specific prefix was found
         std::vector<mapping_type> m_bitmap;
+
+        /// The number of bitmaps the values are spread over during the
+        /// pass over the data, 1 if only m_bitmap is used
+        uint32_t m_accumulators;
+
+        /// The private bitmaps stored one after the other, empty if only
+        /// m_bitmap is used
+        std::vector<mapping_type> m_accumulator_bitmaps;
+
+        /// The AVX2 update of the private bitmaps
+        avx2_prime2325_bitmap m_avx2;
     };
 }
@@ -0,0 +1,199 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include <sak/storage.hpp>
+
+namespace fifi
+{
+    /// The default size in bytes of the chunks a prime2325_mapper
+    /// applies the prefix to
+    const uint32_t prime2325_mapper_chunk_size = 65536;
+
+    /// Maps arbitrary data to the 2^32 - 5 prime field, i.e. finds an
+    /// unused prefix with the Search algorithm, e.g. prime2325_bitmap or
+    /// prime2325_binary_search, and applies the inverted prefix to all
+    /// values, @see apply_prefix.
+    ///
+    /// The prefix depends on all values, so the search has to pass over
+    /// the whole block before any value is mapped. The prefix is then
+    /// applied chunk by chunk starting from the end of the block, so the
+    /// chunks read last by the search are mapped while they are still in
+    /// the cache. The mapped values can be written to a separate
+    /// destination buffer, in which case the source is not modified and
+    /// no copy of it is needed.
+    ///
+    /// Example:
+    ///
+    /// fifi::prime2325_mapper<fifi::prime2325_bitmap> mapper(length);
+    /// uint32_t prefix = mapper.map_to(sak::storage(data), dest);
+    template<class Search>
+    class prime2325_mapper
+    {
+    public:
+
+        /// @param max_block_length The largest block length in uint32_t
+        ///        elements which can be mapped
+        prime2325_mapper(uint32_t max_block_length) :
+            m_search(max_block_length),
+            m_chunk_length(prime2325_mapper_chunk_size / 4)
+        { }
+
+        /// Maps the values of the storage sequence in place
+        /// @param sequence a storage sequence @see sak::storage_list
+        /// @return the prefix which was found
+        template<class StorageSequence>
+        uint32_t map(const StorageSequence& sequence)
+        {
+            return map(sequence.begin(), sequence.end());
+        }
+
+        /// Maps the values of the storage objects in place
+        /// @param first iterator to a storage object
+        /// @param last iterator to the last storage object
+        /// @return the prefix which was found
+        template<class StorageIterator>
+        uint32_t map(StorageIterator first, StorageIterator last)
+        {
+            m_segments.clear();
+
+            for (StorageIterator it = first; it != last; ++it)
+            {
+                assert((it->m_size % 4) == 0);
+
+                uint32_t* data = sak::cast_storage<uint32_t>(*it);
+                segment s = { data, data, it->m_size / 4 };
+                m_segments.push_back(s);
+            }
+
+            uint32_t prefix = m_search.find_prefix(first, last);
+            apply(~prefix);
+
+            return prefix;
+        }
+
+        /// Maps the values of the storage sequence to the destination
+        /// @param sequence a storage sequence @see sak::storage_list
+        /// @param dest the destination buffer, which must hold all values
+        ///        of the sequence and must not overlap it
+        /// @return the prefix which was found
+        template<class StorageSequence>
+        uint32_t map_to(const StorageSequence& sequence, uint32_t* dest)
+        {
+            return map_to(sequence.begin(), sequence.end(), dest);
+        }
+
+        /// Maps the values of the storage objects to the destination, the
+        /// values of the storage objects are stored one after the other
+        /// @param first iterator to a storage object
+        /// @param last iterator to the last storage object
+        /// @param dest the destination buffer, which must hold all values
+        ///        of the storage objects and must not overlap them
+        /// @return the prefix which was found
+        template<class StorageIterator>
+        uint32_t map_to(StorageIterator first, StorageIterator last,
+                        uint32_t* dest)
+        {
+            assert(dest != 0);
+
+            m_segments.clear();
+
+            for (StorageIterator it = first; it != last; ++it)
+            {
+                assert((it->m_size % 4) == 0);
+
+                uint32_t size = it->m_size / 4;
+                segment s = { sak::cast_storage<uint32_t>(*it), dest, size };
+                m_segments.push_back(s);
+
+                dest += size;
+            }
+
+            uint32_t prefix = m_search.find_prefix(first, last);
+            apply(~prefix);
+
+            return prefix;
+        }
+
+        /// @param length The length in uint32_t elements of the chunks
+        ///        the prefix is applied to
+        void set_chunk_length(uint32_t length)
+        {
+            assert(length > 0);
+            m_chunk_length = length;
+        }
+
+        /// @return The length in uint32_t elements of the chunks the
+        ///         prefix is applied to
+        uint32_t chunk_length() const
+        {
+            return m_chunk_length;
+        }
+
+        /// @return The search algorithm finding the prefix
+        Search& search()
+        {
+            return m_search;
+        }
+
+    private:
+
+        /// The values of a storage object and their destination
+        struct segment
+        {
+            /// The values
+            const uint32_t* m_src;
+
+            /// The destination of the mapped values, equal to m_src when
+            /// mapping in place
+            uint32_t* m_dest;
+
+            /// The number of values
+            uint32_t m_size;
+        };
+
+        /// Applies the mask to all values chunk by chunk, starting with
+        /// the last chunk of the last segment
+        /// @param mask the mask to XOR the values with
+        void apply(uint32_t mask)
+        {
+            for (auto s = m_segments.rbegin(); s != m_segments.rend(); ++s)
+            {
+                uint32_t end = s->m_size;
+                while (end > 0)
+                {
+                    uint32_t begin = end - std::min(end, m_chunk_length);
+
+                    const uint32_t* src = s->m_src;
+                    uint32_t* dest = s->m_dest;
+
+                    for (uint32_t i = begin; i < end; ++i)
+                    {
+                        dest[i] = src[i] ^ mask;
+                    }
+
+                    end = begin;
+                }
+            }
+        }
+
+    private:
+
+        /// The search algorithm finding the prefix
+        Search m_search;
+
+        /// The length in uint32_t elements of the chunks
+        uint32_t m_chunk_length;
+
+        /// The storage objects of the block being mapped
+        std::vector<segment> m_segments;
+    };
+}
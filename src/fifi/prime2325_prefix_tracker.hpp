@@ -0,0 +1,139 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+#include <sak/storage.hpp>
+
+#include "prime2325_bitmap.hpp"
+
+namespace fifi
+{
+    /// Tracks the prefixes used by a block which arrives in pieces, e.g.
+    /// as a stream of packets. The pieces are added to the bitmap of a
+    /// prime2325_bitmap as they arrive, so an unused prefix for the values
+    /// added so far can be found at any point without passing over the
+    /// data again.
+    ///
+    /// Example:
+    ///
+    /// fifi::prime2325_prefix_tracker tracker(max_block_length);
+    /// tracker.add(sak::storage(packet_one));
+    /// tracker.add(sak::storage(packet_two));
+    /// uint32_t prefix = tracker.prefix();
+    ///
+    /// A prefix is only unused by the values added before it was found,
+    /// so it must be found again when more values are added.
+    class prime2325_prefix_tracker
+    {
+    public:
+
+        /// @param max_block_length The largest number of uint32_t values
+        ///        which can be added before the tracker is reset
+        prime2325_prefix_tracker(uint32_t max_block_length) :
+            m_search(max_block_length),
+            m_length(0),
+            m_merged(false)
+        {
+            m_search.clear_bitmap();
+        }
+
+        /// Adds the values of the storage sequence
+        /// @param sequence a storage sequence @see sak::storage_list
+        template<class StorageSequence>
+        void add(const StorageSequence& sequence)
+        {
+            add(sequence.begin(), sequence.end());
+        }
+
+        /// Adds the values of the storage objects
+        /// @param first iterator to a storage object
+        /// @param last iterator to the last storage object
+        template<class StorageIterator>
+        void add(StorageIterator first, StorageIterator last)
+        {
+            while (first != last)
+            {
+                // Size must be multiple of 4 bytes due to the field 2^32-5
+                assert((first->m_size % 4) == 0);
+
+                add(sak::cast_storage<uint32_t>(*first), first->m_size / 4);
+                ++first;
+            }
+        }
+
+        /// Adds the values
+        /// @param data the values
+        /// @param size the number of values
+        void add(const uint32_t* data, uint32_t size)
+        {
+            assert(data != 0 || size == 0);
+            assert(size <= m_search.m_max_block_length - m_length);
+
+            m_search.update_bitmap(data, size);
+
+            m_length += size;
+            m_merged = false;
+        }
+
+        /// @return The lowest prefix which is not used by any of the
+        ///         values added so far
+        uint32_t prefix()
+        {
+            // The private bitmaps are only merged when a prefix is
+            // needed, not after every piece
+            if (!m_merged)
+            {
+                m_search.merge_accumulators();
+                m_merged = true;
+            }
+
+            uint32_t prefix = 0;
+            bool found = m_search.find_in_bitmap(&prefix);
+
+            assert(found);
+            (void) found;
+
+            return prefix;
+        }
+
+        /// Removes all values, so a new block can be tracked
+        void reset()
+        {
+            m_search.clear_bitmap();
+
+            m_length = 0;
+            m_merged = false;
+        }
+
+        /// @return The number of values added since the tracker was
+        ///         created or reset
+        uint32_t length() const
+        {
+            return m_length;
+        }
+
+        /// @return The largest number of values which can be added
+        uint32_t max_block_length() const
+        {
+            return m_search.m_max_block_length;
+        }
+
+    private:
+
+        /// The bitmap of the prefixes used by the values added so far
+        prime2325_bitmap m_search;
+
+        /// The number of values added so far
+        uint32_t m_length;
+
+        /// True if the private bitmaps of m_search have been merged
+        /// since values were last added
+        bool m_merged;
+    };
+}
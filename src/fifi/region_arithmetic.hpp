@@ -146,5 +146,89 @@ namespace fifi
                 dest[i] = Super::packed_subtract(dest[i], v);
             }
         }
+
+        /// Computes the linear combination of a number of source
+        /// regions i.e. dest[i] = sum_j constants[j] * srcs[j][i]. The
+        /// previous content of dest is overwritten. Each element of
+        /// dest is only written once instead of once per source as
+        /// with repeated calls to region_multiply_add(). The
+        /// destination buffer must not overlap any of the sources.
+        ///
+        /// @param dest The destination buffer
+        /// @param srcs Array with count pointers to the source buffers
+        /// @param constants Array with the count packed constants
+        /// @param count The number of source buffers
+        /// @param length The length of the buffers in value_type elements
+        void region_linear_combination(value_type* dest,
+                                       const value_type* const* srcs,
+                                       const value_type* constants,
+                                       uint32_t count,
+                                       uint32_t length) const
+        {
+            assert(dest != 0);
+            assert(srcs != 0);
+            assert(constants != 0);
+            assert(count > 0);
+            assert(length > 0);
+
+            for (uint32_t i = 0; i < length; ++i)
+            {
+                assert(srcs[0] != 0);
+                assert(is_packed_constant<field_type>(constants[0]));
+
+                value_type v = Super::packed_multiply(srcs[0][i], constants[0]);
+
+                for (uint32_t j = 1; j < count; ++j)
+                {
+                    assert(srcs[j] != 0);
+                    assert(is_packed_constant<field_type>(constants[j]));
+
+                    v = Super::packed_add(
+                        v, Super::packed_multiply(srcs[j][i], constants[j]));
+                }
+
+                dest[i] = v;
+            }
+        }
+
+        /// Multiplies a source region with a number of constants and
+        /// adds the products to the corresponding destination regions
+        /// i.e. dests[j][i] = dests[j][i] + constants[j] * src[i]. Each
+        /// element of src is only read once instead of once per
+        /// destination as with repeated calls to region_multiply_add().
+        /// The destination buffers must not overlap each other or the
+        /// source.
+        ///
+        /// @param dests Array with count pointers to the destination buffers
+        /// @param src The source buffer
+        /// @param constants Array with the count packed constants
+        /// @param count The number of destination buffers
+        /// @param length The length of the buffers in value_type elements
+        void region_multiply_add_many(value_type* const* dests,
+                                      const value_type* src,
+                                      const value_type* constants,
+                                      uint32_t count,
+                                      uint32_t length) const
+        {
+            assert(dests != 0);
+            assert(src != 0);
+            assert(constants != 0);
+            assert(count > 0);
+            assert(length > 0);
+
+            for (uint32_t i = 0; i < length; ++i)
+            {
+                value_type v = src[i];
+
+                for (uint32_t j = 0; j < count; ++j)
+                {
+                    assert(dests[j] != 0);
+                    assert(is_packed_constant<field_type>(constants[j]));
+
+                    dests[j][i] = Super::packed_add(
+                        dests[j][i], Super::packed_multiply(v, constants[j]));
+                }
+            }
+        }
     };
 }
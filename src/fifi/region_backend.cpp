@@ -0,0 +1,92 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+#include "region_backend.hpp"
+
+namespace fifi
+{
+    namespace
+    {
+        /// All backends in the order of their declaration
+        const region_backend backends[] =
+        {
+            region_backend::automatic,
+            region_backend::basic,
+            region_backend::ssse3,
+            region_backend::sse41,
+            region_backend::pclmul,
+            region_backend::avx2,
+            region_backend::neon
+        };
+
+        /// @return The backend named by the FIFI_REGION_BACKEND
+        ///         environment variable
+        region_backend read_environment()
+        {
+            region_backend backend = region_backend::automatic;
+
+            const char* name = std::getenv("FIFI_REGION_BACKEND");
+            if (name != 0)
+            {
+                region_backend_from_name(name, &backend);
+            }
+
+            return backend;
+        }
+    }
+
+    const char* region_backend_name(region_backend backend)
+    {
+        switch (backend)
+        {
+        case region_backend::automatic:
+            return "automatic";
+        case region_backend::basic:
+            return "basic";
+        case region_backend::ssse3:
+            return "ssse3";
+        case region_backend::sse41:
+            return "sse41";
+        case region_backend::pclmul:
+            return "pclmul";
+        case region_backend::avx2:
+            return "avx2";
+        case region_backend::neon:
+            return "neon";
+        default:
+            assert(0);
+            return "";
+        }
+    }
+
+    bool region_backend_from_name(const std::string& name,
+                                  region_backend* backend)
+    {
+        assert(backend != 0);
+
+        for (region_backend b : backends)
+        {
+            if (name == region_backend_name(b))
+            {
+                *backend = b;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    region_backend default_region_backend()
+    {
+        // C++11 guarantees that the initialization is thread-safe
+        static const region_backend backend = read_environment();
+        return backend;
+    }
+}
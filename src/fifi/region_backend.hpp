@@ -0,0 +1,48 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <string>
+
+namespace fifi
+{
+    /// The implementations a region operation can be computed by. The
+    /// basic backend is the portable arithmetic of the stack e.g. the
+    /// full look-up table, the other backends are the SIMD stacks using
+    /// the named instruction set @see region_dispatcher.
+    enum class region_backend
+    {
+        /// Selects the fastest backend supported by the CPU, this is
+        /// only used when choosing a backend
+        automatic,
+        basic,
+        ssse3,
+        sse41,
+        pclmul,
+        avx2,
+        neon
+    };
+
+    /// @param backend The backend
+    /// @return The name of the backend e.g. "ssse3"
+    const char* region_backend_name(region_backend backend);
+
+    /// @param name The name of a backend as returned by
+    ///        region_backend_name()
+    /// @param backend Set to the backend with the name
+    /// @return True if the name is the name of a backend, otherwise false
+    ///         in which case the backend is left unchanged
+    bool region_backend_from_name(const std::string& name,
+                                  region_backend* backend);
+
+    /// The backend which new stacks use, taken from the environment
+    /// variable FIFI_REGION_BACKEND e.g. FIFI_REGION_BACKEND=basic. If
+    /// the variable is not set or not the name of a backend the backend
+    /// is selected automatically. The variable is read once.
+    ///
+    /// @return The backend which new stacks use
+    region_backend default_region_backend();
+}
@@ -0,0 +1,184 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "region_thresholds.hpp"
+#include "scheduler_job.hpp"
+
+namespace fifi
+{
+    /// A list of independent region operations which are executed in
+    /// parallel by a work_stealing_scheduler, e.g. the coded symbols of
+    /// an encoder. Each operation is described by a descriptor and is
+    /// computed with a single call to the stack.
+    ///
+    /// Example:
+    ///
+    /// fifi::work_stealing_scheduler scheduler(4);
+    /// fifi::region_batch<fifi::full_table<fifi::binary8>> batch(field);
+    /// batch.add(fifi::region_thresholds::region_multiply_add,
+    ///           dest, src, constant, length);
+    /// ...
+    /// scheduler.submit(batch, [] { /* all operations are done */ });
+    /// batch.wait();
+    ///
+    /// The operations of a batch must be independent, i.e. an operation
+    /// must not write to a buffer which is used by another operation of
+    /// the batch. The stack and the buffers must stay alive until the
+    /// batch is done, and the batch must not be changed while it runs.
+    template<class Stack>
+    class region_batch : public scheduler_job
+    {
+    public:
+
+        /// The field type
+        typedef typename Stack::field_type field_type;
+
+        /// Typedef of the data type used for each field element
+        typedef typename Stack::value_type value_type;
+
+        /// The descriptor of a region operation
+        struct descriptor
+        {
+            /// The operation, region_linear_combination and
+            /// region_multiply_add_many are not supported
+            region_thresholds::operation m_op;
+
+            /// The destination buffer
+            value_type* m_dest;
+
+            /// The source buffer, not used by region_multiply_constant
+            const value_type* m_src;
+
+            /// The packed constant, only used by the operations with a
+            /// constant
+            value_type m_constant;
+
+            /// The length of the buffers in value_type elements
+            uint32_t m_length;
+        };
+
+    public:
+
+        /// @param stack The stack computing the operations
+        region_batch(const Stack& stack) :
+            m_stack(stack)
+        { }
+
+        /// Waits for the batch to complete if it is running
+        ~region_batch()
+        {
+            wait();
+        }
+
+        /// Adds an operation to the batch
+        ///
+        /// @param operation The descriptor of the operation
+        void add(const descriptor& operation)
+        {
+            assert(is_done());
+            assert(operation.m_dest != 0);
+            assert(operation.m_length > 0);
+            assert(operation.m_op !=
+                   region_thresholds::region_linear_combination);
+            assert(operation.m_op !=
+                   region_thresholds::region_multiply_add_many);
+            assert(operation.m_op < region_thresholds::operations);
+            assert(operation.m_src != 0 || operation.m_op ==
+                   region_thresholds::region_multiply_constant);
+
+            m_operations.push_back(operation);
+        }
+
+        /// Adds an operation to the batch
+        ///
+        /// @param op The operation
+        /// @param dest The destination buffer
+        /// @param src The source buffer, may be zero for
+        ///        region_multiply_constant
+        /// @param constant The packed constant
+        /// @param length The length of the buffers in value_type elements
+        void add(region_thresholds::operation op, value_type* dest,
+            const value_type* src, value_type constant, uint32_t length)
+        {
+            descriptor operation = { op, dest, src, constant, length };
+            add(operation);
+        }
+
+        /// Removes all operations from the batch
+        void clear()
+        {
+            assert(is_done());
+            m_operations.clear();
+        }
+
+        /// @param index The index of an operation
+        /// @return The descriptor of the operation
+        const descriptor& operation(uint32_t index) const
+        {
+            assert(index < m_operations.size());
+            return m_operations[index];
+        }
+
+        /// @copydoc scheduler_job::tasks() const
+        uint32_t tasks() const
+        {
+            return (uint32_t) m_operations.size();
+        }
+
+        /// Computes an operation of the batch
+        ///
+        /// @param index The index of the operation
+        void execute(uint32_t index)
+        {
+            assert(index < m_operations.size());
+            const descriptor& o = m_operations[index];
+
+            switch (o.m_op)
+            {
+            case region_thresholds::region_add:
+                m_stack.region_add(o.m_dest, o.m_src, o.m_length);
+                break;
+            case region_thresholds::region_subtract:
+                m_stack.region_subtract(o.m_dest, o.m_src, o.m_length);
+                break;
+            case region_thresholds::region_multiply:
+                m_stack.region_multiply(o.m_dest, o.m_src, o.m_length);
+                break;
+            case region_thresholds::region_divide:
+                m_stack.region_divide(o.m_dest, o.m_src, o.m_length);
+                break;
+            case region_thresholds::region_multiply_constant:
+                m_stack.region_multiply_constant(
+                    o.m_dest, o.m_constant, o.m_length);
+                break;
+            case region_thresholds::region_multiply_add:
+                m_stack.region_multiply_add(
+                    o.m_dest, o.m_src, o.m_constant, o.m_length);
+                break;
+            case region_thresholds::region_multiply_subtract:
+                m_stack.region_multiply_subtract(
+                    o.m_dest, o.m_src, o.m_constant, o.m_length);
+                break;
+            default:
+                assert(0 && "Operation not supported by region_batch");
+                break;
+            }
+        }
+
+    private:
+
+        /// The stack computing the operations
+        const Stack& m_stack;
+
+        /// The operations of the batch
+        std::vector<descriptor> m_operations;
+    };
+}
@@ -0,0 +1,332 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "fifi_utils.hpp"
+#include "region_thresholds.hpp"
+
+namespace fifi
+{
+    /// The default size in bytes of the longest buffers measured by
+    /// calibrate_region_thresholds()
+    const uint32_t region_calibration_max_size = 16384;
+
+    /// Measures the region operations of a stack using the
+    /// region_divide_granularity layer to find the length at which the
+    /// optimized layers become faster than the basic layers, @see
+    /// calibrate_region_thresholds().
+    ///
+    /// The operations are measured for lengths from the granularity of
+    /// the optimized layers doubling up to the maximum length. Each
+    /// measurement is repeated a number of times and the fastest run
+    /// is used to reduce the influence of other processes.
+    template<class Stack>
+    class region_calibration
+    {
+    public:
+
+        /// The field type
+        typedef typename Stack::field_type field_type;
+
+        /// The data type used for each field element
+        typedef typename Stack::value_type value_type;
+
+        /// The basic layers of the stack
+        typedef typename Stack::BasicSuper BasicSuper;
+
+        /// The optimized layers of the stack
+        typedef typename Stack::OptimizedSuper OptimizedSuper;
+
+        /// The number of sources or destinations used when measuring
+        /// region_linear_combination and region_multiply_add_many
+        static const uint32_t buffers = 4;
+
+        /// The number of value_type elements processed per measurement,
+        /// short buffers are processed repeatedly to reach this number
+        static const uint32_t measurement_length = 32768;
+
+        /// The number of times each measurement is repeated
+        static const uint32_t measurement_runs = 5;
+
+    public:
+
+        /// @param stack The stack to measure
+        /// @param max_length The longest length to measure in value_type
+        ///        elements
+        region_calibration(const Stack& stack, uint32_t max_length) :
+            m_basic(stack),
+            m_optimized(stack),
+            m_max_length(max_length),
+            m_dest(buffers * max_length),
+            m_src(max_length)
+        {
+            assert(max_length > 0);
+
+            // All elements are one so they can also be used as divisors
+            value_type one = pack_constant<field_type>(1);
+            std::fill(m_dest.begin(), m_dest.end(), one);
+            std::fill(m_src.begin(), m_src.end(), one);
+
+            m_constants.assign(
+                buffers, pack_constant<field_type>(field_type::max_value));
+
+            for (uint32_t j = 0; j < buffers; ++j)
+            {
+                m_dests.push_back(&m_dest[j * max_length]);
+                m_srcs.push_back(&m_src[0]);
+            }
+        }
+
+        /// Measures all region operations
+        ///
+        /// @return The thresholds found for the stack
+        region_thresholds run()
+        {
+            value_type* dest = &m_dest[0];
+            const value_type* src = &m_src[0];
+            value_type constant = m_constants[0];
+
+            value_type* const* dests = &m_dests[0];
+            const value_type* const* srcs = &m_srcs[0];
+            const value_type* constants = &m_constants[0];
+
+            const BasicSuper& basic = m_basic;
+            const OptimizedSuper& optimized = m_optimized;
+
+            region_thresholds thresholds;
+
+            thresholds[region_thresholds::region_add] = find_threshold(
+                [&](uint32_t length)
+                { basic.region_add(dest, src, length); },
+                [&](uint32_t length)
+                { optimized.region_add(dest, src, length); });
+
+            thresholds[region_thresholds::region_subtract] = find_threshold(
+                [&](uint32_t length)
+                { basic.region_subtract(dest, src, length); },
+                [&](uint32_t length)
+                { optimized.region_subtract(dest, src, length); });
+
+            thresholds[region_thresholds::region_multiply] = find_threshold(
+                [&](uint32_t length)
+                { basic.region_multiply(dest, src, length); },
+                [&](uint32_t length)
+                { optimized.region_multiply(dest, src, length); });
+
+            thresholds[region_thresholds::region_divide] = find_threshold(
+                [&](uint32_t length)
+                { basic.region_divide(dest, src, length); },
+                [&](uint32_t length)
+                { optimized.region_divide(dest, src, length); });
+
+            thresholds[region_thresholds::region_multiply_constant] =
+                find_threshold(
+                [&](uint32_t length)
+                {
+                    basic.region_multiply_constant(dest, constant, length);
+                },
+                [&](uint32_t length)
+                {
+                    optimized.region_multiply_constant(
+                        dest, constant, length);
+                });
+
+            thresholds[region_thresholds::region_multiply_add] =
+                find_threshold(
+                [&](uint32_t length)
+                {
+                    basic.region_multiply_add(dest, src, constant, length);
+                },
+                [&](uint32_t length)
+                {
+                    optimized.region_multiply_add(
+                        dest, src, constant, length);
+                });
+
+            thresholds[region_thresholds::region_multiply_subtract] =
+                find_threshold(
+                [&](uint32_t length)
+                {
+                    basic.region_multiply_subtract(
+                        dest, src, constant, length);
+                },
+                [&](uint32_t length)
+                {
+                    optimized.region_multiply_subtract(
+                        dest, src, constant, length);
+                });
+
+            thresholds[region_thresholds::region_linear_combination] =
+                find_threshold(
+                [&](uint32_t length)
+                {
+                    basic.region_linear_combination(
+                        dest, srcs, constants, buffers, length);
+                },
+                [&](uint32_t length)
+                {
+                    optimized.region_linear_combination(
+                        dest, srcs, constants, buffers, length);
+                });
+
+            thresholds[region_thresholds::region_multiply_add_many] =
+                find_threshold(
+                [&](uint32_t length)
+                {
+                    basic.region_multiply_add_many(
+                        dests, src, constants, buffers, length);
+                },
+                [&](uint32_t length)
+                {
+                    optimized.region_multiply_add_many(
+                        dests, src, constants, buffers, length);
+                });
+
+            return thresholds;
+        }
+
+    private:
+
+        /// Finds the shortest length from which the optimized layers are
+        /// at least as fast as the basic layers for all longer measured
+        /// lengths. The optimized layers are preferred when the two are
+        /// within 5 percent of each other, so that measurement noise does
+        /// not move calls away from the optimized layers.
+        ///
+        /// @param basic Calls the operation on the basic layers
+        /// @param optimized Calls the operation on the optimized layers
+        /// @return The threshold of the operation
+        template<class Basic, class Optimized>
+        uint32_t find_threshold(const Basic& basic, const Optimized& optimized)
+        {
+            const OptimizedSuper& optimized_super = m_optimized;
+            uint32_t granularity = optimized_super.granularity();
+            assert(granularity > 0);
+
+            std::vector<uint32_t> lengths;
+            for (uint32_t length = granularity; length <= m_max_length;
+                 length *= 2)
+            {
+                lengths.push_back(length);
+            }
+
+            // If the optimized layers are slower at all measured lengths
+            // the basic layers are used for all calls
+            uint32_t threshold = std::numeric_limits<uint32_t>::max();
+
+            for (auto it = lengths.rbegin(); it != lengths.rend(); ++it)
+            {
+                double basic_time = measure(basic, *it);
+                double optimized_time = measure(optimized, *it);
+
+                if (optimized_time > 1.05 * basic_time)
+                {
+                    break;
+                }
+
+                threshold = *it;
+            }
+
+            // Lengths below the granularity are computed by the basic
+            // layers anyway, so the threshold is not needed
+            if (lengths.empty() || threshold == lengths.front())
+            {
+                return 0;
+            }
+
+            return threshold;
+        }
+
+        /// @param function Calls the operation with the given length
+        /// @param length The length in value_type elements
+        /// @return The fastest time in nanoseconds it took to process
+        ///         measurement_length elements
+        template<class Function>
+        double measure(const Function& function, uint32_t length)
+        {
+            typedef std::chrono::steady_clock clock_type;
+
+            uint32_t repeat = std::max(measurement_length / length, 1U);
+            double fastest = std::numeric_limits<double>::max();
+
+            for (uint32_t run = 0; run < measurement_runs; ++run)
+            {
+                clock_type::time_point start = clock_type::now();
+
+                for (uint32_t i = 0; i < repeat; ++i)
+                {
+                    function(length);
+                }
+
+                std::chrono::duration<double, std::nano> elapsed =
+                    clock_type::now() - start;
+
+                fastest = std::min(fastest, elapsed.count());
+            }
+
+            return fastest;
+        }
+
+    private:
+
+        /// The basic layers of the stack
+        const BasicSuper& m_basic;
+
+        /// The optimized layers of the stack
+        const OptimizedSuper& m_optimized;
+
+        /// The longest length to measure in value_type elements
+        uint32_t m_max_length;
+
+        /// Storage for the destination buffers
+        std::vector<value_type> m_dest;
+
+        /// The source buffer
+        std::vector<value_type> m_src;
+
+        /// The destination buffers
+        std::vector<value_type*> m_dests;
+
+        /// The source buffers
+        std::vector<const value_type*> m_srcs;
+
+        /// The packed constants
+        std::vector<value_type> m_constants;
+    };
+
+    /// Finds the thresholds of a stack on the current CPU, i.e. for each
+    /// region operation the length below which the basic layers are
+    /// faster than the optimized e.g. SIMD layers. The thresholds can be
+    /// set on the stack with region_divide_granularity::set_thresholds()
+    /// and stored using region_thresholds::write(), so the calibration
+    /// only needs to run once.
+    ///
+    /// Example:
+    ///
+    /// fifi::default_field<fifi::binary8>::type field;
+    /// field.set_thresholds(fifi::calibrate_region_thresholds(field));
+    ///
+    /// @param stack The stack to calibrate
+    /// @param max_size The size in bytes of the longest buffers measured
+    /// @return The thresholds found for the stack
+    template<class Stack>
+    inline region_thresholds calibrate_region_thresholds(
+        const Stack& stack, uint32_t max_size = region_calibration_max_size)
+    {
+        typedef typename Stack::field_type field_type;
+
+        uint32_t max_length =
+            std::max(size_to_length<field_type>(max_size), 1U);
+        return region_calibration<Stack>(stack, max_length).run();
+    }
+}
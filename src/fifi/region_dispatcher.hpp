@@ -5,10 +5,16 @@
 
 #pragma once
 
+#include <type_traits>
+
 #include "has_basic_super.hpp"
+#include "has_statically_enabled.hpp"
+#include "region_backend.hpp"
+#include "region_thresholds.hpp"
+#include "target_instruction_set.hpp"
 
 #include "region_dispatcher_specialization.hpp"
-
+#include "region_static_dispatcher_specialization.hpp"
 
 namespace fifi
 {
@@ -18,12 +24,31 @@ namespace fifi
     /// The region_dispatcher layer "extracts" the information needed
     /// by the region_dispatcher_specilization making the embedding
     /// nicer.
+    ///
+    /// If the build targets the instruction sets of the SIMD stacks, and
+    /// the dispatch stack states whether it is enabled at compile-time,
+    /// the region_static_dispatcher_specialization is used instead
+    /// @see target_instruction_set.
+    ///
+    /// The dispatchers of a stack report which backend computes each
+    /// operation, and a backend can be forced to compare the backends
+    /// in the same binary @see region_backend. The dispatch stack must
+    /// state its backend in the static constant backend.
     template<class Stack, class Super>
-    class region_dispatcher :
-        public region_dispatcher_specialization<
+    class region_dispatcher : public std::conditional<
+        target_instruction_set::static_dispatch &&
+        has_statically_enabled<Stack>::value,
+        region_static_dispatcher_specialization<
+            typename Super::field_type, Stack,
+            typename Stack::field_type, Super>,
+        region_dispatcher_specialization<
             typename Super::field_type, Stack,
-            typename Stack::field_type, Super>
+            typename Stack::field_type, Super>>::type
     {
+        /// True if Super is also a dispatcher
+        typedef std::integral_constant<
+            bool, has_basic_super<Super>::value> super_is_dispatcher;
+
         /// Helper struct which will typedef type to T::BasicSuper if T
         /// has such a type otherwise we typedef type to T itself.
         template<bool B, class T>
@@ -45,5 +70,77 @@ namespace fifi
         /// e.g. SIMD layers directly this allows us to forward calls
         /// to the optimized stack
         typedef region_dispatcher<Stack, Super> OptimizedSuper;
+
+    public:
+
+        /// Constructor, uses the backend given by default_region_backend()
+        region_dispatcher()
+        {
+            // The set_use_stack() of the specialization hides the one
+            // of a dispatcher in Super, which selects its own backend
+            this->set_use_stack(selects(default_region_backend()));
+        }
+
+        /// @param op The region operation
+        /// @return The backend computing the operation on buffers with a
+        ///         length which is a multiple of the granularity
+        region_backend backend(region_thresholds::operation op) const
+        {
+            if (this->uses_stack(op))
+            {
+                return Stack::backend;
+            }
+
+            return super_backend(op, super_is_dispatcher());
+        }
+
+        /// Forces the operations to be computed by the given backend
+        /// where it is supported by the stack and the CPU, the remaining
+        /// operations are computed by the basic backend. With the
+        /// automatic backend the fastest supported backend is used.
+        /// When dispatching at compile-time the backends are fixed and
+        /// only the basic backend can be forced @see
+        /// region_divide_granularity.
+        ///
+        /// @param backend The backend to use
+        void set_backend(region_backend backend)
+        {
+            this->set_use_stack(selects(backend));
+            set_super_backend(backend, super_is_dispatcher());
+        }
+
+    private:
+
+        /// @param backend The backend to use
+        /// @return True if the dispatch stack should be used
+        static bool selects(region_backend backend)
+        {
+            return backend == region_backend::automatic ||
+                backend == Stack::backend;
+        }
+
+        /// @return The backend of Super computing the operation
+        region_backend super_backend(region_thresholds::operation op,
+                                     std::true_type) const
+        {
+            return Super::backend(op);
+        }
+
+        /// @return The basic backend since Super is not a dispatcher
+        region_backend super_backend(region_thresholds::operation,
+                                     std::false_type) const
+        {
+            return region_backend::basic;
+        }
+
+        /// Forces the backend of Super
+        void set_super_backend(region_backend backend, std::true_type)
+        {
+            Super::set_backend(backend);
+        }
+
+        /// Does nothing since Super is not a dispatcher
+        void set_super_backend(region_backend, std::false_type)
+        { }
     };
 }
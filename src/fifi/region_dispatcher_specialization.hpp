@@ -8,7 +8,6 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
-#include <functional>
 #include <type_traits>
 
 #include "is_packed_constant.hpp"
@@ -19,6 +18,10 @@
 #include "has_region_multiply_constant.hpp"
 #include "has_region_multiply_add.hpp"
 #include "has_region_multiply_subtract.hpp"
+#include "has_region_linear_combination.hpp"
+#include "has_region_multiply_add_many.hpp"
+#include "has_region_operation.hpp"
+#include "region_thresholds.hpp"
 
 namespace fifi
 {
@@ -33,10 +36,31 @@ namespace fifi
     /// enabled when the fields match.
     template<class Field, class Stack, class StackField, class Super>
     class region_dispatcher_specialization : public Super
-    { };
+    {
+    public:
+
+        /// Has no effect since no operations are dispatched
+        void set_use_stack(bool)
+        { }
+
+        /// @return False since no operations are dispatched
+        bool uses_stack(region_thresholds::operation) const
+        {
+            return false;
+        }
+    };
 
     /// Specialization of the dispatcher which is enabled when the main
     /// stack and the dispatch stack have matching fields.
+    ///
+    /// The operations are called through a table of function pointers
+    /// which is resolved once, the first time a stack of the type is
+    /// created, and then shared by all stacks of the same type. The
+    /// functions are called with the dispatcher as argument, so a copy
+    /// of a stack calls its own embedded stack.
+    ///
+    /// A second table calling all operations on Super is used when the
+    /// embedded stack is not to be used, @see set_use_stack().
     template<class Field, class Stack, class Super>
     class region_dispatcher_specialization<Field, Stack, Field, Super> :
         public Super
@@ -52,88 +76,17 @@ namespace fifi
     public:
 
         /// Constructor
-        region_dispatcher_specialization()
-        {
-            bool enabled = m_stack.enabled();
-
-            // Region Add
-            if (enabled && has_region_add<Stack>::value)
-            {
-                bind_region_add(&m_stack);
-            }
-            else
-            {
-                bind_region_add((Super*)this);
-            }
-
-            // Region Subtract
-            if (enabled && has_region_subtract<Stack>::value)
-            {
-                bind_region_subtract(&m_stack);
-            }
-            else
-            {
-                bind_region_subtract((Super*)this);
-            }
-
-            // Region Multiply
-            if (enabled && has_region_multiply<Stack>::value)
-            {
-                bind_region_multiply(&m_stack);
-            }
-            else
-            {
-                bind_region_multiply((Super*)this);
-            }
-
-            // Region Divide
-            if (enabled && has_region_divide<Stack>::value)
-            {
-                bind_region_divide(&m_stack);
-            }
-            else
-            {
-                bind_region_divide((Super*)this);
-            }
-
-            // Region Multiply Constant
-            if (enabled && has_region_multiply_constant<Stack>::value)
-            {
-                bind_region_multiply_constant(&m_stack);
-            }
-            else
-            {
-                bind_region_multiply_constant((Super*)this);
-            }
-
-            // Region Multiply Add
-            if (enabled && has_region_multiply_add<Stack>::value)
-            {
-                bind_region_multiply_add(&m_stack);
-            }
-            else
-            {
-                bind_region_multiply_add((Super*)this);
-            }
-
-            // Region Multiply Subtract
-            if (enabled && has_region_multiply_subtract<Stack>::value)
-            {
-                bind_region_multiply_subtract(&m_stack);
-            }
-            else
-            {
-                bind_region_multiply_subtract((Super*)this);
-            }
-        }
+        region_dispatcher_specialization() :
+            m_table(&stack_table())
+        { }
 
         /// @copydoc layer::region_add(value_type*, const value_type*,
         ///                            uint32_t) const
         void region_add(value_type* dest, const value_type* src,
             uint32_t length) const
         {
-            assert(m_add);
-            m_add(dest, src, length);
+            assert(m_table->m_add);
+            m_table->m_add(*this, dest, src, length);
         }
 
         /// @copydoc layer::region_subtract(value_type*, const value_type*,
@@ -141,8 +94,8 @@ namespace fifi
         void region_subtract(value_type* dest, const value_type* src,
             uint32_t length) const
         {
-            assert(m_subtract);
-            m_subtract(dest, src, length);
+            assert(m_table->m_subtract);
+            m_table->m_subtract(*this, dest, src, length);
         }
 
         /// @copydoc layer::region_multiply(value_type*, const value_type*,
@@ -150,8 +103,8 @@ namespace fifi
         void region_multiply(value_type* dest, const value_type* src,
             uint32_t length) const
         {
-            assert(m_multiply);
-            m_multiply(dest, src, length);
+            assert(m_table->m_multiply);
+            m_table->m_multiply(*this, dest, src, length);
         }
 
         /// @copydoc layer::region_divide(value_type*, const value_type*,
@@ -159,43 +112,68 @@ namespace fifi
         void region_divide(value_type* dest, const value_type* src,
             uint32_t length) const
         {
-            assert(m_divide);
-            m_divide(dest, src, length);
+            assert(m_table->m_divide);
+            m_table->m_divide(*this, dest, src, length);
         }
 
         /// @copydoc layer::region_multiply_constant(value_type*, value_type,
         ///                                          uint32_t) const
-        void region_multiply_constant(
-            value_type* dest, value_type constant,
+        void region_multiply_constant(value_type* dest, value_type constant,
             uint32_t length) const
         {
-            assert(m_multiply_constant);
-            m_multiply_constant(dest, constant, length);
+            assert(m_table->m_multiply_constant);
+            m_table->m_multiply_constant(*this, dest, constant, length);
         }
 
         /// @copydoc layer::region_multiply_add(value_type*, const value_type*,
         ///                                     value_type, uint32_t) const
         void region_multiply_add(value_type* dest, const value_type* src,
-                          value_type constant, uint32_t length) const
+            value_type constant, uint32_t length) const
         {
-            assert(m_multiply_add);
-            m_multiply_add(dest, src, constant, length);
+            assert(m_table->m_multiply_add);
+            m_table->m_multiply_add(*this, dest, src, constant, length);
         }
 
         /// @copydoc layer::region_multiply_subtract(value_type*,
         ///                                          const value_type*,
         ///                                          value_type, uint32_t) const
         void region_multiply_subtract(value_type* dest, const value_type* src,
-                                value_type constant, uint32_t length) const
+            value_type constant, uint32_t length) const
+        {
+            assert(m_table->m_multiply_subtract);
+            m_table->m_multiply_subtract(*this, dest, src, constant, length);
+        }
+
+        /// @copydoc layer::region_linear_combination(value_type*,
+        ///                                           const value_type* const*,
+        ///                                           const value_type*,
+        ///                                           uint32_t, uint32_t) const
+        void region_linear_combination(value_type* dest,
+            const value_type* const* srcs, const value_type* constants,
+            uint32_t count, uint32_t length) const
         {
-            assert(m_multiply_subtract);
-            m_multiply_subtract(dest, src, constant, length);
+            assert(m_table->m_linear_combination);
+            m_table->m_linear_combination(
+                *this, dest, srcs, constants, count, length);
+        }
+
+        /// @copydoc layer::region_multiply_add_many(value_type* const*,
+        ///                                          const value_type*,
+        ///                                          const value_type*,
+        ///                                          uint32_t, uint32_t) const
+        void region_multiply_add_many(value_type* const* dests,
+            const value_type* src, const value_type* constants,
+            uint32_t count, uint32_t length) const
+        {
+            assert(m_table->m_multiply_add_many);
+            m_table->m_multiply_add_many(
+                *this, dests, src, constants, count, length);
         }
 
         /// @copydoc layer::alignment() const
         uint32_t alignment() const
         {
-            if (m_stack.enabled())
+            if (m_table->m_use_stack)
             {
                 return std::max(m_stack.alignment(), Super::alignment());
             }
@@ -208,7 +186,7 @@ namespace fifi
         /// @copydoc layer::max_alignment() const
         uint32_t max_alignment() const
         {
-            if (m_stack.enabled())
+            if (m_table->m_use_stack)
             {
                 return std::max(m_stack.max_alignment(),
                                 Super::max_alignment());
@@ -222,7 +200,7 @@ namespace fifi
         /// @copydoc layer::granularity() const
         uint32_t granularity() const
         {
-            if (m_stack.enabled())
+            if (m_table->m_use_stack)
             {
                 return std::max(m_stack.granularity(), Super::granularity());
             }
@@ -235,7 +213,7 @@ namespace fifi
         /// @copydoc layer::max_granularity() const
         uint32_t max_granularity() const
         {
-            if (m_stack.enabled())
+            if (m_table->m_use_stack)
             {
                 return std::max(m_stack.max_granularity(),
                                 Super::max_granularity());
@@ -253,256 +231,532 @@ namespace fifi
             return m_stack.enabled();
         }
 
+        /// Selects whether the operations supported by the embedded stack
+        /// are dispatched to it, provided that it is enabled, or whether
+        /// all operations are called on Super. By default the embedded
+        /// stack is used.
+        ///
+        /// @param use_stack True if the embedded stack should be used
+        void set_use_stack(bool use_stack)
+        {
+            m_table = use_stack ? &stack_table() : &super_table();
+        }
+
+        /// @param op The region operation
+        /// @return True if the operation is dispatched to the embedded
+        ///         stack, otherwise it is called on Super
+        bool uses_stack(region_thresholds::operation op) const
+        {
+            return m_table->m_use_stack && has_region_operation<Stack>(op);
+        }
+
+    protected:
+
+        typedef void (*ptr_ptr_function)(
+            const region_dispatcher_specialization&, value_type*,
+            const value_type*, uint32_t);
+
+        typedef void (*ptr_const_function)(
+            const region_dispatcher_specialization&, value_type*,
+            value_type, uint32_t);
+
+        typedef void (*ptr_ptr_const_function)(
+            const region_dispatcher_specialization&, value_type*,
+            const value_type*, value_type, uint32_t);
+
+        typedef void (*linear_combination_function)(
+            const region_dispatcher_specialization&, value_type*,
+            const value_type* const*, const value_type*, uint32_t, uint32_t);
+
+        typedef void (*multiply_add_many_function)(
+            const region_dispatcher_specialization&, value_type* const*,
+            const value_type*, const value_type*, uint32_t, uint32_t);
+
+        /// The functions to invoke for the operations. A function is
+        /// null if neither the dispatch stack nor Super supports the
+        /// operation.
+        struct dispatch_table
+        {
+            /// True if the operations supported by the embedded stack
+            /// are dispatched to it
+            bool m_use_stack;
+
+            /// The function to invoke when calling region_add
+            ptr_ptr_function m_add;
+
+            /// The function to invoke when calling region_subtract
+            ptr_ptr_function m_subtract;
+
+            /// The function to invoke when calling region_multiply
+            ptr_ptr_function m_multiply;
+
+            /// The function to invoke when calling region_divide
+            ptr_ptr_function m_divide;
+
+            /// The function to invoke when calling region_multiply_constant
+            ptr_const_function m_multiply_constant;
+
+            /// The function to invoke when calling region_multiply_add
+            ptr_ptr_const_function m_multiply_add;
+
+            /// The function to invoke when calling region_multiply_subtract
+            ptr_ptr_const_function m_multiply_subtract;
+
+            /// The function to invoke when calling region_linear_combination
+            linear_combination_function m_linear_combination;
+
+            /// The function to invoke when calling region_multiply_add_many
+            multiply_add_many_function m_multiply_add_many;
+        };
+
     private:
 
-        /// Helper function for binding to the chosen
-        /// layer::region_add(value_type*, const value_type*,
-        /// uint32_t). The function uses SFINA to only bind if the
-        /// chosen stack supports the operation.
+        /// @return The dispatch table shared by all stacks of this type
+        ///         which use the embedded stack if it is enabled. The
+        ///         table is resolved the first time it is requested,
+        ///         C++11 guarantees that this is thread-safe.
+        static const dispatch_table& stack_table()
+        {
+            static const dispatch_table table = resolve_table(
+                Stack().enabled());
+            return table;
+        }
+
+        /// @return The dispatch table shared by all stacks of this type
+        ///         which calls all operations on Super
+        static const dispatch_table& super_table()
+        {
+            static const dispatch_table table = resolve_table(false);
+            return table;
+        }
+
+        /// Chooses the functions of the dispatch table. The operations
+        /// are dispatched to the embedded stack if it is enabled and
+        /// supports the operation, otherwise to Super.
         ///
-        /// @param stack Pointer to the stack where the operation
-        /// should be bound
+        /// @param enabled True if the embedded stack should be used
+        /// @return The resolved dispatch table
+        static dispatch_table resolve_table(bool enabled)
+        {
+            dispatch_table table = dispatch_table();
+            table.m_use_stack = enabled;
+
+            // Region Add
+            if (enabled && has_region_add<Stack>::value)
+            {
+                table.m_add = region_add_function<Stack>();
+            }
+            else
+            {
+                table.m_add = region_add_function<Super>();
+            }
+
+            // Region Subtract
+            if (enabled && has_region_subtract<Stack>::value)
+            {
+                table.m_subtract = region_subtract_function<Stack>();
+            }
+            else
+            {
+                table.m_subtract = region_subtract_function<Super>();
+            }
+
+            // Region Multiply
+            if (enabled && has_region_multiply<Stack>::value)
+            {
+                table.m_multiply = region_multiply_function<Stack>();
+            }
+            else
+            {
+                table.m_multiply = region_multiply_function<Super>();
+            }
+
+            // Region Divide
+            if (enabled && has_region_divide<Stack>::value)
+            {
+                table.m_divide = region_divide_function<Stack>();
+            }
+            else
+            {
+                table.m_divide = region_divide_function<Super>();
+            }
+
+            // Region Multiply Constant
+            if (enabled && has_region_multiply_constant<Stack>::value)
+            {
+                table.m_multiply_constant =
+                    region_multiply_constant_function<Stack>();
+            }
+            else
+            {
+                table.m_multiply_constant =
+                    region_multiply_constant_function<Super>();
+            }
+
+            // Region Multiply Add
+            if (enabled && has_region_multiply_add<Stack>::value)
+            {
+                table.m_multiply_add = region_multiply_add_function<Stack>();
+            }
+            else
+            {
+                table.m_multiply_add = region_multiply_add_function<Super>();
+            }
+
+            // Region Multiply Subtract
+            if (enabled && has_region_multiply_subtract<Stack>::value)
+            {
+                table.m_multiply_subtract =
+                    region_multiply_subtract_function<Stack>();
+            }
+            else
+            {
+                table.m_multiply_subtract =
+                    region_multiply_subtract_function<Super>();
+            }
+
+            // Region Linear Combination
+            if (enabled && has_region_linear_combination<Stack>::value)
+            {
+                table.m_linear_combination =
+                    region_linear_combination_function<Stack>();
+            }
+            else if (has_region_linear_combination<Super>::value)
+            {
+                // Not all stacks provide this operation so we only
+                // use the fall through if it is available
+                table.m_linear_combination =
+                    region_linear_combination_function<Super>();
+            }
+
+            // Region Multiply Add Many
+            if (enabled && has_region_multiply_add_many<Stack>::value)
+            {
+                table.m_multiply_add_many =
+                    region_multiply_add_many_function<Stack>();
+            }
+            else if (has_region_multiply_add_many<Super>::value)
+            {
+                // @see region linear combination above
+                table.m_multiply_add_many =
+                    region_multiply_add_many_function<Super>();
+            }
+
+            return table;
+        }
+
+        /// @return The embedded stack
+        const Stack& layer(const Stack*) const
+        {
+            return m_stack;
+        }
+
+        /// @return This dispatcher as Super
+        const Super& layer(const Super*) const
+        {
+            return *this;
+        }
+
+        /// Helper function returning a function which calls
+        /// layer::region_add(value_type*, const value_type*, uint32_t) on
+        /// the layer T of the dispatcher. The function uses SFINAE to
+        /// only be instantiated if T supports the operation.
+        ///
+        /// @return The function calling the operation on T
         template
         <
             class T,
             typename std::enable_if<
                 has_region_add<T>::value, uint8_t>::type = 0
         >
-        void bind_region_add(const T* stack)
+        static ptr_ptr_function region_add_function()
         {
-            namespace sp = std::placeholders;
-            m_add = std::bind(&T::region_add, stack, sp::_1, sp::_2, sp::_3);
+            return [](const region_dispatcher_specialization& dispatcher,
+                value_type* dest, const value_type* src, uint32_t length)
+            {
+                dispatcher.layer((const T*) 0).region_add(dest, src, length);
+            };
         }
 
-        /// Helper function called if the chosen stack does not
-        /// support the desired operation. In this case, this function
-        /// will be instantiated ensuring that the code will
-        /// compile. To avoid asserting the calling code should use
-        /// the has_region_add<T>::value helper
+        /// Helper function called if T does not support the desired
+        /// operation. In this case, this function will be instantiated
+        /// ensuring that the code will compile. To avoid asserting the
+        /// calling code should use the has_region_add<T>::value helper
         ///
-        /// @param stack Pointer to the stack where the operation
-        /// should be bound
+        /// @return A null function
         template
         <
             class T,
             typename std::enable_if<
                 !has_region_add<T>::value, uint16_t>::type = 0
         >
-        void bind_region_add(const T* stack)
+        static ptr_ptr_function region_add_function()
         {
             // We do the assert here - to make sure that this call is
             // not silently ignored in cases where the stack does not
-            // have the layer::region_add(value_type*, const
-            // value_type*, uint32_t) function. However, this assert
-            // can be avoided by using the has_region_add helper.
-            (void) stack;
+            // have the operation. However, this assert can be avoided
+            // by using the has_region_add helper.
             assert(0);
+            return 0;
         }
 
-        /// @copydoc bind_region_add(const T*)
+        /// @copydoc region_add_function()
         template
         <
             class T,
             typename std::enable_if<
                 has_region_subtract<T>::value, uint8_t>::type = 0
         >
-        void bind_region_subtract(const T* stack)
+        static ptr_ptr_function region_subtract_function()
         {
-            namespace sp = std::placeholders;
-            m_subtract = std::bind(
-                &T::region_subtract, stack, sp::_1, sp::_2, sp::_3);
+            return [](const region_dispatcher_specialization& dispatcher,
+                value_type* dest, const value_type* src, uint32_t length)
+            {
+                dispatcher.layer((const T*) 0).region_subtract(
+                    dest, src, length);
+            };
         }
 
-        /// @copydoc bind_region_add(const T*)
+        /// @copydoc region_add_function()
         template
         <
             class T,
             typename std::enable_if<
                 !has_region_subtract<T>::value, uint16_t>::type = 0
         >
-        void bind_region_subtract(const T* stack)
+        static ptr_ptr_function region_subtract_function()
         {
-            // @see bind_region_add(T*)
-            (void) stack;
+            // @see region_add_function()
             assert(0);
+            return 0;
         }
 
-        /// @copydoc bind_region_add(const T*)
+        /// @copydoc region_add_function()
         template
         <
             class T,
             typename std::enable_if<
                 has_region_multiply<T>::value, uint8_t>::type = 0
         >
-        void bind_region_multiply(const T* stack)
+        static ptr_ptr_function region_multiply_function()
         {
-            namespace sp = std::placeholders;
-            m_multiply = std::bind(
-                &T::region_multiply, stack, sp::_1, sp::_2, sp::_3);
+            return [](const region_dispatcher_specialization& dispatcher,
+                value_type* dest, const value_type* src, uint32_t length)
+            {
+                dispatcher.layer((const T*) 0).region_multiply(
+                    dest, src, length);
+            };
         }
 
-        /// @copydoc bind_region_add(const T*)
+        /// @copydoc region_add_function()
         template
         <
             class T,
             typename std::enable_if<
                 !has_region_multiply<T>::value, uint16_t>::type = 0
         >
-        void bind_region_multiply(const T* stack)
+        static ptr_ptr_function region_multiply_function()
         {
-            // @see bind_region_add(T*)
-            (void) stack;
+            // @see region_add_function()
             assert(0);
+            return 0;
         }
 
-        /// @copydoc bind_region_add(const T*)
+        /// @copydoc region_add_function()
         template
         <
             class T,
             typename std::enable_if<
                 has_region_divide<T>::value, uint8_t>::type = 0
         >
-        void bind_region_divide(const T* stack)
+        static ptr_ptr_function region_divide_function()
         {
-            namespace sp = std::placeholders;
-            m_divide = std::bind(
-                &T::region_divide, stack, sp::_1, sp::_2, sp::_3);
+            return [](const region_dispatcher_specialization& dispatcher,
+                value_type* dest, const value_type* src, uint32_t length)
+            {
+                dispatcher.layer((const T*) 0).region_divide(dest, src, length);
+            };
         }
 
-        /// @copydoc bind_region_add(const T*)
+        /// @copydoc region_add_function()
         template
         <
             class T,
             typename std::enable_if<
                 !has_region_divide<T>::value, uint16_t>::type = 0
         >
-        void bind_region_divide(const T* stack)
+        static ptr_ptr_function region_divide_function()
         {
-            // @see bind_region_add(T*)
-            (void) stack;
+            // @see region_add_function()
             assert(0);
+            return 0;
         }
 
-        /// @copydoc bind_region_add(const T*)
+        /// @copydoc region_add_function()
         template
         <
             class T,
             typename std::enable_if<
                 has_region_multiply_constant<T>::value, uint8_t>::type = 0
         >
-        void bind_region_multiply_constant(const T* stack)
+        static ptr_const_function region_multiply_constant_function()
         {
-            namespace sp = std::placeholders;
-            m_multiply_constant = std::bind(
-                &T::region_multiply_constant, stack, sp::_1, sp::_2, sp::_3);
+            return [](const region_dispatcher_specialization& dispatcher,
+                value_type* dest, value_type constant, uint32_t length)
+            {
+                dispatcher.layer((const T*) 0).region_multiply_constant(
+                    dest, constant, length);
+            };
         }
 
-        /// @copydoc bind_region_add(const T*)
+        /// @copydoc region_add_function()
         template
         <
             class T,
             typename std::enable_if<
                 !has_region_multiply_constant<T>::value, uint16_t>::type = 0
         >
-        void bind_region_multiply_constant(const T* stack)
+        static ptr_const_function region_multiply_constant_function()
         {
-            // @see bind_region_add(T*)
-            (void) stack;
+            // @see region_add_function()
             assert(0);
+            return 0;
         }
 
-        /// @copydoc bind_region_add(const T*)
+        /// @copydoc region_add_function()
         template
         <
             class T,
             typename std::enable_if<
                 has_region_multiply_add<T>::value, uint8_t>::type = 0
         >
-        void bind_region_multiply_add(const T* stack)
+        static ptr_ptr_const_function region_multiply_add_function()
         {
-            namespace sp = std::placeholders;
-            m_multiply_add = std::bind(
-                &T::region_multiply_add, stack, sp::_1, sp::_2, sp::_3, sp::_4);
+            return [](const region_dispatcher_specialization& dispatcher,
+                value_type* dest, const value_type* src, value_type constant,
+                uint32_t length)
+            {
+                dispatcher.layer((const T*) 0).region_multiply_add(
+                    dest, src, constant, length);
+            };
         }
 
-        /// @copydoc bind_region_add(const T*)
+        /// @copydoc region_add_function()
         template
         <
             class T,
             typename std::enable_if<
                 !has_region_multiply_add<T>::value, uint16_t>::type = 0
         >
-        void bind_region_multiply_add(const T* stack)
+        static ptr_ptr_const_function region_multiply_add_function()
         {
-            // @see bind_region_add(T*)
-            (void) stack;
+            // @see region_add_function()
             assert(0);
+            return 0;
         }
 
-        /// @copydoc bind_region_add(const T*)
+        /// @copydoc region_add_function()
         template
         <
             class T,
             typename std::enable_if<
                 has_region_multiply_subtract<T>::value, uint8_t>::type = 0
         >
-        void bind_region_multiply_subtract(const T* stack)
+        static ptr_ptr_const_function region_multiply_subtract_function()
         {
-            namespace sp = std::placeholders;
-            m_multiply_subtract = std::bind(&T::region_multiply_subtract,
-                stack, sp::_1, sp::_2, sp::_3, sp::_4);
+            return [](const region_dispatcher_specialization& dispatcher,
+                value_type* dest, const value_type* src, value_type constant,
+                uint32_t length)
+            {
+                dispatcher.layer((const T*) 0).region_multiply_subtract(
+                    dest, src, constant, length);
+            };
         }
 
-        /// @copydoc bind_region_add(const T*)
+        /// @copydoc region_add_function()
         template
         <
             class T,
             typename std::enable_if<
                 !has_region_multiply_subtract<T>::value, uint16_t>::type = 0
         >
-        void bind_region_multiply_subtract(const T* stack)
+        static ptr_ptr_const_function region_multiply_subtract_function()
         {
-            // @see bind_region_add(T*)
-            (void) stack;
+            // @see region_add_function()
             assert(0);
+            return 0;
         }
 
-    protected:
+        /// @copydoc region_add_function()
+        template
+        <
+            class T,
+            typename std::enable_if<
+                has_region_linear_combination<T>::value, uint8_t>::type = 0
+        >
+        static linear_combination_function region_linear_combination_function()
+        {
+            return [](const region_dispatcher_specialization& dispatcher,
+                value_type* dest, const value_type* const* srcs,
+                const value_type* constants, uint32_t count, uint32_t length)
+            {
+                dispatcher.layer((const T*) 0).region_linear_combination(
+                    dest, srcs, constants, count, length);
+            };
+        }
 
-        typedef std::function<void (value_type*, const value_type*, uint32_t)>
-            ptr_ptr_function;
+        /// @copydoc region_add_function()
+        template
+        <
+            class T,
+            typename std::enable_if<
+                !has_region_linear_combination<T>::value, uint16_t>::type = 0
+        >
+        static linear_combination_function region_linear_combination_function()
+        {
+            // @see region_add_function()
+            assert(0);
+            return 0;
+        }
 
-        typedef std::function<void (value_type*, value_type, uint32_t)>
-            ptr_const_function;
+        /// @copydoc region_add_function()
+        template
+        <
+            class T,
+            typename std::enable_if<
+                has_region_multiply_add_many<T>::value, uint8_t>::type = 0
+        >
+        static multiply_add_many_function region_multiply_add_many_function()
+        {
+            return [](const region_dispatcher_specialization& dispatcher,
+                value_type* const* dests, const value_type* src,
+                const value_type* constants, uint32_t count, uint32_t length)
+            {
+                dispatcher.layer((const T*) 0).region_multiply_add_many(
+                    dests, src, constants, count, length);
+            };
+        }
 
-        typedef std::function<
-            void (value_type*, const value_type*, value_type, uint32_t)>
-            ptr_ptr_const_function;
+        /// @copydoc region_add_function()
+        template
+        <
+            class T,
+            typename std::enable_if<
+                !has_region_multiply_add_many<T>::value, uint16_t>::type = 0
+        >
+        static multiply_add_many_function region_multiply_add_many_function()
+        {
+            // @see region_add_function()
+            assert(0);
+            return 0;
+        }
 
     private:
 
+        /// The dispatch table in use, either the stack or the super table
+        const dispatch_table* m_table;
+
         /// The stack to use for dispatching
         Stack m_stack;
-
-        /// Store the function to invoke when calling region_add
-        ptr_ptr_function m_add;
-
-        /// Store the function to invoke when calling region_subtract
-        ptr_ptr_function m_subtract;
-
-        /// Store the function to invoke when calling region_multiply
-        ptr_ptr_function m_multiply;
-
-        /// Store the function to invoke when calling region_divide
-        ptr_ptr_function m_divide;
-
-        /// Store the function to invoke when calling region_multiply_constant
-        ptr_const_function m_multiply_constant;
-
-        /// Store the function to invoke when calling region_multiply_add
-        ptr_ptr_const_function m_multiply_add;
-
-        /// Store the function to invoke when calling region_multiply_subtract
-        ptr_ptr_const_function m_multiply_subtract;
     };
 }
@@ -5,15 +5,28 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 
+#include "region_backend.hpp"
+#include "region_thresholds.hpp"
+
 namespace fifi
 {
     /// This is a convenience layer for region arithmetics which guarantees
     /// that the optimized operations are only called on buffer fragments
     /// which have the required granularity, i.e. their length is a multiple
     /// of the granularity.
+    ///
+    /// Optionally a length threshold can be set per operation, @see
+    /// region_thresholds. Calls with a length below the threshold are
+    /// computed by the basic layers only, which can be faster than the
+    /// optimized layers for short buffers on some CPUs. By default all
+    /// thresholds are zero.
+    ///
+    /// The layer also allows forcing the basic backend, in which case
+    /// all calls are computed by the basic layers @see set_backend().
     template<class Super>
     class region_divide_granularity : public Super
     {
@@ -33,7 +46,8 @@ namespace fifi
 
     public:
 
-        region_divide_granularity()
+        region_divide_granularity() :
+            m_basic(default_region_backend() == region_backend::basic)
         {
             // The basic granularity needs to be one, i.e., without requirements
             assert(BasicSuper::granularity() == 1U);
@@ -43,6 +57,48 @@ namespace fifi
                    (OptimizedSuper::granularity() - 1)) == 0);
         }
 
+        /// Sets the thresholds below which the operations are computed
+        /// by the basic layers only e.g. as found by
+        /// calibrate_region_thresholds()
+        ///
+        /// @param thresholds The thresholds to use
+        void set_thresholds(const region_thresholds& thresholds)
+        {
+            m_thresholds = thresholds;
+        }
+
+        /// @return The thresholds below which the operations are computed
+        ///         by the basic layers only
+        const region_thresholds& thresholds() const
+        {
+            return m_thresholds;
+        }
+
+        /// @param op The region operation
+        /// @return The backend computing the operation on buffers of at
+        ///         least the threshold length @see region_backend
+        region_backend backend(region_thresholds::operation op) const
+        {
+            if (m_basic)
+            {
+                return region_backend::basic;
+            }
+
+            return Super::backend(op);
+        }
+
+        /// Forces the operations to be computed by the given backend
+        /// @see region_dispatcher::set_backend(). The basic backend is
+        /// handled by this layer, so it can also be forced when the
+        /// dispatch is done at compile-time.
+        ///
+        /// @param backend The backend to use
+        void set_backend(region_backend backend)
+        {
+            m_basic = backend == region_backend::basic;
+            Super::set_backend(backend);
+        }
+
         /// @copydoc layer::region_add(value_type*, const value_type*,
         ///                            uint32_t) const
         void region_add(value_type* dest, const value_type* src,
@@ -51,6 +107,12 @@ namespace fifi
             assert(dest != 0);
             assert(src  != 0);
 
+            if (m_basic || length < m_thresholds[region_thresholds::region_add])
+            {
+                BasicSuper::region_add(dest, src, length);
+                return;
+            }
+
             uint32_t optimized, tail;
             split_length(length, &optimized, &tail);
 
@@ -73,6 +135,13 @@ namespace fifi
             assert(dest != 0);
             assert(src  != 0);
 
+            if (m_basic || length <
+                m_thresholds[region_thresholds::region_subtract])
+            {
+                BasicSuper::region_subtract(dest, src, length);
+                return;
+            }
+
             uint32_t optimized, tail;
             split_length(length, &optimized, &tail);
 
@@ -96,6 +165,13 @@ namespace fifi
             assert(dest != 0);
             assert(src  != 0);
 
+            if (m_basic || length <
+                m_thresholds[region_thresholds::region_multiply])
+            {
+                BasicSuper::region_multiply(dest, src, length);
+                return;
+            }
+
             uint32_t optimized, tail;
             split_length(length, &optimized, &tail);
 
@@ -119,6 +195,13 @@ namespace fifi
             assert(dest != 0);
             assert(src  != 0);
 
+            if (m_basic || length <
+                m_thresholds[region_thresholds::region_divide])
+            {
+                BasicSuper::region_divide(dest, src, length);
+                return;
+            }
+
             uint32_t optimized, tail;
             split_length(length, &optimized, &tail);
 
@@ -141,6 +224,14 @@ namespace fifi
         {
             assert(dest != 0);
 
+            if (m_basic || length <
+                m_thresholds[region_thresholds::region_multiply_constant])
+            {
+                BasicSuper::region_multiply_constant(
+                    dest, constant, length);
+                return;
+            }
+
             uint32_t optimized, tail;
             split_length(length, &optimized, &tail);
 
@@ -164,6 +255,14 @@ namespace fifi
             assert(dest != 0);
             assert(src  != 0);
 
+            if (m_basic || length <
+                m_thresholds[region_thresholds::region_multiply_add])
+            {
+                BasicSuper::region_multiply_add(
+                    dest, src, constant, length);
+                return;
+            }
+
             uint32_t optimized, tail;
             split_length(length, &optimized, &tail);
 
@@ -189,6 +288,14 @@ namespace fifi
             assert(dest != 0);
             assert(src  != 0);
 
+            if (m_basic || length <
+                m_thresholds[region_thresholds::region_multiply_subtract])
+            {
+                BasicSuper::region_multiply_subtract(
+                    dest, src, constant, length);
+                return;
+            }
+
             uint32_t optimized, tail;
             split_length(length, &optimized, &tail);
 
@@ -204,6 +311,92 @@ namespace fifi
             }
         }
 
+        /// @copydoc layer::region_linear_combination(value_type*,
+        ///                                           const value_type* const*,
+        ///                                           const value_type*,
+        ///                                           uint32_t, uint32_t) const
+        void region_linear_combination(value_type* dest,
+            const value_type* const* srcs, const value_type* constants,
+            uint32_t count, uint32_t length) const
+        {
+            assert(dest != 0);
+            assert(srcs != 0);
+            assert(constants != 0);
+            assert(count > 0);
+
+            if (m_basic || length <
+                m_thresholds[region_thresholds::region_linear_combination])
+            {
+                BasicSuper::region_linear_combination(
+                    dest, srcs, constants, count, length);
+                return;
+            }
+
+            uint32_t optimized, tail;
+            split_length(length, &optimized, &tail);
+
+            if (optimized > 0)
+            {
+                Super::region_linear_combination(
+                    dest, srcs, constants, count, optimized);
+            }
+
+            if (tail > 0)
+            {
+                // The tail is computed source by source to avoid
+                // building an array of offset source pointers
+                std::fill_n(dest + optimized, tail, 0);
+
+                for (uint32_t j = 0; j < count; ++j)
+                {
+                    BasicSuper::region_multiply_add(dest + optimized,
+                        srcs[j] + optimized, constants[j], tail);
+                }
+            }
+        }
+
+        /// @copydoc layer::region_multiply_add_many(value_type* const*,
+        ///                                          const value_type*,
+        ///                                          const value_type*,
+        ///                                          uint32_t, uint32_t) const
+        void region_multiply_add_many(value_type* const* dests,
+            const value_type* src, const value_type* constants,
+            uint32_t count, uint32_t length) const
+        {
+            assert(dests != 0);
+            assert(src != 0);
+            assert(constants != 0);
+            assert(count > 0);
+
+            if (m_basic || length <
+                m_thresholds[region_thresholds::region_multiply_add_many])
+            {
+                BasicSuper::region_multiply_add_many(
+                    dests, src, constants, count, length);
+                return;
+            }
+
+            uint32_t optimized, tail;
+            split_length(length, &optimized, &tail);
+
+            if (optimized > 0)
+            {
+                Super::region_multiply_add_many(
+                    dests, src, constants, count, optimized);
+            }
+
+            if (tail > 0)
+            {
+                // The tail is computed destination by destination to
+                // avoid building an array of offset destination pointers
+                for (uint32_t j = 0; j < count; ++j)
+                {
+                    BasicSuper::region_multiply_add(dests[j] + optimized,
+                        src + optimized, constants[j], tail);
+                }
+            }
+        }
+
     protected:
 
         /// Given a specific length, this function splits the buffer to
@@ -236,5 +429,14 @@ namespace fifi
             *optimized = length & ~mask;
             *tail = length & mask;
         }
+
+    private:
+
+        /// The thresholds below which the operations are computed by the
+        /// basic layers only
+        region_thresholds m_thresholds;
+
+        /// True if all operations are computed by the basic layers
+        bool m_basic;
     };
 }
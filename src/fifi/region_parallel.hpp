@@ -0,0 +1,325 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "fifi_utils.hpp"
+#include "thread_pool.hpp"
+
+namespace fifi
+{
+    /// The default size in bytes of the chunks computed by each thread
+    /// of a region_parallel stack. A destination and a source chunk fit
+    /// in the per-core L2 cache of most CPUs.
+    const uint32_t region_parallel_chunk_size = 65536;
+
+    /// The default size in bytes of the shortest buffers computed in
+    /// parallel by a region_parallel stack
+    const uint32_t region_parallel_threshold_size = 262144;
+
+    /// This layer computes the region operations of very large buffers
+    /// in parallel using a thread pool. The buffers are split into
+    /// chunks which are a multiple of the granularity of the stack, so
+    /// only the last chunk has a tail for the basic layers. The chunks
+    /// are computed by the threads of the pool and the calling thread.
+    ///
+    /// Calls with a length below the parallel threshold, and all calls
+    /// when no thread pool is set, are computed on the calling thread.
+    /// The layer is placed on top of a complete stack, e.g.:
+    ///
+    /// fifi::region_parallel<fifi::full_table<fifi::binary8>> field;
+    /// field.set_pool(std::make_shared<fifi::thread_pool>(4));
+    ///
+    /// Copies of the stack share the thread pool. The calls of stacks
+    /// sharing a pool are computed one at a time @see thread_pool.
+    template<class Super>
+    class region_parallel : public Super
+    {
+    public:
+
+        /// The field type
+        typedef typename Super::field_type field_type;
+
+        /// Typedef of the data type used for each field element
+        typedef typename Super::value_type value_type;
+
+    public:
+
+        region_parallel() :
+            m_chunk_length(std::max(
+                size_to_length<field_type>(region_parallel_chunk_size), 1U)),
+            m_threshold(
+                size_to_length<field_type>(region_parallel_threshold_size))
+        { }
+
+        /// @param pool The thread pool computing the chunks, or an empty
+        ///        pointer to compute all calls on the calling thread
+        void set_pool(const std::shared_ptr<thread_pool>& pool)
+        {
+            m_pool = pool;
+        }
+
+        /// @return The thread pool computing the chunks, empty if no
+        ///         pool is set
+        const std::shared_ptr<thread_pool>& pool() const
+        {
+            return m_pool;
+        }
+
+        /// @param length The length in value_type elements below which
+        ///        calls are computed on the calling thread
+        void set_parallel_threshold(uint32_t length)
+        {
+            m_threshold = length;
+        }
+
+        /// @return The length in value_type elements below which calls
+        ///         are computed on the calling thread
+        uint32_t parallel_threshold() const
+        {
+            return m_threshold;
+        }
+
+        /// @param length The length in value_type elements of the chunks,
+        ///        it is rounded down to a multiple of the granularity
+        void set_chunk_length(uint32_t length)
+        {
+            assert(length > 0);
+            m_chunk_length = length;
+        }
+
+        /// @return The length in value_type elements of the chunks
+        ///         computed by each thread, a multiple of the granularity
+        uint32_t chunk_length() const
+        {
+            uint32_t granularity = Super::granularity();
+            assert(granularity > 0);
+
+            return std::max(m_chunk_length / granularity, 1U) * granularity;
+        }
+
+        /// @copydoc layer::region_add(value_type*, const value_type*,
+        ///                            uint32_t) const
+        void region_add(value_type* dest, const value_type* src,
+            uint32_t length) const
+        {
+            assert(dest != 0);
+            assert(src  != 0);
+
+            run(length, [&](uint32_t offset, uint32_t chunk)
+            {
+                Super::region_add(dest + offset, src + offset, chunk);
+            });
+        }
+
+        /// @copydoc layer::region_subtract(value_type*, const value_type*,
+        ///                                 uint32_t) const
+        void region_subtract(value_type* dest, const value_type* src,
+            uint32_t length) const
+        {
+            assert(dest != 0);
+            assert(src  != 0);
+
+            run(length, [&](uint32_t offset, uint32_t chunk)
+            {
+                Super::region_subtract(dest + offset, src + offset, chunk);
+            });
+        }
+
+        /// @copydoc layer::region_multiply(value_type*, const value_type*,
+        ///                                 uint32_t) const
+        void region_multiply(value_type* dest, const value_type* src,
+            uint32_t length) const
+        {
+            assert(dest != 0);
+            assert(src  != 0);
+
+            run(length, [&](uint32_t offset, uint32_t chunk)
+            {
+                Super::region_multiply(dest + offset, src + offset, chunk);
+            });
+        }
+
+        /// @copydoc layer::region_divide(value_type*, const value_type*,
+        ///                               uint32_t) const
+        void region_divide(value_type* dest, const value_type* src,
+            uint32_t length) const
+        {
+            assert(dest != 0);
+            assert(src  != 0);
+
+            run(length, [&](uint32_t offset, uint32_t chunk)
+            {
+                Super::region_divide(dest + offset, src + offset, chunk);
+            });
+        }
+
+        /// @copydoc layer::region_multiply_constant(value_type*, value_type,
+        ///                                          uint32_t) const
+        void region_multiply_constant(value_type* dest, value_type constant,
+            uint32_t length) const
+        {
+            assert(dest != 0);
+
+            run(length, [&](uint32_t offset, uint32_t chunk)
+            {
+                Super::region_multiply_constant(
+                    dest + offset, constant, chunk);
+            });
+        }
+
+        /// @copydoc layer::region_multiply_add(value_type*, const value_type*,
+        ///                                     value_type, uint32_t) const
+        void region_multiply_add(value_type* dest, const value_type* src,
+            value_type constant, uint32_t length) const
+        {
+            assert(dest != 0);
+            assert(src  != 0);
+
+            run(length, [&](uint32_t offset, uint32_t chunk)
+            {
+                Super::region_multiply_add(
+                    dest + offset, src + offset, constant, chunk);
+            });
+        }
+
+        /// @copydoc layer::region_multiply_subtract(value_type*,
+        ///                                          const value_type*,
+        ///                                          value_type,
+        ///                                          uint32_t) const
+        void region_multiply_subtract(value_type* dest, const value_type* src,
+            value_type constant, uint32_t length) const
+        {
+            assert(dest != 0);
+            assert(src  != 0);
+
+            run(length, [&](uint32_t offset, uint32_t chunk)
+            {
+                Super::region_multiply_subtract(
+                    dest + offset, src + offset, constant, chunk);
+            });
+        }
+
+        /// @copydoc layer::region_linear_combination(value_type*,
+        ///                                           const value_type* const*,
+        ///                                           const value_type*,
+        ///                                           uint32_t, uint32_t) const
+        void region_linear_combination(value_type* dest,
+            const value_type* const* srcs, const value_type* constants,
+            uint32_t count, uint32_t length) const
+        {
+            assert(dest != 0);
+            assert(srcs != 0);
+            assert(constants != 0);
+            assert(count > 0);
+
+            if (!is_parallel(length))
+            {
+                Super::region_linear_combination(
+                    dest, srcs, constants, count, length);
+                return;
+            }
+
+            run(length, [&](uint32_t offset, uint32_t chunk)
+            {
+                std::vector<const value_type*> chunk_srcs(count);
+                for (uint32_t j = 0; j < count; ++j)
+                {
+                    chunk_srcs[j] = srcs[j] + offset;
+                }
+
+                Super::region_linear_combination(dest + offset,
+                    chunk_srcs.data(), constants, count, chunk);
+            });
+        }
+
+        /// @copydoc layer::region_multiply_add_many(value_type* const*,
+        ///                                          const value_type*,
+        ///                                          const value_type*,
+        ///                                          uint32_t, uint32_t) const
+        void region_multiply_add_many(value_type* const* dests,
+            const value_type* src, const value_type* constants,
+            uint32_t count, uint32_t length) const
+        {
+            assert(dests != 0);
+            assert(src != 0);
+            assert(constants != 0);
+            assert(count > 0);
+
+            if (!is_parallel(length))
+            {
+                Super::region_multiply_add_many(
+                    dests, src, constants, count, length);
+                return;
+            }
+
+            run(length, [&](uint32_t offset, uint32_t chunk)
+            {
+                std::vector<value_type*> chunk_dests(count);
+                for (uint32_t j = 0; j < count; ++j)
+                {
+                    chunk_dests[j] = dests[j] + offset;
+                }
+
+                Super::region_multiply_add_many(chunk_dests.data(),
+                    src + offset, constants, count, chunk);
+            });
+        }
+
+    protected:
+
+        /// @param length The length in value_type elements
+        /// @return True if a call with the length is computed in parallel
+        bool is_parallel(uint32_t length) const
+        {
+            return m_pool && m_pool->threads() > 1 &&
+                length >= m_threshold && length > chunk_length();
+        }
+
+        /// Calls the function for each chunk of the buffers in parallel
+        /// if the length is long enough, otherwise calls it once for the
+        /// whole buffers on the calling thread.
+        ///
+        /// @param length The length in value_type elements
+        /// @param function Called with the offset and the length of a
+        ///        chunk in value_type elements
+        template<class Function>
+        void run(uint32_t length, const Function& function) const
+        {
+            if (!is_parallel(length))
+            {
+                function(0, length);
+                return;
+            }
+
+            uint32_t chunk = chunk_length();
+            uint32_t tasks =
+                (uint32_t) (((uint64_t) length + chunk - 1) / chunk);
+
+            m_pool->run(tasks, [&](uint32_t task)
+            {
+                uint32_t offset = task * chunk;
+                function(offset, std::min(chunk, length - offset));
+            });
+        }
+
+    private:
+
+        /// The thread pool computing the chunks
+        std::shared_ptr<thread_pool> m_pool;
+
+        /// The requested length of the chunks in value_type elements
+        uint32_t m_chunk_length;
+
+        /// The length below which calls are computed on the calling thread
+        uint32_t m_threshold;
+    };
+}
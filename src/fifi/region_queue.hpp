@@ -0,0 +1,268 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "fifi_utils.hpp"
+
+namespace fifi
+{
+    /// The default size in bytes of the blocks of the destination which
+    /// the fused operations of a region_queue are computed on, so the
+    /// block stays in the L1 cache between the operations
+    const uint32_t region_queue_block_size = 4096;
+
+    /// Records region operations instead of computing them and computes
+    /// them when flushed. Consecutive operations on the same destination,
+    /// e.g. a region_multiply_constant followed by a number of
+    /// region_multiply_add calls as emitted by a decoder, are fused so
+    /// the destination is only read and written once. The fused
+    /// operations are computed block by block, each block being updated
+    /// by all the operations of the sequence while it is in the cache.
+    /// The blocks are computed by the region operations of the stack, so
+    /// the SIMD stacks are used as usual.
+    ///
+    /// The results are the same as when calling the stack directly. An
+    /// operation whose source overlaps its destination at a different
+    /// position is not fused, since it depends on the order of the
+    /// elements.
+    ///
+    /// Example:
+    ///
+    /// fifi::region_queue<fifi::full_table<fifi::binary8>> queue(field);
+    /// queue.region_multiply_constant(dest, constant, length);
+    /// queue.region_multiply_add(dest, src, constant, length);
+    /// ...
+    /// queue.flush();
+    ///
+    /// The buffers must stay alive and the sources must not be changed
+    /// until the queue is flushed.
+    template<class Stack>
+    class region_queue
+    {
+    public:
+
+        /// The field type
+        typedef typename Stack::field_type field_type;
+
+        /// Typedef of the data type used for each field element
+        typedef typename Stack::value_type value_type;
+
+    public:
+
+        /// @param stack The stack computing the operations
+        region_queue(const Stack& stack) :
+            m_stack(stack),
+            m_block_length(std::max(
+                size_to_length<field_type>(region_queue_block_size), 1U))
+        { }
+
+        /// Computes the operations which have not been flushed
+        ~region_queue()
+        {
+            flush();
+        }
+
+        /// @param length The length in value_type elements of the blocks
+        ///        the fused operations are computed on, it is rounded
+        ///        down to a multiple of the granularity
+        void set_block_length(uint32_t length)
+        {
+            assert(length > 0);
+            m_block_length = length;
+        }
+
+        /// @return The length in value_type elements of the blocks the
+        ///         fused operations are computed on, a multiple of the
+        ///         granularity
+        uint32_t block_length() const
+        {
+            uint32_t granularity = m_stack.granularity();
+            assert(granularity > 0);
+
+            return std::max(m_block_length / granularity, 1U) * granularity;
+        }
+
+        /// @return The number of operations which have not been flushed
+        uint32_t size() const
+        {
+            return (uint32_t) m_operations.size();
+        }
+
+        /// Records a region_add() call
+        /// @copydoc layer::region_add(value_type*, const value_type*,
+        ///                            uint32_t) const
+        void region_add(value_type* dest, const value_type* src,
+            uint32_t length)
+        {
+            assert(src != 0);
+
+            operation o = { op_add, dest, src, 0, length };
+            record(o);
+        }
+
+        /// Records a region_multiply_constant() call
+        /// @copydoc layer::region_multiply_constant(value_type*, value_type,
+        ///                                          uint32_t) const
+        void region_multiply_constant(value_type* dest, value_type constant,
+            uint32_t length)
+        {
+            operation o = { op_multiply_constant, dest, 0, constant, length };
+            record(o);
+        }
+
+        /// Records a region_multiply_add() call
+        /// @copydoc layer::region_multiply_add(value_type*, const value_type*,
+        ///                                     value_type, uint32_t) const
+        void region_multiply_add(value_type* dest, const value_type* src,
+            value_type constant, uint32_t length)
+        {
+            assert(src != 0);
+
+            operation o = { op_multiply_add, dest, src, constant, length };
+            record(o);
+        }
+
+        /// Computes all recorded operations in the order they were
+        /// recorded, fusing consecutive operations on the same destination
+        void flush()
+        {
+            uint32_t i = 0;
+            while (i < m_operations.size())
+            {
+                uint32_t end = i + 1;
+
+                if (is_fusable(m_operations[i]))
+                {
+                    const operation& first = m_operations[i];
+
+                    while (end < m_operations.size() &&
+                           is_fusable(m_operations[end]) &&
+                           m_operations[end].m_dest == first.m_dest &&
+                           m_operations[end].m_length == first.m_length)
+                    {
+                        ++end;
+                    }
+                }
+
+                run(i, end);
+                i = end;
+            }
+
+            m_operations.clear();
+        }
+
+    private:
+
+        /// The recorded operations
+        enum operation_type
+        {
+            op_add,
+            op_multiply_constant,
+            op_multiply_add
+        };
+
+        /// A recorded operation
+        struct operation
+        {
+            operation_type m_type;
+            value_type* m_dest;
+            const value_type* m_src;
+            value_type m_constant;
+            uint32_t m_length;
+        };
+
+        /// @param o The operation to record
+        void record(const operation& o)
+        {
+            assert(o.m_dest != 0);
+            assert(o.m_length > 0);
+
+            m_operations.push_back(o);
+        }
+
+        /// @param o An operation
+        /// @return True if the operation can be computed block by block,
+        ///         i.e. its source does not overlap its destination at a
+        ///         different position
+        bool is_fusable(const operation& o) const
+        {
+            if (o.m_src == 0 || o.m_src == o.m_dest)
+            {
+                return true;
+            }
+
+            return o.m_src + o.m_length <= o.m_dest ||
+                o.m_dest + o.m_length <= o.m_src;
+        }
+
+        /// Computes a sequence of operations on the same destination
+        /// block by block
+        ///
+        /// @param begin The index of the first operation
+        /// @param end The index after the last operation
+        void run(uint32_t begin, uint32_t end)
+        {
+            assert(begin < end);
+
+            uint32_t length = m_operations[begin].m_length;
+            uint32_t block = end - begin > 1 ? block_length() : length;
+
+            for (uint32_t offset = 0; offset < length; offset += block)
+            {
+                uint32_t current = std::min(block, length - offset);
+
+                for (uint32_t i = begin; i < end; ++i)
+                {
+                    execute(m_operations[i], offset, current);
+                }
+            }
+        }
+
+        /// Computes a block of an operation
+        ///
+        /// @param o The operation
+        /// @param offset The offset of the block in value_type elements
+        /// @param length The length of the block in value_type elements
+        void execute(const operation& o, uint32_t offset,
+            uint32_t length) const
+        {
+            switch (o.m_type)
+            {
+            case op_add:
+                m_stack.region_add(
+                    o.m_dest + offset, o.m_src + offset, length);
+                break;
+            case op_multiply_constant:
+                m_stack.region_multiply_constant(
+                    o.m_dest + offset, o.m_constant, length);
+                break;
+            case op_multiply_add:
+                m_stack.region_multiply_add(
+                    o.m_dest + offset, o.m_src + offset, o.m_constant, length);
+                break;
+            default:
+                assert(0);
+                break;
+            }
+        }
+
+    private:
+
+        /// The stack computing the operations
+        const Stack& m_stack;
+
+        /// The requested length of the blocks in value_type elements
+        uint32_t m_block_length;
+
+        /// The operations which have not been flushed
+        std::vector<operation> m_operations;
+    };
+}
@@ -0,0 +1,241 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+#include "has_region_add.hpp"
+#include "has_region_subtract.hpp"
+#include "has_region_multiply.hpp"
+#include "has_region_divide.hpp"
+#include "has_region_multiply_constant.hpp"
+#include "has_region_multiply_add.hpp"
+#include "has_region_multiply_subtract.hpp"
+#include "has_region_linear_combination.hpp"
+#include "has_region_multiply_add_many.hpp"
+#include "has_region_operation.hpp"
+#include "is_statically_enabled.hpp"
+#include "region_thresholds.hpp"
+
+namespace fifi
+{
+    /// The compile-time counterpart of region_dispatcher_specialization
+    /// used when the build targets the instruction set of the dispatch
+    /// stack @see target_instruction_set. As with the run-time version
+    /// this class is typically used through region_dispatcher.
+    ///
+    /// The generic version represents the fall through in cases where
+    /// the main stack's field is different from the dispatch stack's
+    /// field, or where the dispatch stack is known to be disabled. No
+    /// calls are routed through the layer in that case, so it adds no
+    /// overhead to the stack.
+    ///
+    /// @tparam Enabled True if the dispatch stack is known to be enabled
+    template<class Field, class Stack, class StackField, class Super,
+             bool Enabled = is_statically_enabled<Stack>::value>
+    class region_static_dispatcher_specialization : public Super
+    {
+    public:
+
+        /// Has no effect since no operations are dispatched
+        void set_use_stack(bool)
+        { }
+
+        /// @return False since no operations are dispatched
+        bool uses_stack(region_thresholds::operation) const
+        {
+            return false;
+        }
+    };
+
+    /// Specialization of the dispatcher which is enabled when the main
+    /// stack and the dispatch stack have matching fields and the
+    /// dispatch stack is known to be enabled. The operations supported
+    /// by the dispatch stack are called directly on it, the remaining
+    /// operations are called on Super. Compared to the run-time
+    /// dispatch there are no callables to invoke, the layer resolves to
+    /// a direct call which the compiler can inline into the caller.
+    template<class Field, class Stack, class Super>
+    class region_static_dispatcher_specialization<
+        Field, Stack, Field, Super, true> : public Super
+    {
+    public:
+
+        /// @copydoc layer::field_type
+        typedef typename Super::field_type field_type;
+
+        /// @copydoc layer::value_type
+        typedef typename Super::value_type value_type;
+
+    public:
+
+        /// @copydoc layer::region_add(value_type*, const value_type*,
+        ///                            uint32_t) const
+        void region_add(value_type* dest, const value_type* src,
+            uint32_t length) const
+        {
+            target<has_region_add<Stack>>().region_add(dest, src, length);
+        }
+
+        /// @copydoc layer::region_subtract(value_type*, const value_type*,
+        ///                                 uint32_t) const
+        void region_subtract(value_type* dest, const value_type* src,
+            uint32_t length) const
+        {
+            target<has_region_subtract<Stack>>().region_subtract(
+                dest, src, length);
+        }
+
+        /// @copydoc layer::region_multiply(value_type*, const value_type*,
+        ///                                 uint32_t) const
+        void region_multiply(value_type* dest, const value_type* src,
+            uint32_t length) const
+        {
+            target<has_region_multiply<Stack>>().region_multiply(
+                dest, src, length);
+        }
+
+        /// @copydoc layer::region_divide(value_type*, const value_type*,
+        ///                               uint32_t) const
+        void region_divide(value_type* dest, const value_type* src,
+            uint32_t length) const
+        {
+            target<has_region_divide<Stack>>().region_divide(
+                dest, src, length);
+        }
+
+        /// @copydoc layer::region_multiply_constant(value_type*, value_type,
+        ///                                          uint32_t) const
+        void region_multiply_constant(
+            value_type* dest, value_type constant,
+            uint32_t length) const
+        {
+            target<has_region_multiply_constant<Stack>>()
+                .region_multiply_constant(dest, constant, length);
+        }
+
+        /// @copydoc layer::region_multiply_add(value_type*, const value_type*,
+        ///                                     value_type, uint32_t) const
+        void region_multiply_add(value_type* dest, const value_type* src,
+                          value_type constant, uint32_t length) const
+        {
+            target<has_region_multiply_add<Stack>>().region_multiply_add(
+                dest, src, constant, length);
+        }
+
+        /// @copydoc layer::region_multiply_subtract(value_type*,
+        ///                                          const value_type*,
+        ///                                          value_type, uint32_t) const
+        void region_multiply_subtract(value_type* dest, const value_type* src,
+                                value_type constant, uint32_t length) const
+        {
+            target<has_region_multiply_subtract<Stack>>()
+                .region_multiply_subtract(dest, src, constant, length);
+        }
+
+        /// @copydoc layer::region_linear_combination(value_type*,
+        ///                                           const value_type* const*,
+        ///                                           const value_type*,
+        ///                                           uint32_t, uint32_t) const
+        void region_linear_combination(value_type* dest,
+            const value_type* const* srcs, const value_type* constants,
+            uint32_t count, uint32_t length) const
+        {
+            target<has_region_linear_combination<Stack>>()
+                .region_linear_combination(dest, srcs, constants, count,
+                                           length);
+        }
+
+        /// @copydoc layer::region_multiply_add_many(value_type* const*,
+        ///                                          const value_type*,
+        ///                                          const value_type*,
+        ///                                          uint32_t, uint32_t) const
+        void region_multiply_add_many(value_type* const* dests,
+            const value_type* src, const value_type* constants,
+            uint32_t count, uint32_t length) const
+        {
+            target<has_region_multiply_add_many<Stack>>()
+                .region_multiply_add_many(dests, src, constants, count,
+                                          length);
+        }
+
+        /// @copydoc layer::alignment() const
+        uint32_t alignment() const
+        {
+            return std::max(m_stack.alignment(), Super::alignment());
+        }
+
+        /// @copydoc layer::max_alignment() const
+        uint32_t max_alignment() const
+        {
+            return std::max(m_stack.max_alignment(), Super::max_alignment());
+        }
+
+        /// @copydoc layer::granularity() const
+        uint32_t granularity() const
+        {
+            return std::max(m_stack.granularity(), Super::granularity());
+        }
+
+        /// @copydoc layer::max_granularity() const
+        uint32_t max_granularity() const
+        {
+            return std::max(m_stack.max_granularity(),
+                            Super::max_granularity());
+        }
+
+        /// @return True since the embedded stack is known to be enabled
+        bool enabled() const
+        {
+            return true;
+        }
+
+        /// Has no effect since the dispatch is fixed at compile-time,
+        /// build with FIFI_RUNTIME_DISPATCH to select the stacks at
+        /// run-time @see target_instruction_set
+        void set_use_stack(bool)
+        { }
+
+        /// @param op The region operation
+        /// @return True if the operation is dispatched to the embedded
+        ///         stack, otherwise it is called on Super
+        bool uses_stack(region_thresholds::operation op) const
+        {
+            return has_region_operation<Stack>(op);
+        }
+
+    private:
+
+        /// @return The embedded stack if it supports the operation
+        ///         detected by HasOperation, otherwise Super
+        template<class HasOperation>
+        auto target() const -> const typename std::conditional<
+            HasOperation::value, Stack, Super>::type&
+        {
+            return target(std::integral_constant<
+                bool, HasOperation::value>());
+        }
+
+        /// @return The embedded stack
+        const Stack& target(std::true_type) const
+        {
+            return m_stack;
+        }
+
+        /// @return This layer as Super
+        const Super& target(std::false_type) const
+        {
+            return *this;
+        }
+
+    private:
+
+        /// The stack to use for dispatching
+        Stack m_stack;
+    };
+}
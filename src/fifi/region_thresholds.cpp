@@ -0,0 +1,113 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+#include "region_thresholds.hpp"
+
+namespace fifi
+{
+    region_thresholds::region_thresholds()
+    {
+        std::fill_n(m_thresholds, (uint32_t) operations, 0U);
+    }
+
+    void region_thresholds::write(std::ostream& out) const
+    {
+        for (uint32_t i = 0; i < operations; ++i)
+        {
+            out << name((operation) i) << " " << m_thresholds[i] << "\n";
+        }
+    }
+
+    bool region_thresholds::read(std::istream& in)
+    {
+        uint32_t thresholds[operations];
+        std::copy(m_thresholds, m_thresholds + operations, thresholds);
+
+        std::string line;
+        while (std::getline(in, line))
+        {
+            std::istringstream fields(line);
+
+            std::string op_name;
+            if (!(fields >> op_name))
+            {
+                // Empty lines are allowed
+                continue;
+            }
+
+            // The threshold is read as a signed number to reject
+            // negative values which would otherwise wrap around
+            int64_t threshold;
+            if (!(fields >> threshold) || threshold < 0 ||
+                threshold > UINT32_MAX)
+            {
+                return false;
+            }
+
+            std::string trailing;
+            if (fields >> trailing)
+            {
+                return false;
+            }
+
+            uint32_t i = 0;
+            while (i < operations && op_name != name((operation) i))
+            {
+                ++i;
+            }
+
+            if (i == operations)
+            {
+                return false;
+            }
+
+            thresholds[i] = (uint32_t) threshold;
+        }
+
+        std::copy(thresholds, thresholds + operations, m_thresholds);
+        return true;
+    }
+
+    const char* region_thresholds::name(operation op)
+    {
+        switch (op)
+        {
+        case region_add:
+            return "region_add";
+        case region_subtract:
+            return "region_subtract";
+        case region_multiply:
+            return "region_multiply";
+        case region_divide:
+            return "region_divide";
+        case region_multiply_constant:
+            return "region_multiply_constant";
+        case region_multiply_add:
+            return "region_multiply_add";
+        case region_multiply_subtract:
+            return "region_multiply_subtract";
+        case region_linear_combination:
+            return "region_linear_combination";
+        case region_multiply_add_many:
+            return "region_multiply_add_many";
+        default:
+            assert(0);
+            return "";
+        }
+    }
+
+    bool region_thresholds::operator==(const region_thresholds& other) const
+    {
+        return std::equal(m_thresholds, m_thresholds + operations,
+                          other.m_thresholds);
+    }
+}
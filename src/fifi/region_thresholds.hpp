@@ -0,0 +1,98 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <iosfwd>
+
+namespace fifi
+{
+    /// Holds a length threshold per region operation. Calls with a
+    /// length below the threshold of the operation are computed by the
+    /// basic layers only, calls with a length of at least the threshold
+    /// are computed by the optimized layers, @see region_divide_granularity.
+    ///
+    /// The thresholds are typically found for a specific stack and CPU
+    /// with calibrate_region_thresholds(). They can be written to a
+    /// stream and read back later, so the calibration does not have to
+    /// run every time a process starts. The thresholds of one stack do
+    /// in general not apply to other stacks.
+    class region_thresholds
+    {
+    public:
+
+        /// The region operations which have a threshold
+        enum operation
+        {
+            region_add,
+            region_subtract,
+            region_multiply,
+            region_divide,
+            region_multiply_constant,
+            region_multiply_add,
+            region_multiply_subtract,
+            region_linear_combination,
+            region_multiply_add_many,
+            operations
+        };
+
+    public:
+
+        /// Constructs thresholds where all lengths use the optimized
+        /// layers, i.e. all thresholds are zero
+        region_thresholds();
+
+        /// @param op The region operation
+        /// @return The threshold of the operation in value_type elements
+        uint32_t operator[](operation op) const
+        {
+            assert(op < operations);
+            return m_thresholds[op];
+        }
+
+        /// @param op The region operation
+        /// @return The threshold of the operation in value_type elements
+        uint32_t& operator[](operation op)
+        {
+            assert(op < operations);
+            return m_thresholds[op];
+        }
+
+        /// Writes the thresholds to a stream, one line per operation
+        /// with the name of the operation followed by its threshold
+        /// e.g. "region_multiply_add 64".
+        ///
+        /// @param out The stream to write to
+        void write(std::ostream& out) const;
+
+        /// Reads thresholds in the format produced by write().
+        /// Operations which are not listed keep their current threshold.
+        ///
+        /// @param in The stream to read from
+        /// @return True if the stream could be parsed, otherwise false
+        ///         in which case the thresholds are left unchanged
+        bool read(std::istream& in);
+
+        /// @param op The region operation
+        /// @return The name of the operation e.g. "region_add"
+        static const char* name(operation op);
+
+        /// @return True if the thresholds of the two objects are equal
+        bool operator==(const region_thresholds& other) const;
+
+        /// @return True if the thresholds of the two objects differ
+        bool operator!=(const region_thresholds& other) const
+        {
+            return !(*this == other);
+        }
+
+    private:
+
+        /// The threshold of each operation in value_type elements
+        uint32_t m_thresholds[operations];
+    };
+}
@@ -0,0 +1,76 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <cassert>
+#include <cstdint>
+#include <mutex>
+
+#include "scheduler_job.hpp"
+
+namespace fifi
+{
+    scheduler_job::scheduler_job() :
+        m_remaining(0),
+        m_done(true)
+    { }
+
+    scheduler_job::~scheduler_job()
+    {
+        wait();
+    }
+
+    bool scheduler_job::is_done() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_done;
+    }
+
+    void scheduler_job::wait() const
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this] { return m_done; });
+    }
+
+    void scheduler_job::start(const callback_type& callback)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            // A job can only run once at a time
+            assert(m_done);
+            m_done = false;
+        }
+
+        m_callback = callback;
+        m_remaining = tasks();
+
+        if (m_remaining == 0)
+        {
+            complete();
+        }
+    }
+
+    void scheduler_job::finish()
+    {
+        assert(m_remaining > 0);
+
+        if (--m_remaining == 0)
+        {
+            complete();
+        }
+    }
+
+    void scheduler_job::complete()
+    {
+        if (m_callback)
+        {
+            m_callback();
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_done = true;
+        m_condition.notify_all();
+    }
+}
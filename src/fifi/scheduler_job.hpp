@@ -0,0 +1,90 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+namespace fifi
+{
+    /// A job of independent tasks executed by a work_stealing_scheduler,
+    /// e.g. a region_batch. The tasks are identified by their index and
+    /// may be executed in any order and on any worker thread.
+    ///
+    /// The job tracks the completion of its tasks. When the last task
+    /// has been executed the completion callback is called on the worker
+    /// thread which executed it, after which wait() returns.
+    class scheduler_job
+    {
+    public:
+
+        /// Called when all tasks of the job have been executed
+        typedef std::function<void()> callback_type;
+
+    public:
+
+        scheduler_job();
+
+        /// Waits for the job to complete if it is running. Derived jobs
+        /// must also wait in their destructor, since the tasks may still
+        /// be executed while it runs.
+        virtual ~scheduler_job();
+
+        /// @return The number of tasks of the job
+        virtual uint32_t tasks() const = 0;
+
+        /// Executes a task of the job
+        ///
+        /// @param index The index of the task
+        virtual void execute(uint32_t index) = 0;
+
+        /// @return True if the job is not running, i.e. it has not been
+        ///         submitted or all its tasks have been executed
+        bool is_done() const;
+
+        /// Blocks until all tasks of the job have been executed and the
+        /// completion callback has returned
+        void wait() const;
+
+        /// Starts a run of the job, called by the scheduler when the job
+        /// is submitted. If the job has no tasks it completes at once.
+        ///
+        /// @param callback Called when the job completes, may be empty
+        void start(const callback_type& callback);
+
+        /// Marks a task as executed, called by the scheduler after each
+        /// call to execute()
+        void finish();
+
+    private:
+
+        scheduler_job(const scheduler_job&);
+        scheduler_job& operator=(const scheduler_job&);
+
+        /// Calls the callback and marks the job as done
+        void complete();
+
+    private:
+
+        /// The number of tasks not yet executed in the current run
+        std::atomic<uint32_t> m_remaining;
+
+        /// The completion callback of the current run
+        callback_type m_callback;
+
+        /// Protects the done flag
+        mutable std::mutex m_mutex;
+
+        /// Signals that the job is done
+        mutable std::condition_variable m_condition;
+
+        /// True if the job is not running
+        bool m_done;
+    };
+}
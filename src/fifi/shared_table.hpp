@@ -0,0 +1,44 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+namespace fifi
+{
+    /// Returns the process-wide instance of an immutable look-up table.
+    /// The table is built by its default constructor the first time it
+    /// is requested, after which all stacks share the same read-only
+    /// instance. This makes the construction of a stack O(1) and keeps
+    /// the memory usage independent of the number of stacks.
+    ///
+    /// The table type serves as the key, so each layer defines its own
+    /// table type. The initialization is thread-safe since C++11
+    /// guarantees that a function local static is initialized exactly
+    /// once, also when the function is called concurrently.
+    ///
+    /// Example:
+    ///
+    ///     struct square_table
+    ///     {
+    ///         square_table()
+    ///         {
+    ///             for (uint32_t i = 0; i < 256; ++i)
+    ///                 m_squares[i] = i * i;
+    ///         }
+    ///
+    ///         uint32_t m_squares[256];
+    ///     };
+    ///
+    ///     const square_table& table = fifi::shared_table<square_table>();
+    ///
+    /// @tparam Table The table type
+    /// @return The shared table
+    template<class Table>
+    inline const Table& shared_table()
+    {
+        static const Table table;
+        return table;
+    }
+}
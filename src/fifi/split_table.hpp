@@ -0,0 +1,41 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "avx2_binary16_split_table.hpp"
+#include "binary4_packed_arithmetic.hpp"
+#include "extended_log_table_arithmetic.hpp"
+#include "final.hpp"
+#include "packed_arithmetic.hpp"
+#include "region_arithmetic.hpp"
+#include "region_dispatcher.hpp"
+#include "region_divide_granularity.hpp"
+#include "region_info.hpp"
+#include "simple_online_arithmetic.hpp"
+#include "ssse3_binary16_split_table.hpp"
+
+namespace fifi
+{
+    /// The split look-up table stack. This stack is intended for the
+    /// binary16 field where a full look-up table would be too
+    /// large. The region operations are dispatched to SIMD stacks
+    /// which split the multiplication into 4-bit nibbles using small
+    /// per-constant tables, while the remaining computations are based
+    /// on the extended log table.
+    template<class Field>
+    class split_table : public
+        region_divide_granularity<
+        region_dispatcher<avx2_binary16_split_table,
+        region_dispatcher<ssse3_binary16_split_table,
+        region_arithmetic<
+        region_info<
+        binary4_packed_arithmetic<Field,
+        packed_arithmetic<
+        extended_log_table_arithmetic<
+        simple_online_arithmetic<
+        final<Field> > > > > > > > > >
+    { };
+}
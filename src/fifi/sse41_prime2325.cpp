@@ -0,0 +1,338 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <platform/config.hpp>
+#include <cpuid/cpuinfo.hpp>
+
+// Include x86 intrinsics for GCC-compatible compilers on x86/x86_64
+#if defined(PLATFORM_GCC_COMPATIBLE_X86)
+    #include <x86intrin.h>
+#endif
+
+#include "sse41_prime2325.hpp"
+
+namespace fifi
+{
+
+#ifdef PLATFORM_SSE41
+
+    namespace
+    {
+        /// Subtracts the elements of b from the elements of a modulo
+        /// 2^32 - 5. This is the vectorized version of
+        /// optimal_prime_arithmetic::subtract()
+        inline __m128i subtract(__m128i a, __m128i b, __m128i prime)
+        {
+            // a >= b holds in the lanes where max(a, b) equals a
+            __m128i no_underflow =
+                _mm_cmpeq_epi32(_mm_max_epu32(a, b), a);
+
+            // An underflow wraps modulo 2^32 so we add the prime in
+            // those lanes to get the result modulo 2^32 - 5
+            return _mm_add_epi32(_mm_sub_epi32(a, b),
+                                 _mm_andnot_si128(no_underflow, prime));
+        }
+
+        /// Adds the elements of a and b modulo 2^32 - 5
+        inline __m128i add(__m128i a, __m128i b, __m128i prime)
+        {
+            // a + b is computed as a - (prime - b) which avoids
+            // detecting the 32 bit overflow of the sum
+            return subtract(a, _mm_sub_epi32(prime, b), prime);
+        }
+
+        /// Reduces the 64 bit products in each lane modulo 2^32 - 5
+        /// using that 2^32 = 5 modulo 2^32 - 5. The result is left in
+        /// the low 32 bits of each lane.
+        inline __m128i reduce(__m128i c, __m128i low_mask, __m128i five)
+        {
+            // Fold the high 32 bits, the sum is below 6 * 2^32
+            c = _mm_add_epi64(_mm_and_si128(c, low_mask),
+                              _mm_mul_epu32(_mm_srli_epi64(c, 32), five));
+
+            // Fold again, the sum is now below 2^32 + 25
+            c = _mm_add_epi64(_mm_and_si128(c, low_mask),
+                              _mm_mul_epu32(_mm_srli_epi64(c, 32), five));
+
+            // If c >= 2^32 - 5 then c + 5 carries into the high 32
+            // bits, in which case subtracting the prime is the same as
+            // adding 5 to the low 32 bits
+            __m128i carry = _mm_srli_epi64(_mm_add_epi64(c, five), 32);
+            return _mm_add_epi64(c, _mm_mul_epu32(carry, five));
+        }
+
+        /// Multiplies the elements with the constant modulo 2^32 - 5
+        inline __m128i multiply(__m128i v, __m128i constant,
+            __m128i low_mask, __m128i five)
+        {
+            // _mm_mul_epu32 multiplies the even elements so the odd
+            // elements are shifted down before they are multiplied
+            __m128i even = _mm_mul_epu32(v, constant);
+            __m128i odd = _mm_mul_epu32(_mm_srli_epi64(v, 32), constant);
+
+            even = reduce(even, low_mask, five);
+            odd = reduce(odd, low_mask, five);
+
+            // Move the odd results back in place and merge them with the
+            // even results
+            return _mm_blend_epi16(even, _mm_slli_epi64(odd, 32), 0xCC);
+        }
+    }
+
+    void sse41_prime2325::region_add(
+        value_type* dest, const value_type* src, uint32_t length) const
+    {
+        assert(dest != 0);
+        assert(src != 0);
+        assert(length > 0);
+        assert((length % granularity()) == 0);
+
+        // We loop 4 elements at-a-time so we calculate how many loops we need
+        uint32_t sse_size = length / granularity();
+        assert(sse_size > 0);
+
+        __m128i prime = _mm_set1_epi32(field_type::prime);
+
+        __m128i* src_ptr = (__m128i*)src;
+        __m128i* dest_ptr = (__m128i*)dest;
+        for (uint32_t i = 0; i < sse_size; i++, src_ptr++, dest_ptr++)
+        {
+            // Load the next 16-bytes of the destination and source buffers
+            __m128i xmm0 = _mm_loadu_si128(dest_ptr);
+            __m128i xmm1 = _mm_loadu_si128(src_ptr);
+            // Add these values together
+            xmm0 = add(xmm0, xmm1, prime);
+            // Store the result in the destination buffer
+            _mm_storeu_si128(dest_ptr, xmm0);
+        }
+    }
+
+    void sse41_prime2325::region_subtract(
+        value_type* dest, const value_type* src, uint32_t length) const
+    {
+        assert(dest != 0);
+        assert(src != 0);
+        assert(length > 0);
+        assert((length % granularity()) == 0);
+
+        // We loop 4 elements at-a-time so we calculate how many loops we need
+        uint32_t sse_size = length / granularity();
+        assert(sse_size > 0);
+
+        __m128i prime = _mm_set1_epi32(field_type::prime);
+
+        __m128i* src_ptr = (__m128i*)src;
+        __m128i* dest_ptr = (__m128i*)dest;
+        for (uint32_t i = 0; i < sse_size; i++, src_ptr++, dest_ptr++)
+        {
+            // Load the next 16-bytes of the destination and source buffers
+            __m128i xmm0 = _mm_loadu_si128(dest_ptr);
+            __m128i xmm1 = _mm_loadu_si128(src_ptr);
+            // Subtract the source values from the destination values
+            xmm0 = subtract(xmm0, xmm1, prime);
+            // Store the result in the destination buffer
+            _mm_storeu_si128(dest_ptr, xmm0);
+        }
+    }
+
+    void sse41_prime2325::region_multiply_constant(
+        value_type* dest, value_type constant, uint32_t length) const
+    {
+        assert(dest != 0);
+        assert(length > 0);
+        assert((length % granularity()) == 0);
+
+        // We loop 4 elements at-a-time so we calculate how many loops we need
+        uint32_t sse_size = length / granularity();
+        assert(sse_size > 0);
+
+        __m128i c = _mm_set1_epi32(constant);
+        __m128i low_mask = _mm_set1_epi64x(0xffffffff);
+        __m128i five = _mm_set1_epi64x(5);
+
+        __m128i* dest_ptr = (__m128i*)dest;
+        for (uint32_t i = 0; i < sse_size; i++, dest_ptr++)
+        {
+            // Load the next 16-bytes of the destination buffer
+            __m128i xmm0 = _mm_loadu_si128(dest_ptr);
+            // Multiply the elements with the constant
+            xmm0 = multiply(xmm0, c, low_mask, five);
+            // Store the result in the destination buffer
+            _mm_storeu_si128(dest_ptr, xmm0);
+        }
+    }
+
+    void sse41_prime2325::region_multiply_add(value_type* dest,
+        const value_type* src, value_type constant, uint32_t length) const
+    {
+        assert(dest != 0);
+        assert(src != 0);
+        assert(length > 0);
+        assert((length % granularity()) == 0);
+
+        // We loop 4 elements at-a-time so we calculate how many loops we need
+        uint32_t sse_size = length / granularity();
+        assert(sse_size > 0);
+
+        __m128i c = _mm_set1_epi32(constant);
+        __m128i low_mask = _mm_set1_epi64x(0xffffffff);
+        __m128i five = _mm_set1_epi64x(5);
+        __m128i prime = _mm_set1_epi32(field_type::prime);
+
+        __m128i* src_ptr = (__m128i*)src;
+        __m128i* dest_ptr = (__m128i*)dest;
+        for (uint32_t i = 0; i < sse_size; i++, src_ptr++, dest_ptr++)
+        {
+            // Load the next 16-bytes of the source buffer
+            __m128i xmm0 = _mm_loadu_si128(src_ptr);
+            // Multiply the src with the constant
+            xmm0 = multiply(xmm0, c, low_mask, five);
+            // Load the next 16-bytes of the destination buffer
+            __m128i xmm1 = _mm_loadu_si128(dest_ptr);
+            // Add the multiplication result to the destination value
+            xmm0 = add(xmm1, xmm0, prime);
+            // Store the result in the destination buffer
+            _mm_storeu_si128(dest_ptr, xmm0);
+        }
+    }
+
+    void sse41_prime2325::region_multiply_subtract(value_type* dest,
+        const value_type* src, value_type constant, uint32_t length) const
+    {
+        assert(dest != 0);
+        assert(src != 0);
+        assert(length > 0);
+        assert((length % granularity()) == 0);
+
+        // We loop 4 elements at-a-time so we calculate how many loops we need
+        uint32_t sse_size = length / granularity();
+        assert(sse_size > 0);
+
+        __m128i c = _mm_set1_epi32(constant);
+        __m128i low_mask = _mm_set1_epi64x(0xffffffff);
+        __m128i five = _mm_set1_epi64x(5);
+        __m128i prime = _mm_set1_epi32(field_type::prime);
+
+        __m128i* src_ptr = (__m128i*)src;
+        __m128i* dest_ptr = (__m128i*)dest;
+        for (uint32_t i = 0; i < sse_size; i++, src_ptr++, dest_ptr++)
+        {
+            // Load the next 16-bytes of the source buffer
+            __m128i xmm0 = _mm_loadu_si128(src_ptr);
+            // Multiply the src with the constant
+            xmm0 = multiply(xmm0, c, low_mask, five);
+            // Load the next 16-bytes of the destination buffer
+            __m128i xmm1 = _mm_loadu_si128(dest_ptr);
+            // Subtract the multiplication result from the destination value
+            xmm0 = subtract(xmm1, xmm0, prime);
+            // Store the result in the destination buffer
+            _mm_storeu_si128(dest_ptr, xmm0);
+        }
+    }
+
+    uint32_t sse41_prime2325::alignment() const
+    {
+        return sizeof(value_type);
+    }
+
+    uint32_t sse41_prime2325::max_alignment() const
+    {
+        return alignment();
+    }
+
+    uint32_t sse41_prime2325::granularity() const
+    {
+        // We are working over 16 bytes at a time i.e. 128 bits so we
+        // require a length granularity of 4 elements. We expect that
+        // prime2325 uses uint32_t as value_type
+        static_assert(std::is_same<value_type, uint32_t>::value,
+                      "Here we expect prime2325 to use uint32_t as value_type");
+        return 4U;
+    }
+
+    uint32_t sse41_prime2325::max_granularity() const
+    {
+        return granularity();
+    }
+
+    bool sse41_prime2325::enabled() const
+    {
+        static cpuid::cpuinfo info;
+        return info.has_sse4_1();
+    }
+
+#else
+
+    void sse41_prime2325::region_add(
+        value_type*, const value_type*, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
+    void sse41_prime2325::region_subtract(
+        value_type*, const value_type*, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
+    void sse41_prime2325::region_multiply_constant(
+        value_type*, value_type, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
+    void sse41_prime2325::region_multiply_add(
+        value_type*, const value_type*, value_type, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
+    void sse41_prime2325::region_multiply_subtract(
+        value_type*, const value_type*, value_type, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
+    uint32_t sse41_prime2325::alignment() const
+    {
+        // Not implemented
+        assert(0);
+        return 0;
+    }
+
+    uint32_t sse41_prime2325::max_alignment() const
+    {
+        // Not implemented
+        assert(0);
+        return 0;
+    }
+
+    uint32_t sse41_prime2325::granularity() const
+    {
+        // Not implemented
+        assert(0);
+        return 0;
+    }
+
+    uint32_t sse41_prime2325::max_granularity() const
+    {
+        // Not implemented
+        assert(0);
+        return 0;
+    }
+
+    bool sse41_prime2325::enabled() const
+    {
+        return false;
+    }
+
+#endif
+
+}
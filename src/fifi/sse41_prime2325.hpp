@@ -0,0 +1,106 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+#include "prime2325.hpp"
+#include "region_backend.hpp"
+#include "target_instruction_set.hpp"
+
+namespace fifi
+{
+    /// sse41_prime2325
+    ///
+    /// Stack implementing SSE4.1 SIMD accelerated finite field
+    /// arithmetic for the 2^32 - 5 prime field. The multiplications
+    /// are done with the 32x32 -> 64 bit _mm_mul_epu32 on the even and
+    /// odd elements, and the products are reduced with the same 2^32 - 5
+    /// folding as optimal_prime_arithmetic, vectorized across the
+    /// lanes. The following intrinsics are used available in the
+    /// following SIMD versions:
+    ///
+    /// _mm_loadu_si128 (SSE2)
+    /// _mm_set1_epi32 (SSE2)
+    /// _mm_set1_epi64x (SSE2)
+    /// _mm_add_epi32 (SSE2)
+    /// _mm_sub_epi32 (SSE2)
+    /// _mm_add_epi64 (SSE2)
+    /// _mm_srli_epi64 (SSE2)
+    /// _mm_slli_epi64 (SSE2)
+    /// _mm_mul_epu32 (SSE2)
+    /// _mm_and_si128 (SSE2)
+    /// _mm_andnot_si128 (SSE2)
+    /// _mm_cmpeq_epi32 (SSE2)
+    /// _mm_storeu_si128 (SSE2)
+    /// _mm_max_epu32 (SSE4.1)
+    /// _mm_blend_epi16 (SSE4.1)
+    ///
+    /// Based on this we see that the minimum required instruction for this
+    /// optimization is the Streaming SIMD Extensions 4.1 (SSE4.1).
+    class sse41_prime2325
+    {
+    public:
+
+        /// @copydoc layer::field_type
+        typedef prime2325 field_type;
+
+        /// @copydoc layer::value_type
+        typedef prime2325::value_type value_type;
+
+        /// True if the build targets SSE4.1, in which case the stack is
+        /// known to be enabled @see target_instruction_set
+        static const bool statically_enabled =
+            target_instruction_set::sse41;
+
+        /// The backend of the stack @see region_backend
+        static const region_backend backend = region_backend::sse41;
+
+    public:
+
+        /// @copydoc layer::region_add(
+        ///     value_type*, value_type*, uint32_t) const
+        void region_add(
+            value_type* dest, const value_type* src, uint32_t length) const;
+
+        /// @copydoc layer::region_subtract(
+        ///     value_type*, value_type*, uint32_t) const
+        void region_subtract(
+            value_type* dest, const value_type* src, uint32_t length) const;
+
+        /// @copydoc layer::region_multiply_constant(
+        ///      value_type*, value_type, uint32_t) const
+        void region_multiply_constant(
+            value_type* dest, value_type constant, uint32_t length) const;
+
+        /// @copydoc layer::region_multiply_add(
+        ///     value_type*, const value_type*, value_type, uint32_t) const
+        void region_multiply_add(value_type* dest, const value_type* src,
+            value_type constant, uint32_t length) const;
+
+        /// @copydoc layer::region_multiply_subtract(
+        ///     value_type*, const value_type*, value_type, uint32_t) const
+        void region_multiply_subtract(value_type* dest, const value_type* src,
+            value_type constant, uint32_t length) const;
+
+        /// @copydoc layer::alignment() const
+        uint32_t alignment() const;
+
+        /// @copydoc layer::max_alignment() const
+        uint32_t max_alignment() const;
+
+        /// @copydoc layer::granularity() const
+        uint32_t granularity() const;
+
+        /// @copydoc layer::max_granularity() const
+        uint32_t max_granularity() const;
+
+        /// @return true if the executable was built with SSE4.1
+        ///         prime2325 support
+        bool enabled() const;
+    };
+}
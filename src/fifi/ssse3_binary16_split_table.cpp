@@ -0,0 +1,382 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <platform/config.hpp>
+#include <cpuid/cpuinfo.hpp>
+
+// Include x86 intrinsics for GCC-compatible compilers on x86/x86_64
+#if defined(PLATFORM_GCC_COMPATIBLE_X86)
+    #include <x86intrin.h>
+#endif
+
+#include "ssse3_binary16_split_table.hpp"
+
+namespace fifi
+{
+
+#ifdef PLATFORM_SSSE3
+
+    void ssse3_binary16_split_table::region_add(
+        value_type* dest, const value_type* src, uint32_t length) const
+    {
+        assert(dest != 0);
+        assert(src != 0);
+        assert(length > 0);
+        assert((length % granularity()) == 0);
+
+        // We loop 32 bytes at-a-time so we calculate how many loops we need
+        uint32_t ssse3_size = length / granularity();
+        assert(ssse3_size > 0);
+
+        __m128i* src_ptr = (__m128i*)src;
+        __m128i* dest_ptr = (__m128i*)dest;
+        for (uint32_t i = 0; i < ssse3_size; i++, src_ptr+=2, dest_ptr+=2)
+        {
+            // Load the next 32-bytes of the destination and source buffers
+            __m128i xmm0 = _mm_loadu_si128(dest_ptr);
+            __m128i xmm1 = _mm_loadu_si128(dest_ptr + 1);
+            __m128i xmm2 = _mm_loadu_si128(src_ptr);
+            __m128i xmm3 = _mm_loadu_si128(src_ptr + 1);
+            // Xor these values together
+            xmm0 = _mm_xor_si128(xmm0, xmm2);
+            xmm1 = _mm_xor_si128(xmm1, xmm3);
+            // Store the result in the destination buffer
+            _mm_storeu_si128(dest_ptr, xmm0);
+            _mm_storeu_si128(dest_ptr + 1, xmm1);
+        }
+    }
+
+    void ssse3_binary16_split_table::region_subtract(
+        value_type* dest, const value_type* src, uint32_t length) const
+    {
+        // In a binary extension field addition is the same as subtraction
+        region_add(dest, src, length);
+    }
+
+    void ssse3_binary16_split_table::region_multiply_constant(
+        value_type* dest, value_type constant, uint32_t length) const
+    {
+        assert(dest != 0);
+        assert(length > 0);
+        assert((length % granularity()) == 0);
+
+        // We loop 32 bytes at-a-time so we calculate how many loops we need
+        uint32_t ssse3_size = length / granularity();
+        assert(ssse3_size > 0);
+
+        // Compute the split tables for the constant and load them
+        uint8_t tables[8 * 16];
+        split_tables(constant, tables);
+
+        const __m128i* table_ptr = (const __m128i*)tables;
+        __m128i table0_low = _mm_loadu_si128(table_ptr);
+        __m128i table0_high = _mm_loadu_si128(table_ptr + 1);
+        __m128i table1_low = _mm_loadu_si128(table_ptr + 2);
+        __m128i table1_high = _mm_loadu_si128(table_ptr + 3);
+        __m128i table2_low = _mm_loadu_si128(table_ptr + 4);
+        __m128i table2_high = _mm_loadu_si128(table_ptr + 5);
+        __m128i table3_low = _mm_loadu_si128(table_ptr + 6);
+        __m128i table3_high = _mm_loadu_si128(table_ptr + 7);
+
+        // Mask selecting the low byte of each 16-bit element and mask
+        // selecting the low nibble of each byte
+        __m128i byte_mask = _mm_set1_epi16(0x00ff);
+        __m128i nibble_mask = _mm_set1_epi8((char)0x0f);
+
+        __m128i* dest_ptr = (__m128i*)dest;
+        for (uint32_t i = 0; i < ssse3_size; i++, dest_ptr+=2)
+        {
+            // Load the next 16 elements of the destination buffer
+            __m128i xmm0 = _mm_loadu_si128(dest_ptr);
+            __m128i xmm1 = _mm_loadu_si128(dest_ptr + 1);
+
+            // Gather the low bytes and the high bytes of the elements in
+            // two separate registers
+            __m128i low = _mm_packus_epi16(
+                _mm_and_si128(xmm0, byte_mask),
+                _mm_and_si128(xmm1, byte_mask));
+            __m128i high = _mm_packus_epi16(
+                _mm_srli_epi16(xmm0, 8), _mm_srli_epi16(xmm1, 8));
+
+            // Split the bytes into the four nibbles of the elements
+            __m128i n0 = _mm_and_si128(low, nibble_mask);
+            __m128i n1 = _mm_and_si128(_mm_srli_epi64(low, 4), nibble_mask);
+            __m128i n2 = _mm_and_si128(high, nibble_mask);
+            __m128i n3 = _mm_and_si128(_mm_srli_epi64(high, 4), nibble_mask);
+
+            // Look up the products with each nibble and xor them together
+            // to get the low and high byte of the result
+            __m128i result_low = _mm_xor_si128(
+                _mm_xor_si128(_mm_shuffle_epi8(table0_low, n0),
+                              _mm_shuffle_epi8(table1_low, n1)),
+                _mm_xor_si128(_mm_shuffle_epi8(table2_low, n2),
+                              _mm_shuffle_epi8(table3_low, n3)));
+            __m128i result_high = _mm_xor_si128(
+                _mm_xor_si128(_mm_shuffle_epi8(table0_high, n0),
+                              _mm_shuffle_epi8(table1_high, n1)),
+                _mm_xor_si128(_mm_shuffle_epi8(table2_high, n2),
+                              _mm_shuffle_epi8(table3_high, n3)));
+
+            // Interleave the low and high bytes to restore the elements
+            // and store the result in the destination buffer
+            _mm_storeu_si128(dest_ptr,
+                _mm_unpacklo_epi8(result_low, result_high));
+            _mm_storeu_si128(dest_ptr + 1,
+                _mm_unpackhi_epi8(result_low, result_high));
+        }
+    }
+
+    void ssse3_binary16_split_table::region_multiply_add(value_type* dest,
+        const value_type* src, value_type constant, uint32_t length) const
+    {
+        assert(dest != 0);
+        assert(src != 0);
+        assert(length > 0);
+        assert((length % granularity()) == 0);
+
+        // We loop 32 bytes at-a-time so we calculate how many loops we need
+        uint32_t ssse3_size = length / granularity();
+        assert(ssse3_size > 0);
+
+        // Compute the split tables for the constant and load them
+        uint8_t tables[8 * 16];
+        split_tables(constant, tables);
+
+        const __m128i* table_ptr = (const __m128i*)tables;
+        __m128i table0_low = _mm_loadu_si128(table_ptr);
+        __m128i table0_high = _mm_loadu_si128(table_ptr + 1);
+        __m128i table1_low = _mm_loadu_si128(table_ptr + 2);
+        __m128i table1_high = _mm_loadu_si128(table_ptr + 3);
+        __m128i table2_low = _mm_loadu_si128(table_ptr + 4);
+        __m128i table2_high = _mm_loadu_si128(table_ptr + 5);
+        __m128i table3_low = _mm_loadu_si128(table_ptr + 6);
+        __m128i table3_high = _mm_loadu_si128(table_ptr + 7);
+
+        // Mask selecting the low byte of each 16-bit element and mask
+        // selecting the low nibble of each byte
+        __m128i byte_mask = _mm_set1_epi16(0x00ff);
+        __m128i nibble_mask = _mm_set1_epi8((char)0x0f);
+
+        __m128i* src_ptr = (__m128i*)src;
+        __m128i* dest_ptr = (__m128i*)dest;
+        for (uint32_t i = 0; i < ssse3_size; i++, src_ptr+=2, dest_ptr+=2)
+        {
+            // Multiply the src with the constant
+
+            // Load the next 16 elements of the source buffer
+            __m128i xmm0 = _mm_loadu_si128(src_ptr);
+            __m128i xmm1 = _mm_loadu_si128(src_ptr + 1);
+
+            // Gather the low bytes and the high bytes of the elements in
+            // two separate registers
+            __m128i low = _mm_packus_epi16(
+                _mm_and_si128(xmm0, byte_mask),
+                _mm_and_si128(xmm1, byte_mask));
+            __m128i high = _mm_packus_epi16(
+                _mm_srli_epi16(xmm0, 8), _mm_srli_epi16(xmm1, 8));
+
+            // Split the bytes into the four nibbles of the elements
+            __m128i n0 = _mm_and_si128(low, nibble_mask);
+            __m128i n1 = _mm_and_si128(_mm_srli_epi64(low, 4), nibble_mask);
+            __m128i n2 = _mm_and_si128(high, nibble_mask);
+            __m128i n3 = _mm_and_si128(_mm_srli_epi64(high, 4), nibble_mask);
+
+            // Look up the products with each nibble and xor them together
+            // to get the low and high byte of the result
+            __m128i result_low = _mm_xor_si128(
+                _mm_xor_si128(_mm_shuffle_epi8(table0_low, n0),
+                              _mm_shuffle_epi8(table1_low, n1)),
+                _mm_xor_si128(_mm_shuffle_epi8(table2_low, n2),
+                              _mm_shuffle_epi8(table3_low, n3)));
+            __m128i result_high = _mm_xor_si128(
+                _mm_xor_si128(_mm_shuffle_epi8(table0_high, n0),
+                              _mm_shuffle_epi8(table1_high, n1)),
+                _mm_xor_si128(_mm_shuffle_epi8(table2_high, n2),
+                              _mm_shuffle_epi8(table3_high, n3)));
+
+            // Interleave the low and high bytes to restore the elements
+            xmm0 = _mm_unpacklo_epi8(result_low, result_high);
+            xmm1 = _mm_unpackhi_epi8(result_low, result_high);
+
+            // Add this product to the dest
+
+            // Load the next 16 elements of the destination buffer
+            __m128i xmm2 = _mm_loadu_si128(dest_ptr);
+            __m128i xmm3 = _mm_loadu_si128(dest_ptr + 1);
+            // Xor the multiplication result and the destination value
+            xmm0 = _mm_xor_si128(xmm0, xmm2);
+            xmm1 = _mm_xor_si128(xmm1, xmm3);
+            // Store the result in the destination buffer
+            _mm_storeu_si128(dest_ptr, xmm0);
+            _mm_storeu_si128(dest_ptr + 1, xmm1);
+        }
+    }
+
+    void ssse3_binary16_split_table::region_multiply_subtract(
+        value_type* dest, const value_type* src, value_type constant,
+        uint32_t length) const
+    {
+        // In a binary extension field addition is the same as subtraction
+        region_multiply_add(dest, src, constant, length);
+    }
+
+    uint32_t ssse3_binary16_split_table::alignment() const
+    {
+        return sizeof(value_type);
+    }
+
+    uint32_t ssse3_binary16_split_table::max_alignment() const
+    {
+        return alignment();
+    }
+
+    uint32_t ssse3_binary16_split_table::granularity() const
+    {
+        // We are working over 32 bytes at a time i.e. two 128 bit
+        // registers so we require a length granularity of 16. We expect
+        // that binary16 uses uint16_t as value_type
+        static_assert(std::is_same<value_type, uint16_t>::value,
+                      "Here we expect binary16 to use uint16_t as value_type");
+        return 16U;
+    }
+
+    uint32_t ssse3_binary16_split_table::max_granularity() const
+    {
+        return granularity();
+    }
+
+    bool ssse3_binary16_split_table::enabled() const
+    {
+        static cpuid::cpuinfo info;
+        return info.has_ssse3();
+    }
+
+    void ssse3_binary16_split_table::split_tables(
+        value_type constant, uint8_t* tables) const
+    {
+        assert(tables != 0);
+
+        // Multiplication with the constant is linear, so we first find the
+        // product of the constant with each power of x i.e. with each bit
+        // of the source element
+        value_type bits[16];
+        value_type power = constant;
+
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            bits[i] = power;
+
+            // Multiply by x and reduce by the field polynomial
+            bool high_bit = (power & 0x8000) != 0;
+            power = (value_type)(power << 1);
+
+            if (high_bit)
+            {
+                power ^= binary16::prime;
+            }
+        }
+
+        // The product with a nibble value is the sum of the products with
+        // its bits
+        for (uint32_t k = 0; k < 4; ++k)
+        {
+            for (uint32_t j = 0; j < 16; ++j)
+            {
+                value_type v = 0;
+
+                for (uint32_t b = 0; b < 4; ++b)
+                {
+                    if (j & (1 << b))
+                    {
+                        v ^= bits[k * 4 + b];
+                    }
+                }
+
+                tables[(2 * k) * 16 + j] = v & 0xff;
+                tables[(2 * k + 1) * 16 + j] = v >> 8;
+            }
+        }
+    }
+
+#else
+
+    void ssse3_binary16_split_table::region_add(
+        value_type*, const value_type*, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
+    void ssse3_binary16_split_table::region_subtract(
+        value_type*, const value_type*, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
+    void ssse3_binary16_split_table::region_multiply_constant(
+        value_type*, value_type, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
+    void ssse3_binary16_split_table::region_multiply_add(
+        value_type*, const value_type*, value_type, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
+    void ssse3_binary16_split_table::region_multiply_subtract(
+        value_type*, const value_type*, value_type, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
+    uint32_t ssse3_binary16_split_table::alignment() const
+    {
+        // Not implemented
+        assert(0);
+        return 0;
+    }
+
+    uint32_t ssse3_binary16_split_table::max_alignment() const
+    {
+        // Not implemented
+        assert(0);
+        return 0;
+    }
+
+    uint32_t ssse3_binary16_split_table::granularity() const
+    {
+        // Not implemented
+        assert(0);
+        return 0;
+    }
+
+    uint32_t ssse3_binary16_split_table::max_granularity() const
+    {
+        // Not implemented
+        assert(0);
+        return 0;
+    }
+
+    bool ssse3_binary16_split_table::enabled() const
+    {
+        return false;
+    }
+
+    void ssse3_binary16_split_table::split_tables(
+        value_type, uint8_t*) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
+#endif
+
+}
@@ -0,0 +1,117 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+#include "binary16.hpp"
+#include "region_backend.hpp"
+#include "target_instruction_set.hpp"
+
+namespace fifi
+{
+    /// ssse3_binary16_split_table
+    ///
+    /// Stack implementing SSSE3 SIMD accelerated finite field
+    /// arithmetic for the binary16 field. A full multiplication table
+    /// is not feasible for binary16, instead the multiplication with a
+    /// constant is split into four 4-bit nibbles of the source
+    /// element. For each nibble position two 16-entry tables hold the
+    /// low and high byte of the product, giving eight tables which are
+    /// looked up with _mm_shuffle_epi8. The tables are derived from the
+    /// constant on every call so no per-constant tables are stored.
+    /// The following intrinsics are used available in the following
+    /// SIMD versions:
+    ///
+    /// _mm_loadu_si128 (SSE2)
+    /// _mm_set1_epi8 (SSE2)
+    /// _mm_set1_epi16 (SSE2)
+    /// _mm_and_si128 (SSE2)
+    /// _mm_srli_epi16 (SSE2)
+    /// _mm_srli_epi64 (SSE2)
+    /// _mm_packus_epi16 (SSE2)
+    /// _mm_unpacklo_epi8 (SSE2)
+    /// _mm_unpackhi_epi8 (SSE2)
+    /// _mm_shuffle_epi8 (SSSE3)
+    /// _mm_xor_si128 (SSE2)
+    /// _mm_storeu_si128 (SSE2)
+    ///
+    /// Based on this we see that the minimum required instruction for this
+    /// optimization is the Supplemental Streaming SIMD Extension 3 (SSSE3).
+    class ssse3_binary16_split_table
+    {
+    public:
+
+        /// @copydoc layer::field_type
+        typedef binary16 field_type;
+
+        /// @copydoc layer::value_type
+        typedef binary16::value_type value_type;
+
+        /// True if the build targets SSSE3, in which case the stack is
+        /// known to be enabled @see target_instruction_set
+        static const bool statically_enabled =
+            target_instruction_set::ssse3;
+
+        /// The backend of the stack @see region_backend
+        static const region_backend backend = region_backend::ssse3;
+
+    public:
+
+        /// @copydoc layer::region_add(
+        ///     value_type*, value_type*, uint32_t) const
+        void region_add(
+            value_type* dest, const value_type* src, uint32_t length) const;
+
+        /// @copydoc layer::region_subtract(
+        ///     value_type*, value_type*, uint32_t) const
+        void region_subtract(
+            value_type* dest, const value_type* src, uint32_t length) const;
+
+        /// @copydoc layer::region_multiply_constant(
+        ///      value_type*, value_type, uint32_t) const
+        void region_multiply_constant(
+            value_type* dest, value_type constant, uint32_t length) const;
+
+        /// @copydoc layer::region_multiply_add(
+        ///     value_type*, const value_type*, value_type, uint32_t) const
+        void region_multiply_add(value_type* dest, const value_type* src,
+            value_type constant, uint32_t length) const;
+
+        /// @copydoc layer::region_multiply_subtract(
+        ///     value_type*, const value_type*, value_type, uint32_t) const
+        void region_multiply_subtract(value_type* dest, const value_type* src,
+            value_type constant, uint32_t length) const;
+
+        /// @copydoc layer::alignment() const
+        uint32_t alignment() const;
+
+        /// @copydoc layer::max_alignment() const
+        uint32_t max_alignment() const;
+
+        /// @copydoc layer::granularity() const
+        uint32_t granularity() const;
+
+        /// @copydoc layer::max_granularity() const
+        uint32_t max_granularity() const;
+
+        /// @return true if the executable was built with SSSE3 binary16
+        ///         split table support
+        bool enabled() const;
+
+    private:
+
+        /// Computes the split tables for a constant. The tables are
+        /// stored consecutively with 16 entries each, table 2k holds
+        /// the low byte and table 2k + 1 the high byte of the products
+        /// between the constant and the values of the k'th nibble.
+        ///
+        /// @param constant The constant to compute the tables for
+        /// @param tables Buffer with room for 8 * 16 bytes
+        void split_tables(value_type constant, uint8_t* tables) const;
+    };
+}
@@ -3,6 +3,8 @@
 // See accompanying file LICENSE.rst or
 // http://www.steinwurf.com/licensing
 
+#include <algorithm>
+
 #include <platform/config.hpp>
 #include <cpuid/cpuinfo.hpp>
 
@@ -11,8 +13,7 @@
     #include <x86intrin.h>
 #endif
 
-#include "simple_online_arithmetic.hpp"
-#include "final.hpp"
+#include "field_tables.hpp"
 
 #include "ssse3_binary4_full_table.hpp"
 
@@ -21,28 +22,131 @@ namespace fifi
 
 #ifdef PLATFORM_SSSE3
 
-    ssse3_binary4_full_table::ssse3_binary4_full_table()
+    namespace
     {
-        simple_online_arithmetic<final<binary4>> field;
+        /// The number of sources processed in a single pass over the
+        /// destination. The two look-up tables of each source are kept
+        /// in registers during the pass.
+        const uint32_t sources_per_pass = 4;
+
+        /// Makes a single pass over the destination adding the products
+        /// of the sources and their constants. If overwrite is true the
+        /// destination is not read but set to the sum of the products.
+        ///
+        /// @param dest The destination buffer
+        /// @param srcs Array with Sources pointers to the source buffers
+        /// @param rows_one The table_one rows of the Sources constants
+        /// @param rows_two The table_two rows of the Sources constants
+        /// @param ssse3_size The number of 16 byte blocks to process
+        /// @param overwrite Whether the destination should be overwritten
+        template<uint32_t Sources>
+        inline void linear_combination_pass(uint8_t* dest,
+            const uint8_t* const* srcs, const uint8_t* const* rows_one,
+            const uint8_t* const* rows_two, uint32_t ssse3_size,
+            bool overwrite)
+        {
+            __m128i table1[Sources];
+            __m128i table2[Sources];
 
-        m_table_one.resize(16 * 16);
-        m_table_two.resize(16 * 16);
+            for (uint32_t k = 0; k < Sources; ++k)
+            {
+                table1[k] = _mm_load_si128((const __m128i*)rows_one[k]);
+                table2[k] = _mm_load_si128((const __m128i*)rows_two[k]);
+            }
 
-        assert(((uintptr_t) &m_table_one[0] % 16) == 0);
-        assert(((uintptr_t) &m_table_two[0] % 16) == 0);
+            // Create low and high bitmasks by replicating the mask values
+            // 16 times
+            __m128i mask1 = _mm_set1_epi8((char)0x0f);
+            __m128i mask2 = _mm_set1_epi8((char)0xf0);
+
+            __m128i* dest_ptr = (__m128i*)dest;
+            for (uint32_t i = 0; i < ssse3_size; i++, dest_ptr++)
+            {
+                // Start from zero or from the sum of the previous passes
+                __m128i xmm0 = overwrite ?
+                    _mm_setzero_si128() : _mm_loadu_si128(dest_ptr);
+
+                for (uint32_t k = 0; k < Sources; ++k)
+                {
+                    // Load the next 16-bytes of the k'th source buffer
+                    __m128i xmm1 = _mm_loadu_si128((const __m128i*)srcs[k] + i);
+                    // Multiply the low-half and the high-half of the data
+                    __m128i l = _mm_and_si128(xmm1, mask1);
+                    l = _mm_shuffle_epi8(table1[k], l);
+                    __m128i h = _mm_and_si128(xmm1, mask2);
+                    h = _mm_srli_epi64(h, 4);
+                    h = _mm_shuffle_epi8(table2[k], h);
+                    // Add the product to the sum kept in the register
+                    xmm0 = _mm_xor_si128(xmm0, _mm_xor_si128(h, l));
+                }
+
+                // Store the sum in the destination buffer
+                _mm_storeu_si128(dest_ptr, xmm0);
+            }
+        }
 
-        for (uint32_t i = 0; i < 16; ++i)
+        /// The number of destinations updated in a single pass over the
+        /// source. The two look-up tables of each destination are kept
+        /// in registers during the pass.
+        const uint32_t dests_per_pass = 4;
+
+        /// Makes a single pass over the source adding its products with
+        /// the constants of the Dests destinations to these.
+        ///
+        /// @param dests Array with Dests pointers to the destination buffers
+        /// @param src The source buffer
+        /// @param rows_one The table_one rows of the Dests constants
+        /// @param rows_two The table_two rows of the Dests constants
+        /// @param ssse3_size The number of 16 byte blocks to process
+        template<uint32_t Dests>
+        inline void multiply_add_many_pass(uint8_t* const* dests,
+            const uint8_t* src, const uint8_t* const* rows_one,
+            const uint8_t* const* rows_two, uint32_t ssse3_size)
         {
-            for (uint32_t j = 0; j < 16; ++j)
+            __m128i table1[Dests];
+            __m128i table2[Dests];
+
+            for (uint32_t k = 0; k < Dests; ++k)
             {
-                auto v = field.multiply(i, j);
+                table1[k] = _mm_load_si128((const __m128i*)rows_one[k]);
+                table2[k] = _mm_load_si128((const __m128i*)rows_two[k]);
+            }
 
-                m_table_one[i * 16 + j] = v & 0x0f;
-                m_table_two[i * 16 + j] = (v << 4) & 0xf0;
+            // Create low and high bitmasks by replicating the mask values
+            // 16 times
+            __m128i mask1 = _mm_set1_epi8((char)0x0f);
+            __m128i mask2 = _mm_set1_epi8((char)0xf0);
+
+            const __m128i* src_ptr = (const __m128i*)src;
+            for (uint32_t i = 0; i < ssse3_size; i++, src_ptr++)
+            {
+                // Load the next 16-bytes of the source buffer and split
+                // it in the low-half and the high-half only once
+                __m128i xmm0 = _mm_loadu_si128(src_ptr);
+                __m128i l = _mm_and_si128(xmm0, mask1);
+                __m128i h = _mm_and_si128(xmm0, mask2);
+                h = _mm_srli_epi64(h, 4);
+
+                for (uint32_t k = 0; k < Dests; ++k)
+                {
+                    // Multiply the source with the k'th constant
+                    __m128i p = _mm_xor_si128(
+                        _mm_shuffle_epi8(table1[k], l),
+                        _mm_shuffle_epi8(table2[k], h));
+                    // Add the product to the k'th destination buffer
+                    __m128i* dest_ptr = (__m128i*)dests[k] + i;
+                    __m128i xmm1 = _mm_loadu_si128(dest_ptr);
+                    _mm_storeu_si128(dest_ptr, _mm_xor_si128(xmm1, p));
+                }
             }
         }
     }
 
+    ssse3_binary4_full_table::ssse3_binary4_full_table()
+        : m_table_one(field_tables<binary4>::simd_table_one()),
+          m_table_two(field_tables<binary4>::simd_table_two())
+    { }
+
     void ssse3_binary4_full_table::region_add(
         value_type* dest, const value_type* src, uint32_t length) const
     {
@@ -196,6 +300,124 @@ namespace fifi
         region_multiply_add(dest, src, constant, length);
     }
 
+    void ssse3_binary4_full_table::region_linear_combination(value_type* dest,
+        const value_type* const* srcs, const value_type* constants,
+        uint32_t count, uint32_t length) const
+    {
+        assert(dest != 0);
+        assert(srcs != 0);
+        assert(constants != 0);
+        assert(count > 0);
+        assert(length > 0);
+        assert((length % granularity()) == 0);
+
+        // We loop 16 bytes at-a-time so we calculate how many loops we need
+        uint32_t ssse3_size = length / granularity();
+        assert(ssse3_size > 0);
+
+        // The sources are processed in blocks, so the destination is
+        // only loaded and stored once per block instead of once per
+        // source
+        for (uint32_t j = 0; j < count; j += sources_per_pass)
+        {
+            uint32_t sources = std::min(count - j, sources_per_pass);
+
+            const uint8_t* rows_one[sources_per_pass];
+            const uint8_t* rows_two[sources_per_pass];
+
+            for (uint32_t k = 0; k < sources; ++k)
+            {
+                // The constant is packed, so we need just either the high
+                // or low 4 bits to get constant value
+                value_type constant = constants[j + k] & 0xf;
+                rows_one[k] = &m_table_one[0] + (constant * 16);
+                rows_two[k] = &m_table_two[0] + (constant * 16);
+            }
+
+            bool overwrite = (j == 0);
+
+            switch (sources)
+            {
+            case 4:
+                linear_combination_pass<4>(dest, srcs + j, rows_one,
+                    rows_two, ssse3_size, overwrite);
+                break;
+            case 3:
+                linear_combination_pass<3>(dest, srcs + j, rows_one,
+                    rows_two, ssse3_size, overwrite);
+                break;
+            case 2:
+                linear_combination_pass<2>(dest, srcs + j, rows_one,
+                    rows_two, ssse3_size, overwrite);
+                break;
+            case 1:
+                linear_combination_pass<1>(dest, srcs + j, rows_one,
+                    rows_two, ssse3_size, overwrite);
+                break;
+            default:
+                assert(0);
+            }
+        }
+    }
+
+    void ssse3_binary4_full_table::region_multiply_add_many(
+        value_type* const* dests, const value_type* src,
+        const value_type* constants, uint32_t count, uint32_t length) const
+    {
+        assert(dests != 0);
+        assert(src != 0);
+        assert(constants != 0);
+        assert(count > 0);
+        assert(length > 0);
+        assert((length % granularity()) == 0);
+
+        // We loop 16 bytes at-a-time so we calculate how many loops we need
+        uint32_t ssse3_size = length / granularity();
+        assert(ssse3_size > 0);
+
+        // The destinations are processed in blocks, so the source is
+        // only loaded and split once per block instead of once per
+        // destination
+        for (uint32_t j = 0; j < count; j += dests_per_pass)
+        {
+            uint32_t destinations = std::min(count - j, dests_per_pass);
+
+            const uint8_t* rows_one[dests_per_pass];
+            const uint8_t* rows_two[dests_per_pass];
+
+            for (uint32_t k = 0; k < destinations; ++k)
+            {
+                // The constant is packed, so we need just either the high
+                // or low 4 bits to get constant value
+                value_type constant = constants[j + k] & 0xf;
+                rows_one[k] = &m_table_one[0] + (constant * 16);
+                rows_two[k] = &m_table_two[0] + (constant * 16);
+            }
+
+            switch (destinations)
+            {
+            case 4:
+                multiply_add_many_pass<4>(dests + j, src, rows_one,
+                    rows_two, ssse3_size);
+                break;
+            case 3:
+                multiply_add_many_pass<3>(dests + j, src, rows_one,
+                    rows_two, ssse3_size);
+                break;
+            case 2:
+                multiply_add_many_pass<2>(dests + j, src, rows_one,
+                    rows_two, ssse3_size);
+                break;
+            case 1:
+                multiply_add_many_pass<1>(dests + j, src, rows_one,
+                    rows_two, ssse3_size);
+                break;
+            default:
+                assert(0);
+            }
+        }
+    }
+
 
     uint32_t ssse3_binary4_full_table::alignment() const
     {
@@ -231,6 +453,8 @@ namespace fifi
 #else
 
     ssse3_binary4_full_table::ssse3_binary4_full_table()
+        : m_table_one(0),
+          m_table_two(0)
     { }
 
     void ssse3_binary4_full_table::region_add(
@@ -268,6 +492,20 @@ namespace fifi
         assert(0);
     }
 
+    void ssse3_binary4_full_table::region_linear_combination(value_type*,
+        const value_type* const*, const value_type*, uint32_t, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
+    void ssse3_binary4_full_table::region_multiply_add_many(value_type* const*,
+        const value_type*, const value_type*, uint32_t, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
     uint32_t ssse3_binary4_full_table::alignment() const
     {
         // Not implemented
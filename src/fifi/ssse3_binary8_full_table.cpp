@@ -3,6 +3,9 @@
 // See accompanying file LICENSE.rst or
 // http://www.steinwurf.com/licensing
 
+#include <algorithm>
+#include <cstdint>
+
 #include <platform/config.hpp>
 #include <cpuid/cpuinfo.hpp>
 
@@ -11,8 +14,7 @@
     #include <x86intrin.h>
 #endif
 
-#include "simple_online_arithmetic.hpp"
-#include "final.hpp"
+#include "field_tables.hpp"
 
 #include "ssse3_binary8_full_table.hpp"
 
@@ -21,32 +23,200 @@ namespace fifi
 
 #ifdef PLATFORM_SSSE3
 
-    ssse3_binary8_full_table::ssse3_binary8_full_table()
+    namespace
     {
-        simple_online_arithmetic<final<binary8>> field;
+        /// The number of sources processed in a single pass over the
+        /// destination. The two look-up tables of each source are kept
+        /// in registers during the pass.
+        const uint32_t sources_per_pass = 4;
+
+        /// Makes a single pass over the destination adding the products
+        /// of the sources and their constants. If overwrite is true the
+        /// destination is not read but set to the sum of the products.
+        ///
+        /// @param dest The destination buffer
+        /// @param srcs Array with Sources pointers to the source buffers
+        /// @param rows_one The table_one rows of the Sources constants
+        /// @param rows_two The table_two rows of the Sources constants
+        /// @param ssse3_size The number of 16 byte blocks to process
+        /// @param overwrite Whether the destination should be overwritten
+        template<uint32_t Sources>
+        inline void linear_combination_pass(uint8_t* dest,
+            const uint8_t* const* srcs, const uint8_t* const* rows_one,
+            const uint8_t* const* rows_two, uint32_t ssse3_size,
+            bool overwrite)
+        {
+            __m128i table1[Sources];
+            __m128i table2[Sources];
+
+            for (uint32_t k = 0; k < Sources; ++k)
+            {
+                table1[k] = _mm_load_si128((const __m128i*)rows_one[k]);
+                table2[k] = _mm_load_si128((const __m128i*)rows_two[k]);
+            }
 
-        m_table_one.resize(256 * 16);
-        m_table_two.resize(256 * 16);
+            // Create low and high bitmasks by replicating the mask values
+            // 16 times
+            __m128i mask1 = _mm_set1_epi8((char)0x0f);
+            __m128i mask2 = _mm_set1_epi8((char)0xf0);
 
-        assert(((uintptr_t) &m_table_one[0] % 16) == 0);
-        assert(((uintptr_t) &m_table_two[0] % 16) == 0);
+            __m128i* dest_ptr = (__m128i*)dest;
+            for (uint32_t i = 0; i < ssse3_size; i++, dest_ptr++)
+            {
+                // Start from zero or from the sum of the previous passes
+                __m128i xmm0 = overwrite ?
+                    _mm_setzero_si128() : _mm_loadu_si128(dest_ptr);
+
+                for (uint32_t k = 0; k < Sources; ++k)
+                {
+                    // Load the next 16-bytes of the k'th source buffer
+                    __m128i xmm1 = _mm_loadu_si128((const __m128i*)srcs[k] + i);
+                    // Multiply the low-half and the high-half of the data
+                    __m128i l = _mm_and_si128(xmm1, mask1);
+                    l = _mm_shuffle_epi8(table1[k], l);
+                    __m128i h = _mm_and_si128(xmm1, mask2);
+                    h = _mm_srli_epi64(h, 4);
+                    h = _mm_shuffle_epi8(table2[k], h);
+                    // Add the product to the sum kept in the register
+                    xmm0 = _mm_xor_si128(xmm0, _mm_xor_si128(h, l));
+                }
+
+                // Store the sum in the destination buffer
+                _mm_storeu_si128(dest_ptr, xmm0);
+            }
+        }
 
-        // Iterate over all elements in the field
-        for (uint32_t i = 0; i < 256; ++i)
+        /// The number of destinations updated in a single pass over the
+        /// source. The two look-up tables of each destination are kept
+        /// in registers during the pass.
+        const uint32_t dests_per_pass = 4;
+
+        /// Makes a single pass over the source adding its products with
+        /// the constants of the Dests destinations to these.
+        ///
+        /// @param dests Array with Dests pointers to the destination buffers
+        /// @param src The source buffer
+        /// @param rows_one The table_one rows of the Dests constants
+        /// @param rows_two The table_two rows of the Dests constants
+        /// @param ssse3_size The number of 16 byte blocks to process
+        template<uint32_t Dests>
+        inline void multiply_add_many_pass(uint8_t* const* dests,
+            const uint8_t* src, const uint8_t* const* rows_one,
+            const uint8_t* const* rows_two, uint32_t ssse3_size)
         {
-            // Only take the constants whose first 4 bits are zero
-            for (uint32_t j = 0; j < 16; ++j)
+            __m128i table1[Dests];
+            __m128i table2[Dests];
+
+            for (uint32_t k = 0; k < Dests; ++k)
+            {
+                table1[k] = _mm_load_si128((const __m128i*)rows_one[k]);
+                table2[k] = _mm_load_si128((const __m128i*)rows_two[k]);
+            }
+
+            // Create low and high bitmasks by replicating the mask values
+            // 16 times
+            __m128i mask1 = _mm_set1_epi8((char)0x0f);
+            __m128i mask2 = _mm_set1_epi8((char)0xf0);
+
+            const __m128i* src_ptr = (const __m128i*)src;
+            for (uint32_t i = 0; i < ssse3_size; i++, src_ptr++)
             {
-                // Calculate 8-bit product with the low-half
-                auto v1 = field.multiply(i, j);
-                m_table_one[i * 16 + j] = v1;
-                // Calculate 8-bit product with the high-half
-                auto v2 = field.multiply(i, j << 4);
-                m_table_two[i * 16 + j] = v2;
+                // Load the next 16-bytes of the source buffer and split
+                // it in the low-half and the high-half only once
+                __m128i xmm0 = _mm_loadu_si128(src_ptr);
+                __m128i l = _mm_and_si128(xmm0, mask1);
+                __m128i h = _mm_and_si128(xmm0, mask2);
+                h = _mm_srli_epi64(h, 4);
+
+                for (uint32_t k = 0; k < Dests; ++k)
+                {
+                    // Multiply the source with the k'th constant
+                    __m128i p = _mm_xor_si128(
+                        _mm_shuffle_epi8(table1[k], l),
+                        _mm_shuffle_epi8(table2[k], h));
+                    // Add the product to the k'th destination buffer
+                    __m128i* dest_ptr = (__m128i*)dests[k] + i;
+                    __m128i xmm1 = _mm_loadu_si128(dest_ptr);
+                    _mm_storeu_si128(dest_ptr, _mm_xor_si128(xmm1, p));
+                }
             }
         }
+
+        /// The distance in bytes ahead of the current position at which
+        /// the data is prefetched by the streaming passes
+        const uint32_t prefetch_distance = 512;
+
+        /// @param dest The destination buffer
+        /// @return True if the destination can be written with
+        ///         non-temporal stores, which require 16 byte alignment
+        inline bool is_stream_aligned(const uint8_t* dest)
+        {
+            return ((uintptr_t)dest & 15) == 0;
+        }
+
+        /// Makes a pass multiplying the source with a constant and
+        /// writing the products, or adding them if Add is true, to the
+        /// destination with non-temporal stores. The source is
+        /// prefetched one cache line at a time ahead of the pass.
+        ///
+        /// @param dest The 16 byte aligned destination buffer
+        /// @param src The source buffer, may be the destination
+        /// @param table1 The table_one row of the constant
+        /// @param table2 The table_two row of the constant
+        /// @param ssse3_size The number of 16 byte blocks to process
+        template<bool Add>
+        inline void multiply_stream_pass(uint8_t* dest, const uint8_t* src,
+            __m128i table1, __m128i table2, uint32_t ssse3_size)
+        {
+            assert(is_stream_aligned(dest));
+
+            // Create low and high bitmasks by replicating the mask values
+            // 16 times
+            __m128i mask1 = _mm_set1_epi8((char)0x0f);
+            __m128i mask2 = _mm_set1_epi8((char)0xf0);
+
+            const __m128i* src_ptr = (const __m128i*)src;
+            __m128i* dest_ptr = (__m128i*)dest;
+            for (uint32_t i = 0; i < ssse3_size; i++, src_ptr++, dest_ptr++)
+            {
+                // Prefetch once per 64 byte cache line, prefetching past
+                // the end of the buffer is harmless. The non-temporal
+                // hint is not used since it made the pass slower.
+                if ((i & 3) == 0)
+                {
+                    _mm_prefetch((const char*)src_ptr + prefetch_distance,
+                        _MM_HINT_T0);
+                }
+
+                // Multiply the next 16-bytes of the source with the
+                // constant
+                __m128i xmm0 = _mm_loadu_si128(src_ptr);
+                __m128i l = _mm_and_si128(xmm0, mask1);
+                l = _mm_shuffle_epi8(table1, l);
+                __m128i h = _mm_and_si128(xmm0, mask2);
+                h = _mm_srli_epi64(h, 4);
+                h = _mm_shuffle_epi8(table2, h);
+                xmm0 = _mm_xor_si128(h, l);
+
+                if (Add)
+                {
+                    xmm0 = _mm_xor_si128(xmm0, _mm_load_si128(dest_ptr));
+                }
+
+                // Write the result around the cache
+                _mm_stream_si128(dest_ptr, xmm0);
+            }
+
+            // Make the non-temporal stores visible before returning
+            _mm_sfence();
+        }
     }
 
+    ssse3_binary8_full_table::ssse3_binary8_full_table()
+        : m_table_one(field_tables<binary8>::simd_table_one()),
+          m_table_two(field_tables<binary8>::simd_table_two())
+    { }
+
     void ssse3_binary8_full_table::region_add(
         value_type* dest, const value_type* src, uint32_t length) const
     {
@@ -185,6 +355,54 @@ namespace fifi
         }
     }
 
+    void ssse3_binary8_full_table::region_multiply_constant_stream(
+        value_type* dest, value_type constant, uint32_t length) const
+    {
+        assert(dest != 0);
+        assert(length > 0);
+        assert((length % granularity()) == 0);
+
+        if (!is_stream_aligned(dest))
+        {
+            region_multiply_constant(dest, constant, length);
+            return;
+        }
+
+        // Load the look-up table rows of the constant
+        __m128i table1 = _mm_load_si128(
+            (const __m128i*)(&m_table_one[0] + (constant * 16)));
+        __m128i table2 = _mm_load_si128(
+            (const __m128i*)(&m_table_two[0] + (constant * 16)));
+
+        multiply_stream_pass<false>(
+            dest, dest, table1, table2, length / granularity());
+    }
+
+    void ssse3_binary8_full_table::region_multiply_add_stream(
+        value_type* dest, const value_type* src, value_type constant,
+        uint32_t length) const
+    {
+        assert(dest != 0);
+        assert(src != 0);
+        assert(length > 0);
+        assert((length % granularity()) == 0);
+
+        if (!is_stream_aligned(dest))
+        {
+            region_multiply_add(dest, src, constant, length);
+            return;
+        }
+
+        // Load the look-up table rows of the constant
+        __m128i table1 = _mm_load_si128(
+            (const __m128i*)(&m_table_one[0] + (constant * 16)));
+        __m128i table2 = _mm_load_si128(
+            (const __m128i*)(&m_table_two[0] + (constant * 16)));
+
+        multiply_stream_pass<true>(
+            dest, src, table1, table2, length / granularity());
+    }
+
     void ssse3_binary8_full_table::region_multiply_subtract(value_type* dest,
         const value_type* src, value_type constant, uint32_t length) const
     {
@@ -192,6 +410,120 @@ namespace fifi
         region_multiply_add(dest, src, constant, length);
     }
 
+    void ssse3_binary8_full_table::region_linear_combination(value_type* dest,
+        const value_type* const* srcs, const value_type* constants,
+        uint32_t count, uint32_t length) const
+    {
+        assert(dest != 0);
+        assert(srcs != 0);
+        assert(constants != 0);
+        assert(count > 0);
+        assert(length > 0);
+        assert((length % granularity()) == 0);
+
+        // We loop 16 bytes at-a-time so we calculate how many loops we need
+        uint32_t ssse3_size = length / granularity();
+        assert(ssse3_size > 0);
+
+        // The sources are processed in blocks, so the destination is
+        // only loaded and stored once per block instead of once per
+        // source
+        for (uint32_t j = 0; j < count; j += sources_per_pass)
+        {
+            uint32_t sources = std::min(count - j, sources_per_pass);
+
+            const uint8_t* rows_one[sources_per_pass];
+            const uint8_t* rows_two[sources_per_pass];
+
+            for (uint32_t k = 0; k < sources; ++k)
+            {
+                value_type constant = constants[j + k];
+                rows_one[k] = &m_table_one[0] + (constant * 16);
+                rows_two[k] = &m_table_two[0] + (constant * 16);
+            }
+
+            bool overwrite = (j == 0);
+
+            switch (sources)
+            {
+            case 4:
+                linear_combination_pass<4>(dest, srcs + j, rows_one,
+                    rows_two, ssse3_size, overwrite);
+                break;
+            case 3:
+                linear_combination_pass<3>(dest, srcs + j, rows_one,
+                    rows_two, ssse3_size, overwrite);
+                break;
+            case 2:
+                linear_combination_pass<2>(dest, srcs + j, rows_one,
+                    rows_two, ssse3_size, overwrite);
+                break;
+            case 1:
+                linear_combination_pass<1>(dest, srcs + j, rows_one,
+                    rows_two, ssse3_size, overwrite);
+                break;
+            default:
+                assert(0);
+            }
+        }
+    }
+
+    void ssse3_binary8_full_table::region_multiply_add_many(
+        value_type* const* dests, const value_type* src,
+        const value_type* constants, uint32_t count, uint32_t length) const
+    {
+        assert(dests != 0);
+        assert(src != 0);
+        assert(constants != 0);
+        assert(count > 0);
+        assert(length > 0);
+        assert((length % granularity()) == 0);
+
+        // We loop 16 bytes at-a-time so we calculate how many loops we need
+        uint32_t ssse3_size = length / granularity();
+        assert(ssse3_size > 0);
+
+        // The destinations are processed in blocks, so the source is
+        // only loaded and split once per block instead of once per
+        // destination
+        for (uint32_t j = 0; j < count; j += dests_per_pass)
+        {
+            uint32_t destinations = std::min(count - j, dests_per_pass);
+
+            const uint8_t* rows_one[dests_per_pass];
+            const uint8_t* rows_two[dests_per_pass];
+
+            for (uint32_t k = 0; k < destinations; ++k)
+            {
+                value_type constant = constants[j + k];
+                rows_one[k] = &m_table_one[0] + (constant * 16);
+                rows_two[k] = &m_table_two[0] + (constant * 16);
+            }
+
+            switch (destinations)
+            {
+            case 4:
+                multiply_add_many_pass<4>(dests + j, src, rows_one,
+                    rows_two, ssse3_size);
+                break;
+            case 3:
+                multiply_add_many_pass<3>(dests + j, src, rows_one,
+                    rows_two, ssse3_size);
+                break;
+            case 2:
+                multiply_add_many_pass<2>(dests + j, src, rows_one,
+                    rows_two, ssse3_size);
+                break;
+            case 1:
+                multiply_add_many_pass<1>(dests + j, src, rows_one,
+                    rows_two, ssse3_size);
+                break;
+            default:
+                assert(0);
+            }
+        }
+    }
+
 
     uint32_t ssse3_binary8_full_table::alignment() const
     {
@@ -227,6 +559,8 @@ namespace fifi
 #else
 
     ssse3_binary8_full_table::ssse3_binary8_full_table()
+        : m_table_one(0),
+          m_table_two(0)
     { }
 
     void ssse3_binary8_full_table::region_add(
@@ -257,6 +591,20 @@ namespace fifi
         assert(0);
     }
 
+    void ssse3_binary8_full_table::region_multiply_constant_stream(
+        value_type*, value_type, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
+    void ssse3_binary8_full_table::region_multiply_add_stream(
+        value_type*, const value_type*, value_type, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
     void ssse3_binary8_full_table::region_multiply_subtract(
         value_type*, const value_type*, value_type, uint32_t) const
     {
@@ -264,6 +612,20 @@ namespace fifi
         assert(0);
     }
 
+    void ssse3_binary8_full_table::region_linear_combination(value_type*,
+        const value_type* const*, const value_type*, uint32_t, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
+    void ssse3_binary8_full_table::region_multiply_add_many(value_type* const*,
+        const value_type*, const value_type*, uint32_t, uint32_t) const
+    {
+        // Not implemented
+        assert(0);
+    }
+
     uint32_t ssse3_binary8_full_table::alignment() const
     {
         // Not implemented
@@ -7,11 +7,10 @@
 
 #include <cassert>
 #include <cstdint>
-#include <vector>
-
-#include <sak/aligned_allocator.hpp>
 
 #include "binary8.hpp"
+#include "region_backend.hpp"
+#include "target_instruction_set.hpp"
 
 namespace fifi
 {
@@ -23,11 +22,15 @@ namespace fifi
     ///
     /// _mm_load_si128 (SSE2)
     /// _mm_set1_epi8 (SSE2)
+    /// _mm_setzero_si128 (SSE2)
     /// _mm_and_si128 (SSE2)
     /// _mm_shuffle_epi8 (SSSE3)
     /// _mm_srli_epi64 (SSE2)
     /// _mm_xor_si128 (SSE2)
     /// _mm_store_si128 (SSE2)
+    /// _mm_stream_si128 (SSE2)
+    /// _mm_prefetch (SSE)
+    /// _mm_sfence (SSE)
     ///
     /// Based on this we see that the minimum required instruction for this
     /// optimization is the Supplemental Streaming SIMD Extension 3 (SSSE3).
@@ -41,6 +44,14 @@ namespace fifi
         /// @copydoc layer::value_type
         typedef binary8::value_type value_type;
 
+        /// True if the build targets SSSE3, in which case the stack is
+        /// known to be enabled @see target_instruction_set
+        static const bool statically_enabled =
+            target_instruction_set::ssse3;
+
+        /// The backend of the stack @see region_backend
+        static const region_backend backend = region_backend::ssse3;
+
     public:
 
         /// Constructor for the stack
@@ -66,11 +77,53 @@ namespace fifi
         void region_multiply_add(value_type* dest, const value_type* src,
             value_type constant, uint32_t length) const;
 
+        /// Multiplies the destination with a constant like
+        /// region_multiply_constant(), but writes the results with
+        /// non-temporal stores and prefetches the data ahead. The results
+        /// bypass the cache, so the look-up tables and other hot data are
+        /// not evicted by huge buffers which are not read again soon. If
+        /// the destination is not 16 byte aligned the regular stores are
+        /// used.
+        ///
+        /// The streaming variants are not chosen automatically, since the
+        /// destination is also read, and the call itself is typically
+        /// slower than with the regular stores. They pay off when the
+        /// caller's working set would otherwise be evicted.
+        ///
+        /// @copydoc layer::region_multiply_constant(
+        ///      value_type*, value_type, uint32_t) const
+        void region_multiply_constant_stream(
+            value_type* dest, value_type constant, uint32_t length) const;
+
+        /// Like region_multiply_add(), but writes the results with
+        /// non-temporal stores and prefetches the source ahead
+        /// @see region_multiply_constant_stream()
+        ///
+        /// @copydoc layer::region_multiply_add(
+        ///     value_type*, const value_type*, value_type, uint32_t) const
+        void region_multiply_add_stream(value_type* dest,
+            const value_type* src, value_type constant,
+            uint32_t length) const;
+
         /// @copydoc layer::region_multiply_subtract(
         ///     value_type*, const value_type*, value_type, uint32_t) const
         void region_multiply_subtract(value_type* dest, const value_type* src,
             value_type constant, uint32_t length) const;
 
+        /// @copydoc layer::region_linear_combination(value_type*,
+        ///     const value_type* const*, const value_type*, uint32_t,
+        ///     uint32_t) const
+        void region_linear_combination(value_type* dest,
+            const value_type* const* srcs, const value_type* constants,
+            uint32_t count, uint32_t length) const;
+
+        /// @copydoc layer::region_multiply_add_many(value_type* const*,
+        ///     const value_type*, const value_type*, uint32_t,
+        ///     uint32_t) const
+        void region_multiply_add_many(value_type* const* dests,
+            const value_type* src, const value_type* constants,
+            uint32_t count, uint32_t length) const;
+
         /// @copydoc layer::alignment() const
         uint32_t alignment() const;
 
@@ -89,14 +142,10 @@ namespace fifi
 
     private:
 
-        /// The storage type
-        typedef std::vector<uint8_t, sak::aligned_allocator<uint8_t>>
-            aligned_vector;
-
-        /// Storage for the high 4 bit multiplication table
-        aligned_vector m_table_one;
+        /// Pointer to the generated low 4 bit multiplication table
+        const uint8_t* m_table_one;
 
-        /// Storage for the low 4 bit multiplication table
-        aligned_vector m_table_two;
+        /// Pointer to the generated high 4 bit multiplication table
+        const uint8_t* m_table_two;
     };
 }
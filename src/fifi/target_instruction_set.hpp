@@ -0,0 +1,67 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <platform/config.hpp>
+
+namespace fifi
+{
+    /// Describes the instruction sets which the build targets, i.e. the
+    /// instruction sets which the compiler may use everywhere e.g. due to
+    /// the -mssse3, -mavx2 or -mfpu=neon flags. A CPU running the code
+    /// is required to support these, so the SIMD stacks using them are
+    /// known to be enabled at compile-time.
+    ///
+    /// If the build targets SSSE3, AVX2 or NEON the stacks dispatch at
+    /// compile-time, @see region_static_dispatcher_specialization.
+    /// Otherwise the stacks use the portable run-time dispatch
+    /// @see region_dispatcher_specialization. The run-time dispatch can
+    /// be forced by defining FIFI_RUNTIME_DISPATCH.
+    struct target_instruction_set
+    {
+#if defined(PLATFORM_SSSE3)
+        /// True if the build targets SSSE3
+        static const bool ssse3 = true;
+#else
+        static const bool ssse3 = false;
+#endif
+
+#if defined(PLATFORM_SSE41)
+        /// True if the build targets SSE4.1
+        static const bool sse41 = true;
+#else
+        static const bool sse41 = false;
+#endif
+
+#if defined(PLATFORM_PCLMUL)
+        /// True if the build targets PCLMULQDQ
+        static const bool pclmul = true;
+#else
+        static const bool pclmul = false;
+#endif
+
+#if defined(PLATFORM_AVX2)
+        /// True if the build targets AVX2
+        static const bool avx2 = true;
+#else
+        static const bool avx2 = false;
+#endif
+
+#if defined(PLATFORM_NEON)
+        /// True if the build targets NEON
+        static const bool neon = true;
+#else
+        static const bool neon = false;
+#endif
+
+#if defined(FIFI_RUNTIME_DISPATCH)
+        /// True if the stacks should dispatch at compile-time
+        static const bool static_dispatch = false;
+#else
+        static const bool static_dispatch = ssse3 || avx2 || neon;
+#endif
+    };
+}
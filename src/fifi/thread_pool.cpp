@@ -0,0 +1,125 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <cassert>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "thread_pool.hpp"
+
+namespace fifi
+{
+    thread_pool::thread_pool(uint32_t threads) :
+        m_task(0),
+        m_tasks(0),
+        m_next(0),
+        m_generation(0),
+        m_open(false),
+        m_active(0),
+        m_stop(false)
+    {
+        assert(threads > 0);
+
+        for (uint32_t i = 1; i < threads; ++i)
+        {
+            m_workers.emplace_back(&thread_pool::work, this);
+        }
+    }
+
+    thread_pool::~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+
+        m_start.notify_all();
+
+        for (auto& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    uint32_t thread_pool::threads() const
+    {
+        return (uint32_t) m_workers.size() + 1;
+    }
+
+    void thread_pool::run(uint32_t tasks, const task_type& task)
+    {
+        std::lock_guard<std::mutex> run_lock(m_run_mutex);
+
+        if (m_workers.empty() || tasks <= 1)
+        {
+            for (uint32_t i = 0; i < tasks; ++i)
+            {
+                task(i);
+            }
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_task = &task;
+            m_tasks = tasks;
+            m_next = 0;
+            m_open = true;
+            ++m_generation;
+        }
+
+        m_start.notify_all();
+
+        execute();
+
+        // All tasks are taken, so workers joining from now on would have
+        // nothing to do. Once the joined workers have left all tasks have
+        // returned and the job can be changed.
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_open = false;
+        m_done.wait(lock, [this] { return m_active == 0; });
+    }
+
+    void thread_pool::work()
+    {
+        uint64_t generation = 0;
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        while (true)
+        {
+            m_start.wait(lock, [this, generation]
+            {
+                return m_stop || (m_open && m_generation != generation);
+            });
+
+            if (m_stop)
+            {
+                return;
+            }
+
+            generation = m_generation;
+            ++m_active;
+
+            lock.unlock();
+            execute();
+            lock.lock();
+
+            if (--m_active == 0)
+            {
+                m_done.notify_one();
+            }
+        }
+    }
+
+    void thread_pool::execute()
+    {
+        for (uint32_t i = m_next++; i < m_tasks; i = m_next++)
+        {
+            (*m_task)(i);
+        }
+    }
+}
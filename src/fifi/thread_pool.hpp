@@ -0,0 +1,105 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fifi
+{
+    /// A fixed number of threads which run the tasks of a job in
+    /// parallel, @see region_parallel. The thread calling run() takes
+    /// part in the job, so a pool of N threads starts N - 1 worker
+    /// threads and a pool of one thread runs all tasks on the calling
+    /// thread.
+    ///
+    /// Jobs are run one at a time, calls to run() from different threads
+    /// wait for each other.
+    class thread_pool
+    {
+    public:
+
+        /// The task of a job, called with the index of the task
+        typedef std::function<void(uint32_t)> task_type;
+
+    public:
+
+        /// @param threads The number of threads including the thread
+        ///        calling run(), must be at least one
+        explicit thread_pool(uint32_t threads);
+
+        /// Stops and joins the worker threads
+        ~thread_pool();
+
+        /// @return The number of threads including the thread calling
+        ///         run()
+        uint32_t threads() const;
+
+        /// Calls the task once for each index from zero to tasks - 1
+        /// using all threads of the pool and returns when all calls
+        /// have returned. The order of the calls is undefined.
+        ///
+        /// @param tasks The number of tasks
+        /// @param task The task to call
+        void run(uint32_t tasks, const task_type& task);
+
+    private:
+
+        thread_pool(const thread_pool&);
+        thread_pool& operator=(const thread_pool&);
+
+        /// The loop of the worker threads
+        void work();
+
+        /// Calls the task of the current job until all tasks are taken
+        void execute();
+
+    private:
+
+        /// The worker threads
+        std::vector<std::thread> m_workers;
+
+        /// Allows only one job at a time
+        std::mutex m_run_mutex;
+
+        /// Protects the state of the current job
+        std::mutex m_mutex;
+
+        /// Signals the workers that a job has started or that the pool
+        /// is stopping
+        std::condition_variable m_start;
+
+        /// Signals run() that the last worker has left the job
+        std::condition_variable m_done;
+
+        /// The task of the current job
+        const task_type* m_task;
+
+        /// The number of tasks of the current job
+        uint32_t m_tasks;
+
+        /// The index of the next task to call
+        std::atomic<uint32_t> m_next;
+
+        /// Incremented for every job, so a worker joins each job once
+        uint64_t m_generation;
+
+        /// True while workers can join the current job
+        bool m_open;
+
+        /// The number of workers which have joined the current job and
+        /// not yet left it
+        uint32_t m_active;
+
+        /// True when the workers should stop
+        bool m_stop;
+    };
+}
@@ -0,0 +1,164 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <cassert>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "work_stealing_scheduler.hpp"
+
+namespace fifi
+{
+    work_stealing_scheduler::work_stealing_scheduler(uint32_t threads) :
+        m_queued(0),
+        m_next_queue(0),
+        m_stop(false)
+    {
+        assert(threads > 0);
+
+        for (uint32_t i = 0; i < threads; ++i)
+        {
+            m_queues.emplace_back(new queue());
+        }
+
+        for (uint32_t i = 0; i < threads; ++i)
+        {
+            m_workers.emplace_back(&work_stealing_scheduler::work, this, i);
+        }
+    }
+
+    work_stealing_scheduler::~work_stealing_scheduler()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+
+        m_condition.notify_all();
+
+        for (auto& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    uint32_t work_stealing_scheduler::threads() const
+    {
+        return (uint32_t) m_workers.size();
+    }
+
+    void work_stealing_scheduler::submit(scheduler_job& job,
+        const scheduler_job::callback_type& callback)
+    {
+        uint32_t tasks = job.tasks();
+        job.start(callback);
+
+        if (tasks == 0)
+        {
+            return;
+        }
+
+        uint32_t queues = (uint32_t) m_queues.size();
+        uint32_t first;
+
+        {
+            // The count is increased before the tasks are queued, so it
+            // is never lower than the number of tasks in the queues
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queued += tasks;
+
+            // Consecutive jobs start on different queues, so jobs with
+            // fewer tasks than workers are spread over the workers
+            first = m_next_queue;
+            m_next_queue = (m_next_queue + 1) % queues;
+        }
+
+        for (uint32_t i = 0; i < queues; ++i)
+        {
+            uint32_t begin = (uint32_t) ((uint64_t) tasks * i / queues);
+            uint32_t end = (uint32_t) ((uint64_t) tasks * (i + 1) / queues);
+
+            if (begin == end)
+            {
+                continue;
+            }
+
+            queue& q = *m_queues[(first + i) % queues];
+            std::lock_guard<std::mutex> lock(q.m_mutex);
+
+            for (uint32_t index = begin; index < end; ++index)
+            {
+                task t = { &job, index };
+                q.m_tasks.push_back(t);
+            }
+        }
+
+        m_condition.notify_all();
+    }
+
+    void work_stealing_scheduler::work(uint32_t worker)
+    {
+        while (true)
+        {
+            task t;
+            if (take(worker, &t))
+            {
+                --m_queued;
+
+                t.m_job->execute(t.m_index);
+                t.m_job->finish();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]
+            {
+                return m_stop || m_queued > 0;
+            });
+
+            // The queued tasks are executed before the workers stop, so
+            // all submitted jobs complete
+            if (m_stop && m_queued == 0)
+            {
+                return;
+            }
+        }
+    }
+
+    bool work_stealing_scheduler::take(uint32_t worker, task* t)
+    {
+        assert(t != 0);
+
+        uint32_t queues = (uint32_t) m_queues.size();
+
+        {
+            queue& own = *m_queues[worker];
+            std::lock_guard<std::mutex> lock(own.m_mutex);
+
+            if (!own.m_tasks.empty())
+            {
+                *t = own.m_tasks.front();
+                own.m_tasks.pop_front();
+                return true;
+            }
+        }
+
+        for (uint32_t i = 1; i < queues; ++i)
+        {
+            queue& other = *m_queues[(worker + i) % queues];
+            std::lock_guard<std::mutex> lock(other.m_mutex);
+
+            if (!other.m_tasks.empty())
+            {
+                *t = other.m_tasks.back();
+                other.m_tasks.pop_back();
+                return true;
+            }
+        }
+
+        return false;
+    }
+}
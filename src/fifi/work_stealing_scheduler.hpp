@@ -0,0 +1,112 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "scheduler_job.hpp"
+
+namespace fifi
+{
+    /// Executes the tasks of jobs on a fixed number of worker threads
+    /// @see region_batch. Each worker has its own queue of tasks. When a
+    /// job is submitted its tasks are divided between the queues in
+    /// contiguous blocks, each worker executes the tasks of its queue
+    /// from the front and when the queue is empty it steals tasks from
+    /// the back of the queues of the other workers. This keeps the
+    /// workers busy when the tasks take different times.
+    ///
+    /// submit() returns at once, the completion of a job is signalled
+    /// through the job @see scheduler_job. Jobs can be submitted from
+    /// any thread, also from a completion callback.
+    class work_stealing_scheduler
+    {
+    public:
+
+        /// @param threads The number of worker threads, must be at
+        ///        least one
+        explicit work_stealing_scheduler(uint32_t threads);
+
+        /// Executes the remaining tasks and joins the worker threads
+        ~work_stealing_scheduler();
+
+        /// @return The number of worker threads
+        uint32_t threads() const;
+
+        /// Submits the tasks of a job for execution. The job must not be
+        /// running and must stay alive until it is done.
+        ///
+        /// @param job The job to execute
+        /// @param callback Called on a worker thread when all tasks of
+        ///        the job have been executed, may be empty
+        void submit(scheduler_job& job,
+            const scheduler_job::callback_type& callback =
+                scheduler_job::callback_type());
+
+    private:
+
+        work_stealing_scheduler(const work_stealing_scheduler&);
+        work_stealing_scheduler& operator=(const work_stealing_scheduler&);
+
+        /// A task in a queue, i.e. the index of a task of a job
+        struct task
+        {
+            scheduler_job* m_job;
+            uint32_t m_index;
+        };
+
+        /// The queue of a worker
+        struct queue
+        {
+            std::mutex m_mutex;
+            std::deque<task> m_tasks;
+        };
+
+        /// The loop of the worker threads
+        ///
+        /// @param worker The index of the worker
+        void work(uint32_t worker);
+
+        /// Takes a task from the front of the queue of the worker or
+        /// steals one from the back of the queue of another worker
+        ///
+        /// @param worker The index of the worker
+        /// @param t Set to the task taken
+        /// @return True if a task was taken
+        bool take(uint32_t worker, task* t);
+
+    private:
+
+        /// The queues of the workers
+        std::vector<std::unique_ptr<queue>> m_queues;
+
+        /// The worker threads
+        std::vector<std::thread> m_workers;
+
+        /// Protects the sleeping of the workers
+        std::mutex m_mutex;
+
+        /// Signals the workers that tasks were submitted or that the
+        /// scheduler is stopping
+        std::condition_variable m_condition;
+
+        /// The number of tasks in the queues
+        std::atomic<uint32_t> m_queued;
+
+        /// The queue receiving the first block of the next job
+        uint32_t m_next_queue;
+
+        /// True when the workers should stop
+        bool m_stop;
+    };
+}
@@ -954,6 +954,117 @@ sum_modulo_results<fifi::binary16>::m_results[] =
 const uint32_t sum_modulo_results<fifi::binary16>::m_size =
     dimension_of(sum_modulo_results<fifi::binary16>::m_results);
 
+//------------------------------------------------------------------
+// binary32
+//------------------------------------------------------------------
+
+// The results for the binary32 field were computed with a reference
+// implementation of the polynomial multiplication modulo the field
+// polynomial X^32+X^22+X^2+X+1. Division and inversion use that the
+// inverse of a is a^(2^32 - 2).
+
+const expected_result_binary<fifi::binary32>
+multiply_results<fifi::binary32>::m_results[] =
+{
+    // arg1, arg2, result
+    {           0U,           0U,           0U },
+    {           0U,           2U,           0U },
+    {           1U,           1U,           1U },
+    {           1U,           2U,           2U },
+    {           1U,          46U,          46U },
+    {           2U,           1U,           2U },
+    {           4U,         200U,         800U },
+    {           5U,           5U,          17U },
+    {          10U,          20U,         136U },
+    {          25U,          66U,        1650U },
+    {         110U,         253U,        9478U },
+    {         255U,         255U,       21845U },
+    {       65535U,       65535U,  1431655765U },
+    {       65536U,       65536U,     4194311U },
+    {  2147483648U,           2U,     4194311U },
+    {  2147483648U,  2147483648U,  3228572672U },
+    {   305419896U,  2596069104U,  2156827741U },
+    {  1111197069U,  3288497105U,  2742479341U },
+    {  3850830140U,  4242429948U,   565344229U },
+    {  4294967295U,           2U,  4290772985U },
+    {  4294967295U,  4294967295U,  2866106366U },
+};
+
+const uint32_t multiply_results<fifi::binary32>::m_size =
+    dimension_of(multiply_results<fifi::binary32>::m_results);
+
+const expected_result_binary<fifi::binary32>
+divide_results<fifi::binary32>::m_results[] =
+{
+    // arg1, arg2, result
+    {           0U,           2U,           0U },
+    {           1U,           1U,           1U },
+    {           1U,           2U,  2149580803U },
+    {           1U,          46U,  1167750376U },
+    {           2U,           1U,           2U },
+    {           4U,         200U,  2751377982U },
+    {           5U,           5U,           1U },
+    {          10U,          20U,  2149580803U },
+    {          25U,          66U,  2703228931U },
+    {         110U,         253U,  1018702042U },
+    {         255U,         255U,           1U },
+    {       65535U,       65535U,           1U },
+    {       65536U,       65536U,           1U },
+    {  2147483648U,           2U,  1073741824U },
+    {  2147483648U,  2147483648U,           1U },
+    {   305419896U,  2596069104U,  2269864422U },
+    {  1111197069U,  3288497105U,  4293266246U },
+    {  3850830140U,  4242429948U,  1054416853U },
+    {  4294967295U,           2U,  4292870140U },
+    {  4294967295U,  4294967295U,           1U },
+};
+
+const uint32_t divide_results<fifi::binary32>::m_size =
+    dimension_of(divide_results<fifi::binary32>::m_results);
+
+const expected_result_binary<fifi::binary32>
+add_results<fifi::binary32>::m_results[] =
+{
+    // arg1, arg2, result
+    {   332524003U,  3979276737U,  4278130722U },
+    {   430507637U,  1394663408U,  1250548101U },
+    {   917477150U,   621245851U,   329835141U },
+    {  1301926300U,  2999407447U,  4284383947U },
+    {  2131388237U,   104460427U,  2033424326U },
+    {  2185825083U,  1418804197U,  3604492510U },
+    {  2245405939U,  2965963934U,   891234413U },
+    {  3093409719U,   165572179U,  2982134244U },
+    {  3620970670U,   245081453U,  3645375939U },
+    {  3787302741U,  2013355927U,  2579298498U },
+    {  3866388338U,  1021321580U,  3667150366U },
+    {  4057458835U,  4263444814U,   264825309U },
+};
+
+const uint32_t add_results<fifi::binary32>::m_size =
+    dimension_of(add_results<fifi::binary32>::m_results);
+
+const expected_result_unary<fifi::binary32>
+invert_results<fifi::binary32>::m_results[] =
+{
+    // arg1, result
+    {           1U,           1U },
+    {           2U,  2149580803U },
+    {           5U,  2860515331U },
+    {          10U,  3579838466U },
+    {          46U,  1167750376U },
+    {         255U,  2996706845U },
+    {       65535U,  1256912107U },
+    {       65536U,  3069621955U },
+    {  2147483648U,   341736301U },
+    {   305419896U,  2030697647U },
+    {  1111197069U,  4068779622U },
+    {  3850830140U,  2145780662U },
+    {  4294967295U,  4014962855U },
+};
+
+const uint32_t invert_results<fifi::binary32>::m_size =
+    dimension_of(invert_results<fifi::binary32>::m_results);
+
 //------------------------------------------------------------------
 // prime2325
 //------------------------------------------------------------------
@@ -16,6 +16,7 @@
 
 #include <fifi/binary.hpp>
 #include <fifi/binary16.hpp>
+#include <fifi/binary32.hpp>
 #include <fifi/binary4.hpp>
 #include <fifi/binary8.hpp>
 #include <fifi/fifi_utils.hpp>
@@ -618,6 +619,208 @@ inline void check_results_region_multiply_subtract()
         std::mem_fn(&ReferenceImpl::region_multiply_subtract));
 }
 
+//------------------------------------------------------------------
+// linear combination
+//------------------------------------------------------------------
+
+/// This function checks whether the region arithmetics for the
+/// "dest[i] = constants[0] * srcs[0][i] + ... + constants[count - 1] *
+/// srcs[count - 1][i]" function works. The reference results are computed
+/// by clearing the destination and invoking region_multiply_add() once
+/// for every source.
+///
+/// @tparam TestImpl The stack class to test
+/// @tparam ReferenceImpl The reference stack class to test against
+template
+<
+    class TestImpl,
+    class ReferenceImpl = fifi::helper_region_reference<
+        typename TestImpl::field_type>
+>
+inline void check_results_region_linear_combination()
+{
+    typedef typename TestImpl::field_type test_field;
+    typedef typename ReferenceImpl::field_type reference_field;
+    typedef typename test_field::value_type value_type;
+
+    static_assert(std::is_same<test_field, reference_field>::value,
+                  "Reference and field under test must use same field");
+
+    TestImpl test_stack;
+    ReferenceImpl reference_stack;
+
+    // pick a random number of elementes between 128 and 128+256
+    uint32_t elements = 128 + rand() % 256;
+
+    uint32_t alignments = test_stack.max_alignment() + test_stack.alignment();
+    uint32_t granularities = test_stack.max_granularity() +
+        test_stack.granularity();
+
+    // The number of sources, chosen so that both complete and partial
+    // blocks of sources are exercised in the optimized implementations
+    std::vector<uint32_t> counts = { 1, 3, 4, 5, 8, 13 };
+
+    for (uint32_t alignment = test_stack.alignment();
+        alignment <= alignments;
+        alignment += test_stack.alignment())
+    {
+        assert((alignment % sizeof(value_type)) == 0);
+        for (uint32_t granularity = test_stack.granularity();
+            granularity <= granularities;
+            granularity += test_stack.granularity())
+        {
+            SCOPED_TRACE(testing::Message() << "alignment: " << alignment);
+            SCOPED_TRACE(testing::Message() << "granularity: " << granularity);
+
+            for (auto count : counts)
+            {
+                SCOPED_TRACE(testing::Message() << "count: " << count);
+
+                auto data = create_data<test_field>(elements, alignment,
+                    granularity);
+
+                uint32_t length = data.length();
+
+                std::vector<fifi::helper_test_buffer<value_type>> srcs;
+                std::vector<const value_type*> src_ptrs;
+                std::vector<value_type> constants;
+
+                for (uint32_t j = 0; j < count; ++j)
+                {
+                    srcs.push_back(create_data<test_field>(elements,
+                        alignment, granularity));
+                    constants.push_back(fifi::pack_constant<test_field>(
+                        rand() % test_field::order));
+                }
+
+                for (const auto& src : srcs)
+                {
+                    src_ptrs.push_back(src.data());
+                }
+
+                // The destination is overwritten so it is filled with
+                // random data to check that it is not read
+                auto test_data = data;
+                auto reference_data = data;
+
+                std::fill_n(reference_data.data(), length, 0);
+                for (uint32_t j = 0; j < count; ++j)
+                {
+                    reference_stack.region_multiply_add(
+                        reference_data.data(), src_ptrs[j], constants[j],
+                        length);
+                }
+
+                test_stack.region_linear_combination(test_data.data(),
+                    src_ptrs.data(), constants.data(), count, length);
+
+                EXPECT_EQ(reference_data, test_data);
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------
+// multiply add many
+//------------------------------------------------------------------
+
+/// This function checks whether the region arithmetics for the
+/// "dests[j][i] = dests[j][i] + constants[j] * src[i]" function works. The
+/// reference results are computed by invoking region_multiply_add() once
+/// for every destination.
+///
+/// @tparam TestImpl The stack class to test
+/// @tparam ReferenceImpl The reference stack class to test against
+template
+<
+    class TestImpl,
+    class ReferenceImpl = fifi::helper_region_reference<
+        typename TestImpl::field_type>
+>
+inline void check_results_region_multiply_add_many()
+{
+    typedef typename TestImpl::field_type test_field;
+    typedef typename ReferenceImpl::field_type reference_field;
+    typedef typename test_field::value_type value_type;
+
+    static_assert(std::is_same<test_field, reference_field>::value,
+                  "Reference and field under test must use same field");
+
+    TestImpl test_stack;
+    ReferenceImpl reference_stack;
+
+    // pick a random number of elementes between 128 and 128+256
+    uint32_t elements = 128 + rand() % 256;
+
+    uint32_t alignments = test_stack.max_alignment() + test_stack.alignment();
+    uint32_t granularities = test_stack.max_granularity() +
+        test_stack.granularity();
+
+    // The number of destinations, chosen so that both complete and partial
+    // blocks of destinations are exercised in the optimized implementations
+    std::vector<uint32_t> counts = { 1, 3, 4, 5, 8, 13 };
+
+    for (uint32_t alignment = test_stack.alignment();
+        alignment <= alignments;
+        alignment += test_stack.alignment())
+    {
+        assert((alignment % sizeof(value_type)) == 0);
+        for (uint32_t granularity = test_stack.granularity();
+            granularity <= granularities;
+            granularity += test_stack.granularity())
+        {
+            SCOPED_TRACE(testing::Message() << "alignment: " << alignment);
+            SCOPED_TRACE(testing::Message() << "granularity: " << granularity);
+
+            for (auto count : counts)
+            {
+                SCOPED_TRACE(testing::Message() << "count: " << count);
+
+                auto src = create_data<test_field>(elements, alignment,
+                    granularity);
+
+                uint32_t length = src.length();
+
+                std::vector<fifi::helper_test_buffer<value_type>> test_data;
+                std::vector<fifi::helper_test_buffer<value_type>>
+                    reference_data;
+                std::vector<value_type> constants;
+
+                for (uint32_t j = 0; j < count; ++j)
+                {
+                    auto data = create_data<test_field>(elements,
+                        alignment, granularity);
+                    test_data.push_back(data);
+                    reference_data.push_back(data);
+                    constants.push_back(fifi::pack_constant<test_field>(
+                        rand() % test_field::order));
+                }
+
+                std::vector<value_type*> test_ptrs;
+                for (auto& data : test_data)
+                {
+                    test_ptrs.push_back(data.data());
+                }
+
+                for (uint32_t j = 0; j < count; ++j)
+                {
+                    reference_stack.region_multiply_add(
+                        reference_data[j].data(), src.data(), constants[j],
+                        length);
+                }
+
+                test_stack.region_multiply_add_many(test_ptrs.data(),
+                    src.data(), constants.data(), count, length);
+
+                for (uint32_t j = 0; j < count; ++j)
+                {
+                    EXPECT_EQ(reference_data[j], test_data[j]);
+                }
+            }
+        }
+    }
+}
+
 //------------------------------------------------------------------
 // check random
 //------------------------------------------------------------------
@@ -965,6 +1168,71 @@ struct packed_invert_results<fifi::binary16>
     : public invert_results<fifi::binary16>
 { };
 
+//------------------------------------------------------------------
+// binary32
+//------------------------------------------------------------------
+
+/// Specialized structs which contains the results for the binary32 field
+
+template<>
+struct multiply_results<fifi::binary32>
+{
+    static const expected_result_binary<fifi::binary32> m_results[];
+    static const uint32_t m_size;
+};
+
+template<>
+struct divide_results<fifi::binary32>
+{
+    static const expected_result_binary<fifi::binary32> m_results[];
+    static const uint32_t m_size;
+};
+
+template<>
+struct add_results<fifi::binary32>
+{
+    static const expected_result_binary<fifi::binary32> m_results[];
+    static const uint32_t m_size;
+};
+
+template<>
+struct subtract_results<fifi::binary32> : add_results<fifi::binary32>
+{ };
+
+template<>
+struct invert_results<fifi::binary32>
+{
+    static const expected_result_unary<fifi::binary32> m_results[];
+    static const uint32_t m_size;
+};
+
+/// Specialized structs which contains the packed results for the binary32 field
+
+template<>
+struct packed_multiply_results<fifi::binary32>
+    : public multiply_results<fifi::binary32>
+{ };
+
+template<>
+struct packed_divide_results<fifi::binary32>
+    : public divide_results<fifi::binary32>
+{ };
+
+template<>
+struct packed_add_results<fifi::binary32>
+    : public add_results<fifi::binary32>
+{ };
+
+template<>
+struct packed_subtract_results<fifi::binary32>
+    : public packed_add_results<fifi::binary32>
+{ };
+
+template<>
+struct packed_invert_results<fifi::binary32>
+    : public invert_results<fifi::binary32>
+{ };
+
 //------------------------------------------------------------------
 // prime2325
 //------------------------------------------------------------------
@@ -203,6 +203,58 @@ namespace fifi
         }
     }
 
+    /// @copydoc check_region_add()
+    template<template <class> class FieldImpl>
+    void check_region_linear_combination()
+    {
+        {
+            SCOPED_TRACE("binary");
+            check_results_region_linear_combination<
+                FieldImpl<fifi::binary> >();
+        }
+        {
+            SCOPED_TRACE("binary4");
+            check_results_region_linear_combination<
+                FieldImpl<fifi::binary4> >();
+        }
+        {
+            SCOPED_TRACE("binary8");
+            check_results_region_linear_combination<
+                FieldImpl<fifi::binary8> >();
+        }
+        {
+            SCOPED_TRACE("binary16");
+            check_results_region_linear_combination<
+                FieldImpl<fifi::binary16> >();
+        }
+    }
+
+    /// @copydoc check_region_add()
+    template<template <class> class FieldImpl>
+    void check_region_multiply_add_many()
+    {
+        {
+            SCOPED_TRACE("binary");
+            check_results_region_multiply_add_many<
+                FieldImpl<fifi::binary> >();
+        }
+        {
+            SCOPED_TRACE("binary4");
+            check_results_region_multiply_add_many<
+                FieldImpl<fifi::binary4> >();
+        }
+        {
+            SCOPED_TRACE("binary8");
+            check_results_region_multiply_add_many<
+                FieldImpl<fifi::binary8> >();
+        }
+        {
+            SCOPED_TRACE("binary16");
+            check_results_region_multiply_add_many<
+                FieldImpl<fifi::binary16> >();
+        }
+    }
+
     /// Helper function that given a field implementation will invoke
     /// all the different check_region_xxx() functions.
     template<class FieldImpl>
@@ -236,5 +288,13 @@ namespace fifi
             SCOPED_TRACE("multiply_subtract");
             check_results_region_multiply_subtract<FieldImpl>();
         }
+        {
+            SCOPED_TRACE("linear_combination");
+            check_results_region_linear_combination<FieldImpl>();
+        }
+        {
+            SCOPED_TRACE("multiply_add_many");
+            check_results_region_multiply_add_many<FieldImpl>();
+        }
     }
 }
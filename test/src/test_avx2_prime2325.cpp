@@ -0,0 +1,117 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <cassert>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <cpuid/cpuinfo.hpp>
+
+#include <fifi/avx2_prime2325.hpp>
+#include <fifi/final.hpp>
+#include <fifi/optimal_prime_arithmetic.hpp>
+
+#include "fifi_unit_test/helper_test_arithmetic.hpp"
+#include "fifi_unit_test/helper_test_packed_arithmetic.hpp"
+#include "fifi_unit_test/helper_test_region_arithmetic.hpp"
+
+
+TEST(test_avx2_prime2325, region_add)
+{
+    fifi::avx2_prime2325 stack;
+    if (stack.enabled())
+    {
+        check_results_region_add<fifi::avx2_prime2325>();
+    }
+}
+
+TEST(test_avx2_prime2325, region_subtract)
+{
+    fifi::avx2_prime2325 stack;
+    if (stack.enabled())
+    {
+        check_results_region_subtract<fifi::avx2_prime2325>();
+    }
+}
+
+TEST(test_avx2_prime2325, region_multiply_constant)
+{
+    fifi::avx2_prime2325 stack;
+    if (stack.enabled())
+    {
+        check_results_region_multiply_constant<
+            fifi::avx2_prime2325>();
+    }
+}
+
+TEST(test_avx2_prime2325, region_multiply_add)
+{
+    fifi::avx2_prime2325 stack;
+    if (stack.enabled())
+    {
+        check_results_region_multiply_add<
+            fifi::avx2_prime2325>();
+    }
+}
+
+TEST(test_avx2_prime2325, region_multiply_subtract)
+{
+    fifi::avx2_prime2325 stack;
+    if (stack.enabled())
+    {
+        check_results_region_multiply_subtract<
+            fifi::avx2_prime2325>();
+    }
+}
+
+TEST(test_avx2_prime2325, boundary_values)
+{
+    fifi::avx2_prime2325 stack;
+    if (stack.enabled())
+    {
+        fifi::optimal_prime_arithmetic<fifi::final<fifi::prime2325>> field;
+
+        // Elements which exercise the overflow and reduction corner cases
+        const uint32_t prime = fifi::prime2325::prime;
+        std::vector<uint32_t> values =
+            { 0U, 1U, 2U, 5U, 0x7fffffffU, 0x80000000U,
+              prime - 5, prime - 2, prime - 1, 6U, 0xffffU, 0x10000U,
+              prime / 2, prime / 2 + 1, prime - 6, 4U };
+
+        assert((values.size() % stack.granularity()) == 0);
+
+        for (uint32_t constant : values)
+        {
+            std::vector<uint32_t> dest(values.rbegin(), values.rend());
+
+            stack.region_multiply_add(
+                &dest[0], &values[0], constant, (uint32_t) values.size());
+
+            for (uint32_t i = 0; i < values.size(); ++i)
+            {
+                uint32_t expected = field.add(
+                    values[values.size() - i - 1],
+                    field.multiply(values[i], constant));
+
+                EXPECT_EQ(expected, dest[i]);
+            }
+
+            dest.assign(values.rbegin(), values.rend());
+
+            stack.region_multiply_subtract(
+                &dest[0], &values[0], constant, (uint32_t) values.size());
+
+            for (uint32_t i = 0; i < values.size(); ++i)
+            {
+                uint32_t expected = field.subtract(
+                    values[values.size() - i - 1],
+                    field.multiply(values[i], constant));
+
+                EXPECT_EQ(expected, dest[i]);
+            }
+        }
+    }
+}
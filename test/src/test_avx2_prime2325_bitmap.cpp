@@ -0,0 +1,72 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <fifi/avx2_prime2325_bitmap.hpp>
+
+/// Compares the merged private bitmaps with a bitmap updated one value
+/// at a time
+TEST(test_avx2_prime2325_bitmap, update_bitmaps)
+{
+    fifi::avx2_prime2325_bitmap avx2;
+    if (!avx2.enabled())
+    {
+        return;
+    }
+
+    // 12 prefix bits gives 4096 prefixes stored in 128 words
+    const uint32_t shift_prefix = 20;
+    const uint32_t words = 128;
+
+    // Sizes which are not a multiple of eight leave values to the
+    // scalar update
+    uint32_t sizes[] = { 0, 1, 7, 8, 9, 100, 1003 };
+    uint32_t counts[] = { 1, 2, 4, 8 };
+
+    for (uint32_t size : sizes)
+    {
+        // Random values and values sharing few prefixes
+        std::vector<uint32_t> random(size);
+        std::vector<uint32_t> clustered(size);
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            random[i] = (uint32_t) rand() * 2U + (rand() & 1);
+            clustered[i] = (uint32_t) (rand() % 3) << shift_prefix;
+        }
+
+        for (const std::vector<uint32_t>* data : { &random, &clustered })
+        {
+            std::vector<uint32_t> expected(words, 0);
+            for (uint32_t value : *data)
+            {
+                uint32_t prefix = value >> shift_prefix;
+                expected[prefix / 32] |= 1U << (prefix % 32);
+            }
+
+            for (uint32_t count : counts)
+            {
+                SCOPED_TRACE(testing::Message() << "size: " << size
+                             << " count: " << count);
+
+                std::vector<uint32_t> bitmaps(words * count, 0);
+                avx2.update_bitmaps(bitmaps.data(), words, count,
+                    data->data(), size, shift_prefix);
+
+                std::vector<uint32_t> merged(words, 0);
+                for (uint32_t i = 0; i < bitmaps.size(); ++i)
+                {
+                    merged[i % words] |= bitmaps[i];
+                }
+
+                EXPECT_EQ(expected, merged);
+            }
+        }
+    }
+}
@@ -0,0 +1,18 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <fifi/binary32.hpp>
+
+#include <gtest/gtest.h>
+
+TEST(test_binary32, binary32)
+{
+    EXPECT_EQ(4294967295U, fifi::binary32::max_value);
+    EXPECT_EQ(0U, fifi::binary32::min_value);
+    EXPECT_EQ(4294967296ULL, fifi::binary32::order);
+    EXPECT_EQ(32U, fifi::binary32::degree);
+    EXPECT_EQ(4194311U, fifi::binary32::prime);
+    EXPECT_TRUE(fifi::binary32::is_exact);
+}
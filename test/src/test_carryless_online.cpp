@@ -0,0 +1,44 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <fifi/binary16.hpp>
+#include <fifi/binary32.hpp>
+#include <fifi/carryless_online.hpp>
+
+#include <gtest/gtest.h>
+
+#include "fifi_unit_test/helper_test_arithmetic.hpp"
+#include "fifi_unit_test/helper_test_packed_arithmetic.hpp"
+#include "fifi_unit_test/helper_test_region_arithmetic.hpp"
+
+TEST(test_carryless_online, binary16)
+{
+    fifi::check_all<fifi::carryless_online<fifi::binary16>>();
+}
+
+TEST(test_carryless_online, packed_binary16)
+{
+    fifi::check_packed_all<fifi::carryless_online<fifi::binary16>>();
+}
+
+TEST(test_carryless_online, region_binary16)
+{
+    fifi::check_region_all<fifi::carryless_online<fifi::binary16>>();
+}
+
+TEST(test_carryless_online, binary32)
+{
+    fifi::check_all<fifi::carryless_online<fifi::binary32>>();
+}
+
+TEST(test_carryless_online, packed_binary32)
+{
+    fifi::check_packed_all<fifi::carryless_online<fifi::binary32>>();
+}
+
+TEST(test_carryless_online, region_binary32)
+{
+    fifi::check_region_all<fifi::carryless_online<fifi::binary32>>();
+}
@@ -0,0 +1,25 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <cstdint>
+
+#include <fifi/count_trailing_zeros.hpp>
+
+#include <gtest/gtest.h>
+
+TEST(test_count_trailing_zeros, count_trailing_zeros)
+{
+    EXPECT_EQ(0U, fifi::count_trailing_zeros(1U));
+    EXPECT_EQ(0U, fifi::count_trailing_zeros(0xffffffffU));
+    EXPECT_EQ(1U, fifi::count_trailing_zeros(2U));
+    EXPECT_EQ(3U, fifi::count_trailing_zeros(0x18U));
+    EXPECT_EQ(31U, fifi::count_trailing_zeros(0x80000000U));
+
+    for (uint32_t i = 0; i < 32; ++i)
+    {
+        EXPECT_EQ(i, fifi::count_trailing_zeros(1U << i));
+        EXPECT_EQ(i, fifi::count_trailing_zeros(0xffffffffU << i));
+    }
+}
@@ -5,11 +5,13 @@
 
 #include <type_traits>
 
+#include <fifi/carryless_online.hpp>
 #include <fifi/default_field.hpp>
 #include <fifi/extended_log_table.hpp>
 #include <fifi/full_table.hpp>
 #include <fifi/optimal_prime.hpp>
 #include <fifi/simple_online.hpp>
+#include <fifi/split_table.hpp>
 
 #include <gtest/gtest.h>
 
@@ -44,7 +46,16 @@ TEST(test_default_field, binary16_default_field)
 {
     bool test= std::is_same<
         fifi::default_field<fifi::binary16>::type,
-        fifi::extended_log_table<fifi::binary16> >::value;
+        fifi::split_table<fifi::binary16> >::value;
+
+    EXPECT_TRUE(test);
+}
+
+TEST(test_default_field, binary32_default_field)
+{
+    bool test= std::is_same<
+        fifi::default_field<fifi::binary32>::type,
+        fifi::carryless_online<fifi::binary32> >::value;
 
     EXPECT_TRUE(test);
 }
@@ -0,0 +1,117 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <cstdint>
+
+#include <fifi/binary16.hpp>
+#include <fifi/binary4.hpp>
+#include <fifi/binary8.hpp>
+#include <fifi/field_tables.hpp>
+#include <fifi/simple_online.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    /// Checks the generated tables against the simple online arithmetics
+    template<class Field>
+    void check_field_tables()
+    {
+        typedef fifi::field_tables<Field> tables;
+        typedef typename Field::value_type value_type;
+
+        EXPECT_TRUE(tables::available);
+
+        fifi::simple_online<Field> field;
+        const int32_t order = Field::order;
+
+        const value_type* multiplication = tables::multiplication();
+        const value_type* division = tables::division();
+
+        for (int32_t a = 0; a < order; ++a)
+        {
+            for (int32_t b = 0; b < order; ++b)
+            {
+                EXPECT_EQ(field.multiply(a, b),
+                          multiplication[(a << Field::degree) + b]);
+
+                if (b == 0)
+                    continue;
+
+                EXPECT_EQ(field.divide(a, b),
+                          division[(a << Field::degree) + b]);
+            }
+        }
+
+        const value_type* log = tables::log();
+        const value_type* antilog = tables::antilog();
+        const value_type* extended = tables::extended_antilog();
+
+        // The extended table is offset so that negative exponents can
+        // be used
+        const value_type* extended_antilog = extended + order - 2;
+
+        value_type power = 1;
+        for (int32_t i = 0; i < order - 1; ++i)
+        {
+            EXPECT_EQ(power, antilog[i]);
+            EXPECT_EQ(i, (int32_t) log[power]);
+            EXPECT_EQ(power, extended_antilog[i]);
+
+            // The exponents are repeated below and above the range
+            if (i > 0)
+            {
+                EXPECT_EQ(power, extended_antilog[i - (order - 1)]);
+            }
+
+            if (i < order - 2)
+            {
+                EXPECT_EQ(power, extended_antilog[i + order - 1]);
+            }
+
+            power = field.multiply(2, power);
+        }
+
+        EXPECT_EQ(1U, antilog[Field::max_value]);
+
+        const value_type* table_one = tables::simd_table_one();
+        const value_type* table_two = tables::simd_table_two();
+
+        // The SIMD stacks use aligned loads of the rows
+        EXPECT_EQ(0U, (uintptr_t) table_one % 16);
+        EXPECT_EQ(0U, (uintptr_t) table_two % 16);
+
+        for (int32_t a = 0; a < order; ++a)
+        {
+            for (int32_t j = 0; j < 16; ++j)
+            {
+                EXPECT_EQ(field.multiply(a, j), table_one[a * 16 + j]);
+
+                // For binary4 the high-half of a byte is an element, for
+                // binary8 it is part of an element
+                value_type high = Field::degree == 4 ?
+                    (value_type)(field.multiply(a, j) << 4) :
+                    field.multiply(a, j << 4);
+
+                EXPECT_EQ(high, table_two[a * 16 + j]);
+            }
+        }
+    }
+}
+
+TEST(test_field_tables, binary4)
+{
+    check_field_tables<fifi::binary4>();
+}
+
+TEST(test_field_tables, binary8)
+{
+    check_field_tables<fifi::binary8>();
+}
+
+TEST(test_field_tables, not_available)
+{
+    EXPECT_FALSE(fifi::field_tables<fifi::binary16>::available);
+}
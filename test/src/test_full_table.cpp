@@ -3,15 +3,21 @@
 // See accompanying file LICENSE.rst or
 // http://www.steinwurf.com/licensing
 
+#include <cstdint>
+#include <vector>
+
 #include <fifi/binary4.hpp>
 #include <fifi/binary8.hpp>
 #include <fifi/full_table.hpp>
+#include <fifi/region_backend.hpp>
+#include <fifi/region_thresholds.hpp>
 
 #include <gtest/gtest.h>
 
 #include "fifi_unit_test/helper_test_arithmetic.hpp"
 #include "fifi_unit_test/helper_test_packed_arithmetic.hpp"
 #include "fifi_unit_test/helper_test_region_arithmetic.hpp"
+#include "fifi_unit_test/random_constant.hpp"
 
 TEST(test_full_table, binary4)
 {
@@ -42,3 +48,68 @@ TEST(test_full_table, region_binary8)
 {
     fifi::check_region_all<fifi::full_table<fifi::binary8>>();
 }
+
+TEST(test_full_table, backend)
+{
+    typedef fifi::full_table<fifi::binary8> stack_type;
+    typedef stack_type::value_type value_type;
+
+    const uint32_t length = 1000;
+
+    fifi::random_constant<fifi::binary8> constants;
+    value_type constant = constants.pack();
+
+    std::vector<value_type> src(length);
+    std::vector<value_type> dest(length);
+    for (uint32_t i = 0; i < length; ++i)
+    {
+        src[i] = constants.value();
+        dest[i] = constants.value();
+    }
+
+    stack_type basic_stack;
+    basic_stack.set_backend(fifi::region_backend::basic);
+
+    for (uint32_t i = 0; i < fifi::region_thresholds::operations; ++i)
+    {
+        auto op = (fifi::region_thresholds::operation) i;
+        EXPECT_EQ(fifi::region_backend::basic, basic_stack.backend(op));
+    }
+
+    std::vector<value_type> expected = dest;
+    basic_stack.region_multiply_add(
+        expected.data(), src.data(), constant, length);
+
+    const fifi::region_backend backends[] =
+    {
+        fifi::region_backend::automatic,
+        fifi::region_backend::ssse3,
+        fifi::region_backend::avx2,
+        fifi::region_backend::neon
+    };
+
+    for (fifi::region_backend backend : backends)
+    {
+        SCOPED_TRACE(fifi::region_backend_name(backend));
+
+        stack_type stack;
+        stack.set_backend(backend);
+
+        // The forced backend is used if the CPU supports it, however
+        // the backends are fixed when dispatching at compile-time
+        auto active = stack.backend(
+            fifi::region_thresholds::region_multiply_add);
+
+        if (backend != fifi::region_backend::automatic &&
+            !fifi::target_instruction_set::static_dispatch)
+        {
+            EXPECT_TRUE(active == backend ||
+                        active == fifi::region_backend::basic);
+        }
+
+        std::vector<value_type> result = dest;
+        stack.region_multiply_add(result.data(), src.data(), constant, length);
+
+        EXPECT_EQ(expected, result);
+    }
+}
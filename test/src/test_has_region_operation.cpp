@@ -0,0 +1,46 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include <fifi/binary8.hpp>
+#include <fifi/full_table.hpp>
+#include <fifi/has_region_operation.hpp>
+#include <fifi/region_thresholds.hpp>
+#include <fifi/ssse3_binary8_full_table.hpp>
+
+namespace fifi
+{
+    // Put dummy layers and tests classes in an anonymous namespace
+    // to avoid violations of ODF (one-definition-rule) in other
+    // translation units
+    namespace
+    {
+        struct dummy_stack
+        { };
+    }
+}
+
+TEST(test_has_region_operation, api)
+{
+    for (uint32_t i = 0; i < fifi::region_thresholds::operations; ++i)
+    {
+        auto op = (fifi::region_thresholds::operation) i;
+        SCOPED_TRACE(fifi::region_thresholds::name(op));
+
+        EXPECT_FALSE(fifi::has_region_operation<fifi::dummy_stack>(op));
+        EXPECT_TRUE(fifi::has_region_operation<
+            fifi::full_table<fifi::binary8>>(op));
+    }
+
+    typedef fifi::ssse3_binary8_full_table ssse3_stack;
+
+    EXPECT_TRUE(fifi::has_region_operation<ssse3_stack>(
+        fifi::region_thresholds::region_multiply_add));
+    EXPECT_FALSE(fifi::has_region_operation<ssse3_stack>(
+        fifi::region_thresholds::region_divide));
+}
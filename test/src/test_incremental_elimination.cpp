@@ -0,0 +1,157 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <fifi/fifi_utils.hpp>
+#include <fifi/full_table.hpp>
+#include <fifi/incremental_elimination.hpp>
+#include <fifi/optimal_prime.hpp>
+#include <fifi/simple_online.hpp>
+#include <fifi/split_table.hpp>
+
+#include <gtest/gtest.h>
+
+#include "fifi_unit_test/helper_region_reference.hpp"
+
+namespace
+{
+    /// Encodes random coded rows from a set of random symbols and checks
+    /// that the elimination decodes the original symbols
+    template<class Stack>
+    void check_incremental_elimination(uint32_t symbols,
+                                       uint32_t symbol_length)
+    {
+        typedef typename Stack::field_type field_type;
+        typedef typename Stack::value_type value_type;
+
+        SCOPED_TRACE(testing::Message() << "symbols: " << symbols);
+
+        fifi::helper_region_reference<field_type> reference;
+        fifi::incremental_elimination<Stack> elimination(
+            symbols, symbol_length);
+
+        EXPECT_EQ(symbols, elimination.symbols());
+        EXPECT_EQ(symbol_length, elimination.symbol_length());
+        EXPECT_EQ(0U, elimination.rank());
+        EXPECT_FALSE(elimination.is_complete());
+
+        uint32_t coefficients_length = elimination.coefficients_length();
+
+        std::vector<std::vector<value_type>> originals(symbols);
+        for (auto& original : originals)
+        {
+            original.resize(symbol_length);
+            uint32_t elements = fifi::length_to_elements<field_type>(
+                symbol_length);
+
+            for (uint32_t i = 0; i < elements; ++i)
+            {
+                fifi::set_value<field_type>(original.data(), i,
+                    rand() % field_type::order);
+            }
+        }
+
+        std::vector<value_type> coefficients(coefficients_length);
+        std::vector<value_type> symbol(symbol_length);
+
+        // Add a systematic row first, this must always be innovative
+        std::fill(coefficients.begin(), coefficients.end(), 0);
+        fifi::set_value<field_type>(coefficients.data(), symbols / 2, 1);
+
+        EXPECT_TRUE(elimination.add_row(
+            coefficients.data(), originals[symbols / 2].data()));
+        EXPECT_EQ(1U, elimination.rank());
+        EXPECT_TRUE(elimination.is_pivot(symbols / 2));
+
+        // The same row again is not innovative
+        if (symbols > 1)
+        {
+            EXPECT_FALSE(elimination.add_row(
+                coefficients.data(), originals[symbols / 2].data()));
+            EXPECT_EQ(1U, elimination.rank());
+        }
+
+        uint32_t rows = 1;
+
+        while (!elimination.is_complete())
+        {
+            ASSERT_LT(rows, 100 * symbols);
+            ++rows;
+
+            std::fill(symbol.begin(), symbol.end(), 0);
+
+            for (uint32_t j = 0; j < symbols; ++j)
+            {
+                value_type coefficient = rand() % field_type::order;
+                fifi::set_value<field_type>(
+                    coefficients.data(), j, coefficient);
+
+                reference.region_multiply_add(symbol.data(),
+                    originals[j].data(),
+                    fifi::pack_constant<field_type>(coefficient),
+                    symbol_length);
+            }
+
+            uint32_t rank = elimination.rank();
+            bool innovative = elimination.add_row(
+                coefficients.data(), symbol.data());
+
+            EXPECT_EQ(rank + (innovative ? 1 : 0), elimination.rank());
+        }
+
+        EXPECT_EQ(symbols, elimination.rank());
+
+        for (uint32_t j = 0; j < symbols; ++j)
+        {
+            EXPECT_TRUE(elimination.is_pivot(j));
+
+            std::vector<value_type> decoded(elimination.symbol(j),
+                elimination.symbol(j) + symbol_length);
+
+            EXPECT_EQ(originals[j], decoded);
+        }
+
+        // Rows added after completion are never innovative
+        EXPECT_FALSE(elimination.add_row(
+            coefficients.data(), symbol.data()));
+    }
+
+    template<class Stack>
+    void check_incremental_elimination_sizes()
+    {
+        check_incremental_elimination<Stack>(1, 16);
+        check_incremental_elimination<Stack>(5, 33);
+        check_incremental_elimination<Stack>(32, 100);
+    }
+}
+
+TEST(test_incremental_elimination, binary)
+{
+    check_incremental_elimination_sizes<fifi::simple_online<fifi::binary>>();
+}
+
+TEST(test_incremental_elimination, binary4)
+{
+    check_incremental_elimination_sizes<fifi::full_table<fifi::binary4>>();
+}
+
+TEST(test_incremental_elimination, binary8)
+{
+    check_incremental_elimination_sizes<fifi::full_table<fifi::binary8>>();
+}
+
+TEST(test_incremental_elimination, binary16)
+{
+    check_incremental_elimination_sizes<fifi::split_table<fifi::binary16>>();
+}
+
+TEST(test_incremental_elimination, prime2325)
+{
+    check_incremental_elimination_sizes<
+        fifi::optimal_prime<fifi::prime2325>>();
+}
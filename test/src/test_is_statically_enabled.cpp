@@ -0,0 +1,50 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include <fifi/is_statically_enabled.hpp>
+#include <fifi/ssse3_binary8_full_table.hpp>
+#include <fifi/target_instruction_set.hpp>
+
+namespace fifi
+{
+    // Put dummy layers and tests classes in an anonymous namespace
+    // to avoid violations of ODF (one-definition-rule) in other
+    // translation units
+    namespace
+    {
+        struct dummy_stack
+        { };
+
+        template<bool Enabled>
+        struct dummy_static_stack
+        {
+            static const bool statically_enabled = Enabled;
+        };
+    }
+}
+
+TEST(test_is_statically_enabled, api)
+{
+    EXPECT_FALSE(fifi::has_statically_enabled<fifi::dummy_stack>::value);
+    EXPECT_FALSE(fifi::has_statically_enabled<uint32_t>::value);
+    EXPECT_TRUE(fifi::has_statically_enabled<
+        fifi::dummy_static_stack<false>>::value);
+
+    EXPECT_FALSE(fifi::is_statically_enabled<fifi::dummy_stack>::value);
+    EXPECT_FALSE(fifi::is_statically_enabled<
+        fifi::dummy_static_stack<false>>::value);
+    EXPECT_TRUE(fifi::is_statically_enabled<
+        fifi::dummy_static_stack<true>>::value);
+
+    // The SIMD stacks are statically enabled if the build targets their
+    // instruction set
+    bool ssse3 = fifi::target_instruction_set::ssse3;
+    EXPECT_EQ(ssse3, fifi::is_statically_enabled<
+        fifi::ssse3_binary8_full_table>::value);
+}
@@ -0,0 +1,133 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <fifi/carryless_online.hpp>
+#include <fifi/fifi_utils.hpp>
+#include <fifi/full_table.hpp>
+#include <fifi/matrix_multiply.hpp>
+#include <fifi/optimal_prime.hpp>
+#include <fifi/simple_online.hpp>
+#include <fifi/split_table.hpp>
+
+#include <gtest/gtest.h>
+
+#include "fifi_unit_test/helper_region_reference.hpp"
+
+namespace
+{
+    /// Fills a buffer with random field elements
+    template<class Field>
+    void fill_random(std::vector<typename Field::value_type>& buffer)
+    {
+        uint32_t elements = fifi::length_to_elements<Field>(
+            (uint32_t) buffer.size());
+
+        for (uint32_t i = 0; i < elements; ++i)
+        {
+            fifi::set_value<Field>(
+                buffer.data(), i, rand() % Field::order);
+        }
+    }
+
+    /// Checks matrix_multiply() against the product computed with one
+    /// region_multiply_add() per element of A on the reference stack
+    template<class Stack>
+    void check_matrix_multiply(uint32_t rows, uint32_t inner,
+                               uint32_t length)
+    {
+        typedef typename Stack::field_type field_type;
+        typedef typename Stack::value_type value_type;
+
+        SCOPED_TRACE(testing::Message() << "rows: " << rows);
+        SCOPED_TRACE(testing::Message() << "inner: " << inner);
+        SCOPED_TRACE(testing::Message() << "length: " << length);
+
+        Stack stack;
+        fifi::helper_region_reference<field_type> reference;
+
+        uint32_t a_length = fifi::elements_to_length<field_type>(inner);
+
+        std::vector<value_type> a(rows * a_length);
+        std::vector<value_type> b(inner * length);
+        fill_random<field_type>(a);
+        fill_random<field_type>(b);
+
+        // Fill C with random data to check that it is overwritten
+        std::vector<value_type> c(rows * length);
+        fill_random<field_type>(c);
+
+        std::vector<value_type> expected(rows * length, 0);
+
+        for (uint32_t i = 0; i < rows; ++i)
+        {
+            for (uint32_t k = 0; k < inner; ++k)
+            {
+                value_type coefficient =
+                    fifi::get_value<field_type>(&a[i * a_length], k);
+
+                reference.region_multiply_add(&expected[i * length],
+                    &b[k * length],
+                    fifi::pack_constant<field_type>(coefficient), length);
+            }
+        }
+
+        fifi::matrix_multiply(stack, c.data(), a.data(), b.data(),
+                              rows, inner, length);
+
+        EXPECT_EQ(expected, c);
+    }
+
+    /// Checks a number of matrix sizes. The sizes include matrices
+    /// smaller than a single tile and matrices spanning several tiles
+    template<class Stack>
+    void check_matrix_multiply_sizes()
+    {
+        check_matrix_multiply<Stack>(1, 1, 1);
+        check_matrix_multiply<Stack>(3, 5, 17);
+        check_matrix_multiply<Stack>(8, 8, 100);
+
+        // Span several tiles in both the column and the row direction
+        typedef typename Stack::field_type field_type;
+        uint32_t length = fifi::size_to_length<field_type>(
+            2 * fifi::matrix_multiply_tile_size) + 3;
+
+        check_matrix_multiply<Stack>(
+            5, fifi::matrix_multiply_tile_rows + 7, length);
+    }
+}
+
+TEST(test_matrix_multiply, binary)
+{
+    check_matrix_multiply_sizes<fifi::simple_online<fifi::binary>>();
+}
+
+TEST(test_matrix_multiply, binary4)
+{
+    check_matrix_multiply_sizes<fifi::full_table<fifi::binary4>>();
+}
+
+TEST(test_matrix_multiply, binary8)
+{
+    check_matrix_multiply_sizes<fifi::full_table<fifi::binary8>>();
+}
+
+TEST(test_matrix_multiply, binary16)
+{
+    check_matrix_multiply_sizes<fifi::split_table<fifi::binary16>>();
+}
+
+TEST(test_matrix_multiply, binary32)
+{
+    check_matrix_multiply_sizes<fifi::carryless_online<fifi::binary32>>();
+}
+
+TEST(test_matrix_multiply, prime2325)
+{
+    check_matrix_multiply_sizes<fifi::optimal_prime<fifi::prime2325>>();
+}
@@ -61,3 +61,23 @@ TEST(test_neon_binary4_full_table, region_multiply_subtract)
             fifi::neon_binary4_full_table>();
     }
 }
+
+TEST(test_neon_binary4_full_table, region_linear_combination)
+{
+    fifi::neon_binary4_full_table stack;
+    if (stack.enabled())
+    {
+        check_results_region_linear_combination<
+            fifi::neon_binary4_full_table>();
+    }
+}
+
+TEST(test_neon_binary4_full_table, region_multiply_add_many)
+{
+    fifi::neon_binary4_full_table stack;
+    if (stack.enabled())
+    {
+        check_results_region_multiply_add_many<
+            fifi::neon_binary4_full_table>();
+    }
+}
@@ -0,0 +1,63 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <gtest/gtest.h>
+
+#include <cpuid/cpuinfo.hpp>
+
+#include <fifi/pclmul_binary32_online.hpp>
+
+#include "fifi_unit_test/helper_test_arithmetic.hpp"
+#include "fifi_unit_test/helper_test_packed_arithmetic.hpp"
+#include "fifi_unit_test/helper_test_region_arithmetic.hpp"
+
+
+TEST(test_pclmul_binary32_online, region_add)
+{
+    fifi::pclmul_binary32_online stack;
+    if (stack.enabled())
+    {
+        check_results_region_add<fifi::pclmul_binary32_online>();
+    }
+}
+
+TEST(test_pclmul_binary32_online, region_subtract)
+{
+    fifi::pclmul_binary32_online stack;
+    if (stack.enabled())
+    {
+        check_results_region_subtract<fifi::pclmul_binary32_online>();
+    }
+}
+
+TEST(test_pclmul_binary32_online, region_multiply_constant)
+{
+    fifi::pclmul_binary32_online stack;
+    if (stack.enabled())
+    {
+        check_results_region_multiply_constant<
+            fifi::pclmul_binary32_online>();
+    }
+}
+
+TEST(test_pclmul_binary32_online, region_multiply_add)
+{
+    fifi::pclmul_binary32_online stack;
+    if (stack.enabled())
+    {
+        check_results_region_multiply_add<
+            fifi::pclmul_binary32_online>();
+    }
+}
+
+TEST(test_pclmul_binary32_online, region_multiply_subtract)
+{
+    fifi::pclmul_binary32_online stack;
+    if (stack.enabled())
+    {
+        check_results_region_multiply_subtract<
+            fifi::pclmul_binary32_online>();
+    }
+}
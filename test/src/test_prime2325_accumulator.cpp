@@ -0,0 +1,96 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <cstdint>
+#include <vector>
+
+#include <fifi/optimal_prime.hpp>
+#include <fifi/prime2325.hpp>
+#include <fifi/prime2325_accumulator.hpp>
+
+#include <gtest/gtest.h>
+
+#include "fifi_unit_test/random_constant.hpp"
+
+TEST(test_prime2325_accumulator, multiply_add_chain)
+{
+    uint32_t length = 100;
+    uint32_t terms = 300;
+
+    fifi::optimal_prime<fifi::prime2325> field;
+    fifi::prime2325_accumulator accumulator(length);
+    fifi::random_constant<fifi::prime2325> random;
+
+    EXPECT_EQ(length, accumulator.length());
+
+    std::vector<uint32_t> dest(length);
+    std::vector<uint32_t> src(length);
+
+    for (uint32_t i = 0; i < length; ++i)
+    {
+        dest[i] = random.value() % fifi::prime2325::prime;
+    }
+
+    std::vector<uint32_t> expected = dest;
+    accumulator.add(&dest[0]);
+
+    for (uint32_t j = 0; j < terms; ++j)
+    {
+        for (uint32_t i = 0; i < length; ++i)
+        {
+            src[i] = random.value() % fifi::prime2325::prime;
+        }
+
+        // Use the largest elements for some of the terms since these
+        // give the largest partial sums
+        if (j % 10 == 0)
+        {
+            std::fill(src.begin(), src.end(), fifi::prime2325::prime - 1);
+        }
+
+        uint32_t constant = random.value() % fifi::prime2325::prime;
+
+        if (j % 3 == 0)
+        {
+            field.region_multiply_subtract(
+                &expected[0], &src[0], constant, length);
+            accumulator.multiply_subtract(&src[0], constant);
+        }
+        else
+        {
+            field.region_multiply_add(&expected[0], &src[0], constant, length);
+            accumulator.multiply_add(&src[0], constant);
+        }
+    }
+
+    accumulator.finalize(&dest[0]);
+    EXPECT_EQ(expected, dest);
+}
+
+TEST(test_prime2325_accumulator, finalize_clears)
+{
+    uint32_t length = 4;
+    fifi::prime2325_accumulator accumulator(length);
+
+    std::vector<uint32_t> src(length, fifi::prime2325::prime - 1);
+    std::vector<uint32_t> dest(length, 1);
+
+    accumulator.multiply_add(&src[0], fifi::prime2325::prime - 1);
+    accumulator.finalize(&dest[0]);
+
+    // (p - 1) * (p - 1) = 1 mod p
+    EXPECT_EQ(std::vector<uint32_t>(length, 1), dest);
+
+    // Nothing is accumulated after finalize
+    accumulator.finalize(&dest[0]);
+    EXPECT_EQ(std::vector<uint32_t>(length, 0), dest);
+
+    // Zero constants
+    accumulator.add(&src[0]);
+    accumulator.multiply_subtract(&src[0], 0);
+    accumulator.multiply_add(&src[0], 0);
+    accumulator.finalize(&dest[0]);
+    EXPECT_EQ(src, dest);
+}
@@ -4,8 +4,11 @@
 // http://www.steinwurf.com/licensing
 
 #include <cstdint>
+#include <memory>
+#include <vector>
 
 #include <fifi/prime2325_binary_search.hpp>
+#include <fifi/thread_pool.hpp>
 
 #include <gtest/gtest.h>
 
@@ -75,3 +78,79 @@ TEST(test_prime2325_binary_search, find_a_prefix)
     uint32_t bits = (rand() % 200000) + 1;
     fifi::helper_prime2325_find_a_prefix<fifi::prime2325_binary_search>(bits);
 }
+
+/// The search is split across a thread pool and must find the same
+/// prefix as the search on the calling thread
+TEST(test_prime2325_binary_search, parallel)
+{
+    auto pool = std::make_shared<fifi::thread_pool>(4);
+
+    uint32_t block_lengths[] = { 1000, 300001 };
+
+    for (uint32_t block_length : block_lengths)
+    {
+        // The values share few prefixes in the first half of the block,
+        // so the buckets differ a lot between the parts of the block
+        std::vector<uint32_t> data(block_length);
+        for (uint32_t i = 0; i < block_length; ++i)
+        {
+            data[i] = i < block_length / 2 ?
+                (uint32_t) (rand() % 7) << 28 :
+                (uint32_t) rand() * 2U + (rand() & 1);
+        }
+
+        // Split the block in storage objects of different sizes
+        const uint8_t* bytes = (const uint8_t*) data.data();
+        uint32_t split = block_length / 5;
+
+        std::vector<sak::const_storage> storage;
+        storage.push_back(sak::const_storage(bytes, split * 4));
+        storage.push_back(sak::const_storage(bytes + split * 4, 4));
+        storage.push_back(sak::const_storage(
+            bytes + (split + 1) * 4, (block_length - split - 1) * 4));
+
+        for (uint32_t k = 1; k <= 4; ++k)
+        {
+            SCOPED_TRACE(testing::Message() << "length: " << block_length
+                         << " k: " << k);
+
+            fifi::prime2325_binary_search serial(block_length, k);
+            fifi::prime2325_binary_search parallel(block_length, k);
+
+            parallel.set_pool(pool);
+            parallel.set_parallel_threshold(0);
+            EXPECT_TRUE(parallel.is_parallel(block_length));
+
+            uint32_t expected =
+                serial.find_prefix(storage.begin(), storage.end());
+            uint32_t prefix =
+                parallel.find_prefix(storage.begin(), storage.end());
+
+            EXPECT_EQ(expected, prefix);
+            EXPECT_EQ(serial.m_buckets, parallel.m_buckets);
+        }
+    }
+}
+
+TEST(test_prime2325_binary_search, parallel_threshold)
+{
+    fifi::prime2325_binary_search search(1000000);
+
+    EXPECT_EQ(fifi::prime2325_binary_search_parallel_size / 4,
+              search.parallel_threshold());
+
+    // Without a pool, or with a pool of one thread, the search runs on
+    // the calling thread
+    EXPECT_FALSE(search.is_parallel(1000000));
+
+    search.set_pool(std::make_shared<fifi::thread_pool>(1));
+    EXPECT_FALSE(search.is_parallel(1000000));
+
+    search.set_pool(std::make_shared<fifi::thread_pool>(2));
+    EXPECT_TRUE(search.is_parallel(1000000));
+    EXPECT_FALSE(search.is_parallel(1000));
+
+    search.set_parallel_threshold(1000);
+    EXPECT_TRUE(search.is_parallel(1000));
+    EXPECT_FALSE(search.is_parallel(999));
+}
@@ -3,6 +3,7 @@
 // See accompanying file LICENSE.rst or
 // http://www.steinwurf.com/licensing
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
@@ -77,3 +78,119 @@ TEST(test_prime2325_bitmap, find_a_prefix)
     uint32_t bits = (rand() % 200000) + 1;
     fifi::helper_prime2325_find_a_prefix<fifi::prime2325_bitmap>(bits);
 }
+
+/// Compares the search of the bitmap with a bit by bit search
+TEST(test_prime2325_bitmap, find_in_bitmap)
+{
+    // A block length of 2^20 gives a bitmap of 2^21 bits
+    uint32_t block_length = 1 << 20;
+    fifi::prime2325_bitmap p(block_length);
+
+    uint32_t words = (uint32_t) p.m_bitmap.size();
+    ASSERT_EQ(65536U, words);
+
+    // The position of the first unused prefix, including positions in
+    // the middle of, at the start of and at the end of 256 bit chunks
+    uint32_t positions[] =
+        { 0, 1, 31, 32, 255, 256, 257, 1000, 65535 * 32 + 31, 12345678 };
+
+    for (uint32_t position : positions)
+    {
+        SCOPED_TRACE(testing::Message() << "position: " << position);
+
+        std::fill(p.m_bitmap.begin(), p.m_bitmap.end(), 0xffffffffU);
+
+        if (position < words * 32)
+        {
+            p.m_bitmap[position / 32] &= ~(1U << (position % 32));
+
+            // Unused prefixes after the first one must not matter
+            for (uint32_t i = position / 32 + 1; i < words; i += 7)
+            {
+                p.m_bitmap[i] = 0x12345678U;
+            }
+        }
+
+        uint32_t prefix = 0;
+        bool found = p.find_in_bitmap(&prefix);
+
+        if (position < words * 32)
+        {
+            EXPECT_TRUE(found);
+            EXPECT_EQ(position << p.m_shift_prefix, prefix);
+        }
+        else
+        {
+            EXPECT_FALSE(found);
+        }
+    }
+}
+
+/// The data uses the lowest prefixes, so the whole bitmap up to the
+/// unused prefix must be searched
+TEST(test_prime2325_bitmap, find_prefix_sequential)
+{
+    uint32_t block_length = 100000;
+    fifi::prime2325_bitmap p(block_length);
+
+    std::vector<uint32_t> data(block_length);
+    for (uint32_t i = 0; i < block_length; ++i)
+    {
+        data[i] = i << p.m_shift_prefix;
+    }
+
+    uint32_t prefix = p.find_prefix(sak::storage(data));
+    EXPECT_EQ(block_length << p.m_shift_prefix, prefix);
+    // The bitmap is rebuilt from scratch, so a block using the same
+    // prefixes as the previous one gives the same result
+    p.build_bitmap(sak::storage(data));
+
+    uint32_t found = 0;
+    EXPECT_TRUE(p.find_in_bitmap(&found));
+    EXPECT_EQ(prefix, found);
+}
+
+/// Compares the bitmap built from a number of storage objects with the
+/// bitmap updated one value at a time
+TEST(test_prime2325_bitmap, build_bitmap)
+{
+    // Small and large blocks use a different number of private bitmaps
+    // when AVX2 is available
+    uint32_t block_lengths[] = { 100, 1 << 20 };
+
+    for (uint32_t block_length : block_lengths)
+    {
+        SCOPED_TRACE(testing::Message() << "length: " << block_length);
+
+        fifi::prime2325_bitmap p(block_length);
+
+        // The values share few prefixes in the first half of the block
+        std::vector<uint32_t> data(block_length);
+        for (uint32_t i = 0; i < block_length; ++i)
+        {
+            data[i] = i < block_length / 2 ?
+                (uint32_t) (rand() % 5) << p.m_shift_prefix :
+                (uint32_t) rand() * 2U + (rand() & 1);
+        }
+
+        // Split the block in storage objects of odd sizes
+        uint32_t split = (block_length / 3) | 1;
+        const uint8_t* bytes = (const uint8_t*) data.data();
+
+        std::vector<sak::const_storage> storage;
+        storage.push_back(sak::const_storage(bytes, split * 4));
+        storage.push_back(sak::const_storage(
+            bytes + split * 4, (block_length - split) * 4));
+
+        p.build_bitmap(storage.begin(), storage.end());
+
+        std::vector<uint32_t> expected(p.m_bitmap.size(), 0);
+        for (uint32_t value : data)
+        {
+            uint32_t prefix = value >> p.m_shift_prefix;
+            expected[prefix / 32] |= 1U << (prefix % 32);
+        }
+
+        EXPECT_EQ(expected, p.m_bitmap);
+    }
+}
@@ -0,0 +1,113 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <fifi/prime2325.hpp>
+#include <fifi/prime2325_binary_search.hpp>
+#include <fifi/prime2325_bitmap.hpp>
+#include <fifi/prime2325_mapper.hpp>
+
+#include <gtest/gtest.h>
+
+#include <sak/storage.hpp>
+
+namespace
+{
+    /// Maps a block split in storage objects of different sizes, in
+    /// place and to a destination buffer, and compares the result with
+    /// searching and applying the prefix separately
+    template<class Search>
+    void check_map(uint32_t block_length)
+    {
+        SCOPED_TRACE(testing::Message() << "length: " << block_length);
+
+        std::vector<uint32_t> original(block_length);
+        for (uint32_t i = 0; i < block_length; ++i)
+        {
+            original[i] = (uint32_t) rand() * 2U + (rand() & 1);
+        }
+
+        Search search(block_length);
+        uint32_t expected_prefix = search.find_prefix(sak::storage(original));
+
+        fifi::prime2325_mapper<Search> mapper(block_length);
+
+        // A short chunk length so the blocks are applied in many chunks
+        mapper.set_chunk_length(7);
+
+        std::vector<uint32_t> data = original;
+        uint8_t* bytes = (uint8_t*) data.data();
+        uint32_t split = block_length / 3;
+
+        std::vector<sak::mutable_storage> storage;
+        storage.push_back(sak::mutable_storage(bytes, split * 4));
+        storage.push_back(sak::mutable_storage(
+            bytes + split * 4, (block_length - split) * 4));
+
+        // Map to a destination buffer, the source must not change
+        std::vector<uint32_t> dest(block_length);
+        uint32_t prefix =
+            mapper.map_to(storage.begin(), storage.end(), dest.data());
+
+        EXPECT_EQ(expected_prefix, prefix);
+        EXPECT_EQ(original, data);
+
+        for (uint32_t i = 0; i < block_length; ++i)
+        {
+            EXPECT_EQ(original[i] ^ ~prefix, dest[i]);
+            EXPECT_LT(dest[i], fifi::prime2325::prime);
+        }
+
+        // Map in place
+        prefix = mapper.map(storage.begin(), storage.end());
+
+        EXPECT_EQ(expected_prefix, prefix);
+        EXPECT_EQ(dest, data);
+    }
+}
+
+TEST(test_prime2325_mapper, chunk_length)
+{
+    fifi::prime2325_mapper<fifi::prime2325_bitmap> mapper(1000);
+
+    EXPECT_EQ(fifi::prime2325_mapper_chunk_size / 4, mapper.chunk_length());
+
+    mapper.set_chunk_length(100);
+    EXPECT_EQ(100U, mapper.chunk_length());
+}
+
+TEST(test_prime2325_mapper, bitmap)
+{
+    check_map<fifi::prime2325_bitmap>(1);
+    check_map<fifi::prime2325_bitmap>(100);
+    check_map<fifi::prime2325_bitmap>(10001);
+}
+
+TEST(test_prime2325_mapper, binary_search)
+{
+    check_map<fifi::prime2325_binary_search>(1);
+    check_map<fifi::prime2325_binary_search>(100);
+    check_map<fifi::prime2325_binary_search>(10001);
+}
+
+TEST(test_prime2325_mapper, sequence)
+{
+    uint32_t block_length = 1000;
+
+    std::vector<uint32_t> data(block_length, 0xffffffffU);
+    std::vector<uint32_t> dest(block_length);
+
+    fifi::prime2325_mapper<fifi::prime2325_bitmap> mapper(block_length);
+
+    uint32_t prefix = mapper.map_to(sak::storage(data), dest.data());
+    EXPECT_EQ(std::vector<uint32_t>(block_length, ~prefix ^ 0xffffffffU),
+              dest);
+
+    mapper.map(sak::storage(data));
+    EXPECT_EQ(dest, data);
+}
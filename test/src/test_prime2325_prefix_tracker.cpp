@@ -0,0 +1,107 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <fifi/prime2325_bitmap.hpp>
+#include <fifi/prime2325_prefix_tracker.hpp>
+
+#include <gtest/gtest.h>
+
+#include <sak/storage.hpp>
+
+/// Adds a block in pieces and checks the prefix after every piece
+/// against a search of all values added so far
+TEST(test_prime2325_prefix_tracker, add)
+{
+    // Small and large blocks use a different number of private bitmaps
+    // when AVX2 is available
+    uint32_t block_lengths[] = { 100, 200000 };
+
+    for (uint32_t block_length : block_lengths)
+    {
+        SCOPED_TRACE(testing::Message() << "length: " << block_length);
+
+        fifi::prime2325_prefix_tracker tracker(block_length);
+        EXPECT_EQ(block_length, tracker.max_block_length());
+
+        // Without any values the lowest prefix is unused
+        EXPECT_EQ(0U, tracker.prefix());
+
+        // The lowest prefixes are used first, so the prefix changes as
+        // the pieces are added
+        fifi::prime2325_bitmap search(block_length);
+
+        std::vector<uint32_t> data(block_length);
+        for (uint32_t i = 0; i < block_length; ++i)
+        {
+            data[i] = i % 2 == 0 ?
+                (i / 2) << search.m_shift_prefix :
+                (uint32_t) rand() * 2U + (rand() & 1);
+        }
+
+        uint32_t piece = block_length / 7 + 1;
+        for (uint32_t offset = 0; offset < block_length; offset += piece)
+        {
+            uint32_t size = std::min(piece, block_length - offset);
+            tracker.add(data.data() + offset, size);
+
+            EXPECT_EQ(offset + size, tracker.length());
+
+            uint32_t expected = search.find_prefix(
+                sak::storage(data.data(), (offset + size) * 4));
+            EXPECT_EQ(expected, tracker.prefix());
+
+            // Asking again without adding values gives the same prefix
+            EXPECT_EQ(expected, tracker.prefix());
+        }
+    }
+}
+
+TEST(test_prime2325_prefix_tracker, storage)
+{
+    uint32_t block_length = 1000;
+
+    std::vector<uint32_t> data(block_length, 0xffffffffU);
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        data[i] = i;
+    }
+
+    fifi::prime2325_prefix_tracker tracker(block_length);
+    tracker.add(sak::storage(data));
+
+    EXPECT_EQ(block_length, tracker.length());
+
+    fifi::prime2325_bitmap search(block_length);
+    EXPECT_EQ(search.find_prefix(sak::storage(data)), tracker.prefix());
+
+    for (uint32_t value : data)
+    {
+        EXPECT_NE(value >> search.m_shift_prefix,
+                  tracker.prefix() >> search.m_shift_prefix);
+    }
+}
+
+TEST(test_prime2325_prefix_tracker, reset)
+{
+    uint32_t block_length = 1000;
+    fifi::prime2325_prefix_tracker tracker(block_length);
+
+    std::vector<uint32_t> data(block_length, 0);
+    tracker.add(data.data(), block_length);
+    EXPECT_NE(0U, tracker.prefix());
+
+    tracker.reset();
+    EXPECT_EQ(0U, tracker.length());
+    EXPECT_EQ(0U, tracker.prefix());
+
+    // The tracker can be used for a new block after a reset
+    tracker.add(data.data(), block_length);
+    EXPECT_NE(0U, tracker.prefix());
+}
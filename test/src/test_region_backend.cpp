@@ -0,0 +1,48 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <string>
+
+#include <fifi/region_backend.hpp>
+
+#include <gtest/gtest.h>
+
+TEST(test_region_backend, name)
+{
+    const fifi::region_backend backends[] =
+    {
+        fifi::region_backend::automatic,
+        fifi::region_backend::basic,
+        fifi::region_backend::ssse3,
+        fifi::region_backend::sse41,
+        fifi::region_backend::pclmul,
+        fifi::region_backend::avx2,
+        fifi::region_backend::neon
+    };
+
+    for (fifi::region_backend backend : backends)
+    {
+        std::string name = fifi::region_backend_name(backend);
+        SCOPED_TRACE(name);
+
+        fifi::region_backend parsed = fifi::region_backend::automatic;
+        EXPECT_TRUE(fifi::region_backend_from_name(name, &parsed));
+        EXPECT_EQ(backend, parsed);
+    }
+
+    EXPECT_EQ(std::string("basic"),
+              fifi::region_backend_name(fifi::region_backend::basic));
+}
+
+TEST(test_region_backend, invalid_name)
+{
+    fifi::region_backend backend = fifi::region_backend::ssse3;
+
+    EXPECT_FALSE(fifi::region_backend_from_name("", &backend));
+    EXPECT_FALSE(fifi::region_backend_from_name("SSSE3", &backend));
+    EXPECT_FALSE(fifi::region_backend_from_name("sse2", &backend));
+
+    EXPECT_EQ(fifi::region_backend::ssse3, backend);
+}
@@ -0,0 +1,198 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <fifi/binary8.hpp>
+#include <fifi/binary16.hpp>
+#include <fifi/full_table.hpp>
+#include <fifi/optimal_prime.hpp>
+#include <fifi/prime2325.hpp>
+#include <fifi/region_batch.hpp>
+#include <fifi/region_thresholds.hpp>
+#include <fifi/split_table.hpp>
+#include <fifi/work_stealing_scheduler.hpp>
+
+#include <gtest/gtest.h>
+
+#include "fifi_unit_test/random_constant.hpp"
+
+namespace
+{
+    /// Computes an operation by calling the stack directly
+    template<class Stack>
+    void compute(const Stack& stack, fifi::region_thresholds::operation op,
+        typename Stack::value_type* dest,
+        const typename Stack::value_type* src,
+        typename Stack::value_type constant, uint32_t length)
+    {
+        switch (op)
+        {
+        case fifi::region_thresholds::region_add:
+            stack.region_add(dest, src, length);
+            break;
+        case fifi::region_thresholds::region_subtract:
+            stack.region_subtract(dest, src, length);
+            break;
+        case fifi::region_thresholds::region_multiply:
+            stack.region_multiply(dest, src, length);
+            break;
+        case fifi::region_thresholds::region_divide:
+            stack.region_divide(dest, src, length);
+            break;
+        case fifi::region_thresholds::region_multiply_constant:
+            stack.region_multiply_constant(dest, constant, length);
+            break;
+        case fifi::region_thresholds::region_multiply_add:
+            stack.region_multiply_add(dest, src, constant, length);
+            break;
+        case fifi::region_thresholds::region_multiply_subtract:
+            stack.region_multiply_subtract(dest, src, constant, length);
+            break;
+        default:
+            ADD_FAILURE() << "Unexpected operation";
+            break;
+        }
+    }
+
+    /// Checks that a batch of operations computes the same results as
+    /// calling the stack for each operation
+    template<class Stack>
+    void check_batch()
+    {
+        typedef typename Stack::field_type field_type;
+        typedef typename Stack::value_type value_type;
+
+        Stack stack;
+        fifi::work_stealing_scheduler scheduler(3);
+        fifi::random_constant<field_type> constants;
+
+        const fifi::region_thresholds::operation ops[] =
+        {
+            fifi::region_thresholds::region_add,
+            fifi::region_thresholds::region_subtract,
+            fifi::region_thresholds::region_multiply,
+            fifi::region_thresholds::region_divide,
+            fifi::region_thresholds::region_multiply_constant,
+            fifi::region_thresholds::region_multiply_add,
+            fifi::region_thresholds::region_multiply_subtract
+        };
+
+        // One operation per destination, so the operations are
+        // independent
+        const uint32_t operations = 70;
+        const uint32_t length = 100;
+
+        std::vector<value_type> src(length);
+        for (auto& v : src)
+        {
+            // The source is non-zero so it can be used as divisor
+            v = std::max<value_type>(constants.pack(), 1);
+        }
+
+        std::vector<std::vector<value_type>> dests(operations);
+        for (auto& dest : dests)
+        {
+            dest.resize(length);
+            for (auto& v : dest)
+            {
+                v = constants.pack();
+            }
+        }
+
+        std::vector<std::vector<value_type>> expected = dests;
+
+        fifi::region_batch<Stack> batch(stack);
+
+        for (uint32_t i = 0; i < operations; ++i)
+        {
+            auto op = ops[i % (sizeof(ops) / sizeof(ops[0]))];
+            value_type constant = constants.pack();
+
+            // Operations of different lengths take different times
+            uint32_t op_length = 1 + (i * 37) % length;
+
+            batch.add(op, dests[i].data(), src.data(), constant, op_length);
+
+            compute(stack, op, expected[i].data(), src.data(), constant,
+                op_length);
+        }
+
+        EXPECT_EQ(operations, batch.tasks());
+
+        std::atomic<uint32_t> callbacks(0);
+        scheduler.submit(batch, [&] { ++callbacks; });
+        batch.wait();
+
+        EXPECT_EQ(1U, callbacks.load());
+        EXPECT_EQ(expected, dests);
+
+        // The batch can be run again
+        expected = dests;
+        for (uint32_t i = 0; i < operations; ++i)
+        {
+            const auto& o = batch.operation(i);
+            compute(stack, o.m_op, expected[i].data(), o.m_src,
+                o.m_constant, o.m_length);
+        }
+
+        scheduler.submit(batch);
+        batch.wait();
+
+        EXPECT_EQ(expected, dests);
+        EXPECT_EQ(1U, callbacks.load());
+    }
+}
+
+TEST(test_region_batch, add)
+{
+    typedef fifi::full_table<fifi::binary8> stack_type;
+
+    stack_type stack;
+    fifi::region_batch<stack_type> batch(stack);
+    EXPECT_EQ(0U, batch.tasks());
+    EXPECT_TRUE(batch.is_done());
+
+    uint8_t dest[4];
+    uint8_t src[4];
+
+    batch.add(fifi::region_thresholds::region_multiply_add, dest, src, 3, 4);
+    batch.add(fifi::region_thresholds::region_multiply_constant, dest, 0,
+              5, 2);
+
+    ASSERT_EQ(2U, batch.tasks());
+
+    EXPECT_EQ(fifi::region_thresholds::region_multiply_add,
+              batch.operation(0).m_op);
+    EXPECT_EQ(dest, batch.operation(0).m_dest);
+    EXPECT_EQ(src, batch.operation(0).m_src);
+    EXPECT_EQ(3U, batch.operation(0).m_constant);
+    EXPECT_EQ(4U, batch.operation(0).m_length);
+
+    EXPECT_EQ(fifi::region_thresholds::region_multiply_constant,
+              batch.operation(1).m_op);
+    EXPECT_EQ(2U, batch.operation(1).m_length);
+
+    batch.clear();
+    EXPECT_EQ(0U, batch.tasks());
+}
+
+TEST(test_region_batch, binary8)
+{
+    check_batch<fifi::full_table<fifi::binary8>>();
+}
+
+TEST(test_region_batch, binary16)
+{
+    check_batch<fifi::split_table<fifi::binary16>>();
+}
+
+TEST(test_region_batch, prime2325)
+{
+    check_batch<fifi::optimal_prime<fifi::prime2325>>();
+}
@@ -0,0 +1,137 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <fifi/binary4.hpp>
+#include <fifi/binary8.hpp>
+#include <fifi/binary16.hpp>
+#include <fifi/binary32.hpp>
+#include <fifi/carryless_online.hpp>
+#include <fifi/fifi_utils.hpp>
+#include <fifi/full_table.hpp>
+#include <fifi/optimal_prime.hpp>
+#include <fifi/prime2325.hpp>
+#include <fifi/region_calibration.hpp>
+#include <fifi/region_thresholds.hpp>
+#include <fifi/split_table.hpp>
+
+#include <gtest/gtest.h>
+
+#include "fifi_unit_test/random_constant.hpp"
+
+namespace
+{
+    /// Checks that the thresholds found for a stack are valid, and that
+    /// the stack computes the same results with the thresholds set
+    template<class Stack>
+    void check_calibration()
+    {
+        typedef typename Stack::field_type field_type;
+        typedef typename Stack::value_type value_type;
+
+        Stack stack;
+
+        const uint32_t max_size = 256;
+        const uint32_t max_length = fifi::size_to_length<field_type>(max_size);
+
+        fifi::region_thresholds thresholds =
+            fifi::calibrate_region_thresholds(stack, max_size);
+
+        for (uint32_t i = 0; i < fifi::region_thresholds::operations; ++i)
+        {
+            auto op = (fifi::region_thresholds::operation) i;
+            SCOPED_TRACE(fifi::region_thresholds::name(op));
+
+            uint32_t threshold = thresholds[op];
+
+            // The thresholds are zero, one of the measured lengths, or
+            // the maximum if the basic layers are always faster
+            if (threshold == 0 ||
+                threshold == std::numeric_limits<uint32_t>::max())
+            {
+                continue;
+            }
+
+            EXPECT_EQ(0U, threshold & (threshold - 1));
+            EXPECT_EQ(0U, threshold % stack.granularity());
+            EXPECT_GT(threshold, stack.granularity());
+            EXPECT_LE(threshold, max_length);
+        }
+
+        // Using the basic layers for all lengths must give the same
+        // results as the default thresholds
+        fifi::region_thresholds basic_thresholds;
+        for (uint32_t i = 0; i < fifi::region_thresholds::operations; ++i)
+        {
+            auto op = (fifi::region_thresholds::operation) i;
+            basic_thresholds[op] = std::numeric_limits<uint32_t>::max();
+        }
+
+        Stack basic_stack;
+        basic_stack.set_thresholds(basic_thresholds);
+
+        fifi::random_constant<field_type> constants;
+
+        for (uint32_t length = 1; length <= max_length; length += 7)
+        {
+            SCOPED_TRACE(testing::Message() << "length: " << length);
+
+            std::vector<value_type> src(length);
+            for (auto& v : src)
+            {
+                v = constants.pack();
+            }
+
+            std::vector<value_type> dest(length);
+            for (auto& v : dest)
+            {
+                v = constants.pack();
+            }
+
+            std::vector<value_type> basic_dest = dest;
+            value_type constant = constants.pack();
+
+            stack.region_multiply_add(
+                dest.data(), src.data(), constant, length);
+            basic_stack.region_multiply_add(
+                basic_dest.data(), src.data(), constant, length);
+
+            EXPECT_EQ(basic_dest, dest);
+
+            stack.region_add(dest.data(), src.data(), length);
+            basic_stack.region_add(basic_dest.data(), src.data(), length);
+
+            EXPECT_EQ(basic_dest, dest);
+        }
+    }
+}
+
+TEST(test_region_calibration, binary4)
+{
+    check_calibration<fifi::full_table<fifi::binary4>>();
+}
+
+TEST(test_region_calibration, binary8)
+{
+    check_calibration<fifi::full_table<fifi::binary8>>();
+}
+
+TEST(test_region_calibration, binary16)
+{
+    check_calibration<fifi::split_table<fifi::binary16>>();
+}
+
+TEST(test_region_calibration, binary32)
+{
+    check_calibration<fifi::carryless_online<fifi::binary32>>();
+}
+
+TEST(test_region_calibration, prime2325)
+{
+    check_calibration<fifi::optimal_prime<fifi::prime2325>>();
+}
@@ -3,10 +3,15 @@
 // See accompanying file LICENSE.rst or
 // http://www.steinwurf.com/licensing
 
+#include <cstdint>
+
 #include <gtest/gtest.h>
 
 #include <fifi/binary.hpp>
+#include <fifi/has_region_operation.hpp>
+#include <fifi/region_backend.hpp>
 #include <fifi/region_dispatcher.hpp>
+#include <fifi/region_thresholds.hpp>
 #include "fifi_unit_test/helper_fall_through.hpp"
 #include "fifi_unit_test/helper_region_info.hpp"
 
@@ -14,9 +19,14 @@ namespace fifi
 {
     namespace
     {
-        template<bool Enabled, class Super>
+        template<bool Enabled, class Super,
+                 region_backend Backend = region_backend::ssse3>
         class dummy : public Super
         {
+        public:
+
+            static const region_backend backend = Backend;
+
         public:
 
             bool enabled() const
@@ -41,12 +51,25 @@ namespace fifi
                        /*max_granularity=*/30U,
                    helper_fall_through<binary> > >
         { };
+
+        template<bool Enabled>
+        class dummy_stack_nested :
+            public region_dispatcher<
+                   dummy<Enabled,
+                   helper_fall_through<binary>, region_backend::avx2>,
+                   region_dispatcher<
+                   dummy<true,
+                   helper_fall_through<binary>, region_backend::ssse3>,
+                   helper_fall_through<binary> > >
+        { };
     }
 }
 
 TEST(test_region_dispatcher, test_region_dispatcher)
 {
     fifi::dummy_stack stack;
+    stack.set_backend(fifi::region_backend::automatic);
+
     fifi::dummy_stack::BasicSuper& basic = stack;
     fifi::dummy_stack::OptimizedSuper& optimized = stack;
 
@@ -63,3 +86,75 @@ TEST(test_region_dispatcher, test_region_dispatcher)
     EXPECT_EQ(stack.max_alignment(), 20U);
     EXPECT_EQ(stack.max_granularity(), 40U);
 }
+
+TEST(test_region_dispatcher, backend)
+{
+    fifi::dummy_stack stack;
+    stack.set_backend(fifi::region_backend::automatic);
+
+    // The operations supported by the dispatch stack are dispatched to it
+    for (uint32_t i = 0; i < fifi::region_thresholds::operations; ++i)
+    {
+        auto op = (fifi::region_thresholds::operation) i;
+        SCOPED_TRACE(fifi::region_thresholds::name(op));
+
+        fifi::region_backend expected = fifi::has_region_operation<
+            fifi::helper_fall_through<fifi::binary>>(op) ?
+            fifi::region_backend::ssse3 : fifi::region_backend::basic;
+
+        EXPECT_EQ(expected, stack.backend(op));
+    }
+
+    stack.set_backend(fifi::region_backend::basic);
+    EXPECT_EQ(fifi::region_backend::basic,
+              stack.backend(fifi::region_thresholds::region_add));
+    EXPECT_EQ(3U, stack.granularity());
+    EXPECT_EQ(1U, stack.alignment());
+
+    // A backend which the dispatch stack does not use falls through
+    stack.set_backend(fifi::region_backend::avx2);
+    EXPECT_EQ(fifi::region_backend::basic,
+              stack.backend(fifi::region_thresholds::region_add));
+
+    stack.set_backend(fifi::region_backend::ssse3);
+    EXPECT_EQ(fifi::region_backend::ssse3,
+              stack.backend(fifi::region_thresholds::region_add));
+    EXPECT_EQ(4U, stack.granularity());
+}
+
+TEST(test_region_dispatcher, backend_nested)
+{
+    auto op = fifi::region_thresholds::region_multiply_add;
+
+    {
+        fifi::dummy_stack_nested<true> stack;
+
+        stack.set_backend(fifi::region_backend::automatic);
+        EXPECT_EQ(fifi::region_backend::avx2, stack.backend(op));
+
+        stack.set_backend(fifi::region_backend::ssse3);
+        EXPECT_EQ(fifi::region_backend::ssse3, stack.backend(op));
+
+        stack.set_backend(fifi::region_backend::basic);
+        EXPECT_EQ(fifi::region_backend::basic, stack.backend(op));
+
+        // Copies keep the selected backend
+        fifi::dummy_stack_nested<true> copy = stack;
+        EXPECT_EQ(fifi::region_backend::basic, copy.backend(op));
+
+        stack.set_backend(fifi::region_backend::avx2);
+        EXPECT_EQ(fifi::region_backend::avx2, stack.backend(op));
+        EXPECT_EQ(fifi::region_backend::basic, copy.backend(op));
+    }
+
+    {
+        // A disabled stack is not used even if it is forced
+        fifi::dummy_stack_nested<false> stack;
+
+        stack.set_backend(fifi::region_backend::automatic);
+        EXPECT_EQ(fifi::region_backend::ssse3, stack.backend(op));
+
+        stack.set_backend(fifi::region_backend::avx2);
+        EXPECT_EQ(fifi::region_backend::basic, stack.backend(op));
+    }
+}
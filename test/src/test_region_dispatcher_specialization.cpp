@@ -3,6 +3,9 @@
 // See accompanying file LICENSE.rst or
 // http://www.steinwurf.com/licensing
 
+#include <cstdint>
+#include <vector>
+
 #include <fifi/region_dispatcher_specialization.hpp>
 #include <fifi/binary.hpp>
 
@@ -201,3 +204,68 @@ TEST(test_region_dispatcher_specialization, region_multiply_constant)
     enabled_stack.region_multiply_subtract(
         dest.data(), src.data(), constant, length);
 }
+
+namespace fifi
+{
+    namespace
+    {
+        /// Dummy stack remembering the last instance called
+        class remembering_dummy
+        {
+        public:
+
+            typedef binary field_type;
+            typedef field_type::value_type value_type;
+
+        public:
+
+            void region_add(value_type*, const value_type*, uint32_t) const
+            {
+                m_last = this;
+            }
+
+            bool enabled() const
+            {
+                return true;
+            }
+
+            static const void* m_last;
+        };
+
+        const void* remembering_dummy::m_last = 0;
+
+        class dummy_stack_remembering :
+            public region_dispatcher_specialization<
+                       binary, remembering_dummy, binary,
+                       dummy<binary, false>>
+        { };
+
+        /// @return True if the pointer is inside the object
+        template<class T>
+        bool is_inside(const void* pointer, const T& object)
+        {
+            const uint8_t* begin = (const uint8_t*) &object;
+            const uint8_t* p = (const uint8_t*) pointer;
+            return p >= begin && p < begin + sizeof(T);
+        }
+    }
+}
+
+TEST(test_region_dispatcher_specialization, copy)
+{
+    uint32_t length = 1;
+    std::vector<uint8_t> dest(length);
+    std::vector<uint8_t> src(length);
+
+    fifi::dummy_stack_remembering stack;
+    fifi::dummy_stack_remembering copy(stack);
+
+    // The dispatch is resolved per stack type, the calls made on a copy
+    // must reach the stack embedded in the copy
+    copy.region_add(dest.data(), src.data(), length);
+    EXPECT_TRUE(fifi::is_inside(fifi::remembering_dummy::m_last, copy));
+    EXPECT_FALSE(fifi::is_inside(fifi::remembering_dummy::m_last, stack));
+
+    stack.region_add(dest.data(), src.data(), length);
+    EXPECT_TRUE(fifi::is_inside(fifi::remembering_dummy::m_last, stack));
+}
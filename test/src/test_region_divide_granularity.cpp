@@ -4,6 +4,7 @@
 // http://www.steinwurf.com/licensing
 
 #include <cstdint>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -13,6 +14,7 @@
 #include <fifi/binary16.hpp>
 #include <fifi/final.hpp>
 #include <fifi/region_divide_granularity.hpp>
+#include <fifi/region_thresholds.hpp>
 
 #include "fifi_unit_test/capture_calls.hpp"
 #include "fifi_unit_test/helper_fall_through.hpp"
@@ -277,3 +279,68 @@ TEST(test_region_divide_granularity, all)
         fifi::test_granularity<32>();
     }
 }
+
+TEST(test_region_divide_granularity, thresholds)
+{
+    typedef fifi::dummy_stack<fifi::binary8, 16U> stack_type;
+    typedef stack_type::value_type value_type;
+    typedef fifi::capture_calls<value_type> calls_type;
+
+    stack_type stack;
+
+    stack_type::BasicSuper& basic = stack;
+    stack_type::OptimizedSuper& optimized = stack;
+
+    EXPECT_EQ(fifi::region_thresholds(), stack.thresholds());
+
+    fifi::region_thresholds thresholds;
+    thresholds[fifi::region_thresholds::region_add] = 64U;
+    stack.set_thresholds(thresholds);
+
+    EXPECT_EQ(thresholds, stack.thresholds());
+
+    std::vector<value_type> dest(100);
+    std::vector<value_type> src(100);
+
+    // Below the threshold the basic layers process the whole buffer
+    {
+        calls_type basic_calls;
+        basic_calls.call_region_add(dest.data(), src.data(), 50U);
+
+        basic.clear();
+        optimized.clear();
+        stack.region_add(dest.data(), src.data(), 50U);
+
+        EXPECT_EQ(basic_calls, basic.m_calls);
+        EXPECT_EQ(calls_type(), optimized.m_calls);
+    }
+
+    // At the threshold the buffer is divided as usual
+    {
+        calls_type basic_calls;
+        basic_calls.call_region_add(dest.data() + 64, src.data() + 64, 4U);
+
+        calls_type optimized_calls;
+        optimized_calls.call_region_add(dest.data(), src.data(), 64U);
+
+        basic.clear();
+        optimized.clear();
+        stack.region_add(dest.data(), src.data(), 68U);
+
+        EXPECT_EQ(basic_calls, basic.m_calls);
+        EXPECT_EQ(optimized_calls, optimized.m_calls);
+    }
+
+    // The other operations are not affected
+    {
+        calls_type optimized_calls;
+        optimized_calls.call_region_subtract(dest.data(), src.data(), 48U);
+
+        basic.clear();
+        optimized.clear();
+        stack.region_subtract(dest.data(), src.data(), 48U);
+
+        EXPECT_EQ(calls_type(), basic.m_calls);
+        EXPECT_EQ(optimized_calls, optimized.m_calls);
+    }
+}
@@ -0,0 +1,270 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <fifi/binary8.hpp>
+#include <fifi/binary16.hpp>
+#include <fifi/full_table.hpp>
+#include <fifi/optimal_prime.hpp>
+#include <fifi/prime2325.hpp>
+#include <fifi/region_parallel.hpp>
+#include <fifi/split_table.hpp>
+#include <fifi/thread_pool.hpp>
+
+#include <gtest/gtest.h>
+
+#include "fifi_unit_test/random_constant.hpp"
+
+namespace
+{
+    /// A call recorded by the dummy stack
+    struct dummy_call
+    {
+        uint32_t m_offset;
+        uint32_t m_length;
+        std::thread::id m_thread;
+
+        bool operator<(const dummy_call& other) const
+        {
+            return m_offset < other.m_offset;
+        }
+    };
+
+    /// Stack recording the region_add() calls with a granularity of 16
+    class dummy_stack
+    {
+    public:
+
+        typedef fifi::binary8 field_type;
+        typedef field_type::value_type value_type;
+
+    public:
+
+        uint32_t granularity() const
+        {
+            return 16U;
+        }
+
+        void region_add(value_type* dest, const value_type* src,
+            uint32_t length) const
+        {
+            EXPECT_EQ(dest - m_dest, src - m_src);
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            dummy_call call =
+                { (uint32_t) (dest - m_dest), length,
+                  std::this_thread::get_id() };
+            m_calls.push_back(call);
+        }
+
+        /// The buffers passed to the calls
+        value_type* m_dest;
+        const value_type* m_src;
+
+        /// The recorded calls
+        mutable std::mutex m_mutex;
+        mutable std::vector<dummy_call> m_calls;
+    };
+
+    /// Checks that a parallel stack computes the same results as the
+    /// stack on the calling thread
+    template<class Stack>
+    void check_results()
+    {
+        typedef typename Stack::field_type field_type;
+        typedef typename Stack::value_type value_type;
+
+        fifi::region_parallel<Stack> parallel;
+        parallel.set_pool(std::make_shared<fifi::thread_pool>(4));
+        parallel.set_parallel_threshold(0);
+        parallel.set_chunk_length(100);
+
+        Stack stack;
+
+        fifi::random_constant<field_type> constants;
+
+        const uint32_t count = 3;
+        const uint32_t length = 1000;
+
+        std::vector<value_type> src(count * length);
+        for (auto& v : src)
+        {
+            // The sources are non-zero so they can be used as divisors
+            v = std::max<value_type>(constants.pack(), 1);
+        }
+
+        std::vector<value_type> dest(count * length);
+        for (auto& v : dest)
+        {
+            v = constants.pack();
+        }
+
+        std::vector<value_type> expected = dest;
+
+        std::vector<value_type> coefficients(count);
+        for (auto& c : coefficients)
+        {
+            c = constants.pack();
+        }
+
+        value_type constant = coefficients[0];
+
+        std::vector<const value_type*> srcs;
+        std::vector<value_type*> dests;
+        std::vector<value_type*> expected_dests;
+        for (uint32_t j = 0; j < count; ++j)
+        {
+            srcs.push_back(&src[j * length]);
+            dests.push_back(&dest[j * length]);
+            expected_dests.push_back(&expected[j * length]);
+        }
+
+        parallel.region_add(dests[0], srcs[0], length);
+        stack.region_add(expected_dests[0], srcs[0], length);
+        EXPECT_EQ(expected, dest);
+
+        parallel.region_subtract(dests[0], srcs[1], length);
+        stack.region_subtract(expected_dests[0], srcs[1], length);
+        EXPECT_EQ(expected, dest);
+
+        parallel.region_multiply(dests[0], srcs[2], length);
+        stack.region_multiply(expected_dests[0], srcs[2], length);
+        EXPECT_EQ(expected, dest);
+
+        parallel.region_divide(dests[1], srcs[0], length);
+        stack.region_divide(expected_dests[1], srcs[0], length);
+        EXPECT_EQ(expected, dest);
+
+        parallel.region_multiply_constant(dests[2], constant, length);
+        stack.region_multiply_constant(expected_dests[2], constant, length);
+        EXPECT_EQ(expected, dest);
+
+        parallel.region_multiply_add(dests[0], srcs[1], constant, length);
+        stack.region_multiply_add(expected_dests[0], srcs[1], constant, length);
+        EXPECT_EQ(expected, dest);
+
+        parallel.region_multiply_subtract(dests[1], srcs[2], constant, length);
+        stack.region_multiply_subtract(
+            expected_dests[1], srcs[2], constant, length);
+        EXPECT_EQ(expected, dest);
+
+        parallel.region_linear_combination(
+            dests[2], srcs.data(), coefficients.data(), count, length);
+        stack.region_linear_combination(
+            expected_dests[2], srcs.data(), coefficients.data(), count, length);
+        EXPECT_EQ(expected, dest);
+
+        parallel.region_multiply_add_many(
+            dests.data(), srcs[0], coefficients.data(), count, length);
+        stack.region_multiply_add_many(
+            expected_dests.data(), srcs[0], coefficients.data(), count, length);
+        EXPECT_EQ(expected, dest);
+    }
+}
+
+TEST(test_region_parallel, chunk_length)
+{
+    fifi::region_parallel<dummy_stack> stack;
+
+    EXPECT_EQ(fifi::region_parallel_chunk_size, stack.chunk_length());
+    EXPECT_EQ(fifi::region_parallel_threshold_size,
+              stack.parallel_threshold());
+    EXPECT_FALSE(stack.pool());
+
+    // The chunks are rounded down to a multiple of the granularity
+    stack.set_chunk_length(100);
+    EXPECT_EQ(96U, stack.chunk_length());
+
+    stack.set_chunk_length(5);
+    EXPECT_EQ(16U, stack.chunk_length());
+}
+
+TEST(test_region_parallel, calling_thread)
+{
+    std::vector<uint8_t> dest(1000);
+    std::vector<uint8_t> src(1000);
+
+    fifi::region_parallel<dummy_stack> stack;
+    stack.m_dest = dest.data();
+    stack.m_src = src.data();
+    stack.set_chunk_length(100);
+    stack.set_parallel_threshold(500);
+
+    // Without a pool all calls stay on the calling thread
+    stack.region_add(dest.data(), src.data(), 1000);
+
+    ASSERT_EQ(1U, stack.m_calls.size());
+    EXPECT_EQ(0U, stack.m_calls[0].m_offset);
+    EXPECT_EQ(1000U, stack.m_calls[0].m_length);
+    EXPECT_EQ(std::this_thread::get_id(), stack.m_calls[0].m_thread);
+
+    // Calls below the threshold stay on the calling thread
+    stack.set_pool(std::make_shared<fifi::thread_pool>(4));
+    stack.m_calls.clear();
+    stack.region_add(dest.data(), src.data(), 499);
+
+    ASSERT_EQ(1U, stack.m_calls.size());
+    EXPECT_EQ(499U, stack.m_calls[0].m_length);
+    EXPECT_EQ(std::this_thread::get_id(), stack.m_calls[0].m_thread);
+}
+
+TEST(test_region_parallel, chunks)
+{
+    std::vector<uint8_t> dest(1000);
+    std::vector<uint8_t> src(1000);
+
+    fifi::region_parallel<dummy_stack> stack;
+    stack.m_dest = dest.data();
+    stack.m_src = src.data();
+    stack.set_pool(std::make_shared<fifi::thread_pool>(4));
+    stack.set_parallel_threshold(500);
+    stack.set_chunk_length(100);
+
+    for (uint32_t length = 500; length <= 1000; ++length)
+    {
+        SCOPED_TRACE(testing::Message() << "length: " << length);
+
+        stack.m_calls.clear();
+        stack.region_add(dest.data(), src.data(), length);
+
+        std::vector<dummy_call> calls = stack.m_calls;
+        std::sort(calls.begin(), calls.end());
+
+        // The chunks cover the buffers and all but the last chunk have
+        // the chunk length, which is a multiple of the granularity
+        ASSERT_EQ((length + 95) / 96, calls.size());
+
+        uint32_t offset = 0;
+        for (const auto& call : calls)
+        {
+            EXPECT_EQ(offset, call.m_offset);
+            EXPECT_EQ(std::min(96U, length - offset), call.m_length);
+            offset += call.m_length;
+        }
+
+        EXPECT_EQ(length, offset);
+    }
+}
+
+TEST(test_region_parallel, binary8)
+{
+    check_results<fifi::full_table<fifi::binary8>>();
+}
+
+TEST(test_region_parallel, binary16)
+{
+    check_results<fifi::split_table<fifi::binary16>>();
+}
+
+TEST(test_region_parallel, prime2325)
+{
+    check_results<fifi::optimal_prime<fifi::prime2325>>();
+}
@@ -0,0 +1,257 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <cstdint>
+#include <vector>
+
+#include <fifi/binary4.hpp>
+#include <fifi/binary8.hpp>
+#include <fifi/binary16.hpp>
+#include <fifi/full_table.hpp>
+#include <fifi/optimal_prime.hpp>
+#include <fifi/prime2325.hpp>
+#include <fifi/region_queue.hpp>
+#include <fifi/split_table.hpp>
+
+#include <gtest/gtest.h>
+
+#include "fifi_unit_test/random_constant.hpp"
+
+namespace
+{
+    /// A call recorded by the dummy stack
+    struct dummy_call
+    {
+        char m_op;
+        const uint8_t* m_dest;
+        uint32_t m_length;
+
+        bool operator==(const dummy_call& other) const
+        {
+            return m_op == other.m_op && m_dest == other.m_dest &&
+                m_length == other.m_length;
+        }
+    };
+
+    /// Stack recording the calls with a granularity of 16
+    class dummy_stack
+    {
+    public:
+
+        typedef fifi::binary8 field_type;
+        typedef field_type::value_type value_type;
+
+    public:
+
+        uint32_t granularity() const
+        {
+            return 16U;
+        }
+
+        void region_add(value_type* dest, const value_type*,
+            uint32_t length) const
+        {
+            dummy_call call = { 'a', dest, length };
+            m_calls.push_back(call);
+        }
+
+        void region_multiply_constant(value_type* dest, value_type,
+            uint32_t length) const
+        {
+            dummy_call call = { 'c', dest, length };
+            m_calls.push_back(call);
+        }
+
+        void region_multiply_add(value_type* dest, const value_type*,
+            value_type, uint32_t length) const
+        {
+            dummy_call call = { 'm', dest, length };
+            m_calls.push_back(call);
+        }
+
+        mutable std::vector<dummy_call> m_calls;
+    };
+
+    /// Checks that the queue computes the same results as calling the
+    /// stack directly for a mix of operations on a few rows
+    template<class Stack>
+    void check_results()
+    {
+        typedef typename Stack::field_type field_type;
+        typedef typename Stack::value_type value_type;
+
+        Stack stack;
+        fifi::random_constant<field_type> constants;
+
+        const uint32_t rows = 4;
+
+        for (uint32_t length = 1; length < 300; length += 29)
+        {
+            SCOPED_TRACE(testing::Message() << "length: " << length);
+
+            std::vector<value_type> data(rows * length);
+            for (auto& v : data)
+            {
+                v = constants.pack();
+            }
+
+            std::vector<value_type> expected = data;
+
+            fifi::region_queue<Stack> queue(stack);
+            queue.set_block_length(32);
+
+            // Scale a row and add the other rows to it, then add the
+            // row to itself and use it as a source for another row
+            for (uint32_t r = 0; r < rows; ++r)
+            {
+                value_type* dest = &data[r * length];
+                value_type* expected_dest = &expected[r * length];
+
+                value_type constant = constants.pack();
+                queue.region_multiply_constant(dest, constant, length);
+                stack.region_multiply_constant(
+                    expected_dest, constant, length);
+
+                for (uint32_t k = 0; k < rows; ++k)
+                {
+                    if (k == r)
+                    {
+                        continue;
+                    }
+
+                    constant = constants.pack();
+                    queue.region_multiply_add(
+                        dest, &data[k * length], constant, length);
+                    stack.region_multiply_add(expected_dest,
+                        &expected[k * length], constant, length);
+                }
+
+                queue.region_add(dest, dest, length);
+                stack.region_add(expected_dest, expected_dest, length);
+
+                uint32_t next = (r + 1) % rows;
+                queue.region_add(&data[next * length], dest, length);
+                stack.region_add(
+                    &expected[next * length], expected_dest, length);
+            }
+
+            EXPECT_EQ(rows * (rows + 2), queue.size());
+
+            queue.flush();
+            EXPECT_EQ(0U, queue.size());
+            EXPECT_EQ(expected, data);
+        }
+    }
+}
+
+TEST(test_region_queue, block_length)
+{
+    dummy_stack stack;
+    fifi::region_queue<dummy_stack> queue(stack);
+
+    EXPECT_EQ(fifi::region_queue_block_size, queue.block_length());
+
+    // The blocks are rounded down to a multiple of the granularity
+    queue.set_block_length(100);
+    EXPECT_EQ(96U, queue.block_length());
+
+    queue.set_block_length(5);
+    EXPECT_EQ(16U, queue.block_length());
+}
+
+TEST(test_region_queue, fuse)
+{
+    dummy_stack stack;
+    fifi::region_queue<dummy_stack> queue(stack);
+    queue.set_block_length(64);
+
+    std::vector<uint8_t> dest(200);
+    std::vector<uint8_t> other(200);
+    std::vector<uint8_t> src(200);
+
+    // The first three operations are fused, the operation on the other
+    // destination is not
+    queue.region_multiply_constant(dest.data(), 2, 150);
+    queue.region_multiply_add(dest.data(), src.data(), 3, 150);
+    queue.region_add(dest.data(), src.data(), 150);
+    queue.region_add(other.data(), dest.data(), 150);
+
+    EXPECT_EQ(4U, queue.size());
+    EXPECT_TRUE(stack.m_calls.empty());
+
+    queue.flush();
+
+    uint8_t* d = dest.data();
+    std::vector<dummy_call> expected =
+    {
+        { 'c', d, 64 }, { 'm', d, 64 }, { 'a', d, 64 },
+        { 'c', d + 64, 64 }, { 'm', d + 64, 64 }, { 'a', d + 64, 64 },
+        { 'c', d + 128, 22 }, { 'm', d + 128, 22 }, { 'a', d + 128, 22 },
+        { 'a', other.data(), 150 }
+    };
+
+    EXPECT_TRUE(expected == stack.m_calls);
+}
+
+TEST(test_region_queue, not_fused)
+{
+    dummy_stack stack;
+    fifi::region_queue<dummy_stack> queue(stack);
+    queue.set_block_length(64);
+
+    std::vector<uint8_t> dest(300);
+    uint8_t* d = dest.data();
+
+    // Operations with different lengths or a source overlapping the
+    // destination at a different position are computed separately
+    queue.region_multiply_constant(d, 2, 150);
+    queue.region_multiply_constant(d, 2, 100);
+    queue.region_add(d, d + 10, 100);
+    queue.region_add(d, d + 100, 100);
+
+    queue.flush();
+
+    std::vector<dummy_call> expected =
+    {
+        { 'c', d, 150 }, { 'c', d, 100 }, { 'a', d, 100 }, { 'a', d, 100 }
+    };
+
+    EXPECT_TRUE(expected == stack.m_calls);
+}
+
+TEST(test_region_queue, destructor)
+{
+    dummy_stack stack;
+
+    std::vector<uint8_t> dest(16);
+
+    {
+        fifi::region_queue<dummy_stack> queue(stack);
+        queue.region_multiply_constant(dest.data(), 2, 16);
+    }
+
+    // The operations are computed when the queue is destroyed
+    EXPECT_EQ(1U, stack.m_calls.size());
+}
+
+TEST(test_region_queue, binary4)
+{
+    check_results<fifi::full_table<fifi::binary4>>();
+}
+
+TEST(test_region_queue, binary8)
+{
+    check_results<fifi::full_table<fifi::binary8>>();
+}
+
+TEST(test_region_queue, binary16)
+{
+    check_results<fifi::split_table<fifi::binary16>>();
+}
+
+TEST(test_region_queue, prime2325)
+{
+    check_results<fifi::optimal_prime<fifi::prime2325>>();
+}
@@ -0,0 +1,237 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <cstdint>
+#include <vector>
+
+#include <fifi/region_static_dispatcher_specialization.hpp>
+#include <fifi/binary.hpp>
+#include <fifi/binary8.hpp>
+
+#include <gtest/gtest.h>
+
+#include "fifi_unit_test/helper_region_info.hpp"
+
+namespace fifi
+{
+    namespace
+    {
+        /// Dummy stack counting the calls made to it
+        template<class Field, bool Enabled>
+        class dummy
+        {
+        public:
+
+            typedef Field field_type;
+            typedef typename field_type::value_type value_type;
+
+            static const bool statically_enabled = Enabled;
+
+        public:
+
+            dummy()
+                : m_calls(0)
+            { }
+
+            void region_add(value_type*, const value_type*, uint32_t) const
+            {
+                ++m_calls;
+            }
+
+            void region_subtract(value_type*, const value_type*,
+                uint32_t) const
+            {
+                ++m_calls;
+            }
+
+            void region_multiply(value_type*, const value_type*,
+                uint32_t) const
+            {
+                ++m_calls;
+            }
+
+            void region_divide(value_type*, const value_type*,
+                uint32_t) const
+            {
+                ++m_calls;
+            }
+
+            void region_multiply_constant(value_type*, value_type,
+                uint32_t) const
+            {
+                ++m_calls;
+            }
+
+            void region_multiply_add(value_type*, const value_type*,
+                value_type, uint32_t) const
+            {
+                ++m_calls;
+            }
+
+            void region_multiply_subtract(value_type*, const value_type*,
+                value_type, uint32_t) const
+            {
+                ++m_calls;
+            }
+
+            bool enabled() const
+            {
+                return Enabled;
+            }
+
+            mutable uint32_t m_calls;
+        };
+
+        /// Dummy stack only supporting region_add
+        class dummy_add_only
+        {
+        public:
+
+            typedef binary field_type;
+            typedef field_type::value_type value_type;
+
+            static const bool statically_enabled = true;
+
+        public:
+
+            void region_add(value_type*, const value_type*, uint32_t) const
+            { }
+
+            uint32_t alignment() const
+            {
+                return 1U;
+            }
+
+            uint32_t max_alignment() const
+            {
+                return 1U;
+            }
+
+            uint32_t granularity() const
+            {
+                return 1U;
+            }
+
+            uint32_t max_granularity() const
+            {
+                return 1U;
+            }
+        };
+
+        typedef helper_region_info<
+            /*alignment=*/1U,
+            /*max_alignment=*/10U,
+            /*granularity=*/3U,
+            /*max_granularity=*/30U,
+            dummy<binary, true>> super_stack;
+
+        class dummy_stack_enabled :
+            public region_static_dispatcher_specialization<
+                       binary,
+                       helper_region_info<
+                           /*alignment=*/2U,
+                           /*max_alignment=*/20U,
+                           /*granularity=*/4U,
+                           /*max_granularity=*/40U,
+                       dummy<binary, true>>,
+                       binary,
+                       super_stack>
+        { };
+
+        class dummy_stack_disabled :
+            public region_static_dispatcher_specialization<
+                       binary,
+                       helper_region_info<
+                           /*alignment=*/2U,
+                           /*max_alignment=*/20U,
+                           /*granularity=*/4U,
+                           /*max_granularity=*/40U,
+                       dummy<binary, false>>,
+                       binary,
+                       super_stack>
+        { };
+
+        class dummy_stack_other_field :
+            public region_static_dispatcher_specialization<
+                       binary,
+                       helper_region_info<
+                           /*alignment=*/2U,
+                           /*max_alignment=*/20U,
+                           /*granularity=*/4U,
+                           /*max_granularity=*/40U,
+                       dummy<binary8, true>>,
+                       binary8,
+                       super_stack>
+        { };
+
+        class dummy_stack_add_only :
+            public region_static_dispatcher_specialization<
+                       binary, dummy_add_only, binary, super_stack>
+        { };
+    }
+}
+
+TEST(test_region_static_dispatcher_specialization, region_info)
+{
+    fifi::dummy_stack_enabled enabled_stack;
+    fifi::dummy_stack_disabled disabled_stack;
+    fifi::dummy_stack_other_field other_field_stack;
+
+    EXPECT_TRUE(enabled_stack.enabled());
+    EXPECT_EQ(2U, enabled_stack.alignment());
+    EXPECT_EQ(20U, enabled_stack.max_alignment());
+    EXPECT_EQ(4U, enabled_stack.granularity());
+    EXPECT_EQ(40U, enabled_stack.max_granularity());
+
+    EXPECT_EQ(1U, disabled_stack.alignment());
+    EXPECT_EQ(10U, disabled_stack.max_alignment());
+    EXPECT_EQ(3U, disabled_stack.granularity());
+    EXPECT_EQ(30U, disabled_stack.max_granularity());
+
+    EXPECT_EQ(1U, other_field_stack.alignment());
+    EXPECT_EQ(30U, other_field_stack.max_granularity());
+}
+
+TEST(test_region_static_dispatcher_specialization, dispatch)
+{
+    uint32_t length = 1;
+    std::vector<uint8_t> dest(length);
+    std::vector<uint8_t> src(length);
+    uint8_t constant = 255;
+
+    // The disabled stack is not embedded, so all calls go to Super
+    fifi::dummy_stack_disabled disabled_stack;
+
+    disabled_stack.region_add(dest.data(), src.data(), length);
+    disabled_stack.region_multiply_constant(dest.data(), constant, length);
+    EXPECT_EQ(2U, disabled_stack.m_calls);
+
+    // The enabled stack receives all the calls
+    fifi::dummy_stack_enabled enabled_stack;
+
+    enabled_stack.region_add(dest.data(), src.data(), length);
+    enabled_stack.region_subtract(dest.data(), src.data(), length);
+    enabled_stack.region_multiply(dest.data(), src.data(), length);
+    enabled_stack.region_divide(dest.data(), src.data(), length);
+    enabled_stack.region_multiply_constant(dest.data(), constant, length);
+    enabled_stack.region_multiply_add(
+        dest.data(), src.data(), constant, length);
+    enabled_stack.region_multiply_subtract(
+        dest.data(), src.data(), constant, length);
+
+    const fifi::super_stack& super = enabled_stack;
+    EXPECT_EQ(0U, super.m_calls);
+
+    // Operations not supported by the stack are called on Super
+    fifi::dummy_stack_add_only add_only_stack;
+
+    add_only_stack.region_add(dest.data(), src.data(), length);
+    EXPECT_EQ(0U, add_only_stack.m_calls);
+
+    add_only_stack.region_divide(dest.data(), src.data(), length);
+    add_only_stack.region_multiply_add(
+        dest.data(), src.data(), constant, length);
+    EXPECT_EQ(2U, add_only_stack.m_calls);
+}
@@ -0,0 +1,102 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <string>
+
+#include <fifi/region_thresholds.hpp>
+
+#include <gtest/gtest.h>
+
+TEST(test_region_thresholds, default)
+{
+    fifi::region_thresholds thresholds;
+
+    for (uint32_t i = 0; i < fifi::region_thresholds::operations; ++i)
+    {
+        auto op = (fifi::region_thresholds::operation) i;
+        EXPECT_EQ(0U, thresholds[op]);
+    }
+}
+
+TEST(test_region_thresholds, name)
+{
+    EXPECT_EQ(std::string("region_add"), fifi::region_thresholds::name(
+        fifi::region_thresholds::region_add));
+    EXPECT_EQ(std::string("region_multiply_add_many"),
+        fifi::region_thresholds::name(
+            fifi::region_thresholds::region_multiply_add_many));
+}
+
+TEST(test_region_thresholds, write_read)
+{
+    fifi::region_thresholds thresholds;
+
+    for (uint32_t i = 0; i < fifi::region_thresholds::operations; ++i)
+    {
+        auto op = (fifi::region_thresholds::operation) i;
+        thresholds[op] = 16U << i;
+    }
+
+    thresholds[fifi::region_thresholds::region_divide] =
+        std::numeric_limits<uint32_t>::max();
+
+    std::stringstream stream;
+    thresholds.write(stream);
+
+    fifi::region_thresholds loaded;
+    EXPECT_NE(thresholds, loaded);
+    EXPECT_TRUE(loaded.read(stream));
+    EXPECT_EQ(thresholds, loaded);
+}
+
+TEST(test_region_thresholds, read_partial)
+{
+    std::stringstream stream("region_multiply_add 64\n\nregion_add 32\n");
+
+    fifi::region_thresholds thresholds;
+    thresholds[fifi::region_thresholds::region_subtract] = 8U;
+
+    EXPECT_TRUE(thresholds.read(stream));
+
+    EXPECT_EQ(32U, thresholds[fifi::region_thresholds::region_add]);
+    EXPECT_EQ(64U, thresholds[fifi::region_thresholds::region_multiply_add]);
+
+    // Operations which are not listed keep their threshold
+    EXPECT_EQ(8U, thresholds[fifi::region_thresholds::region_subtract]);
+    EXPECT_EQ(0U, thresholds[fifi::region_thresholds::region_divide]);
+}
+
+TEST(test_region_thresholds, read_invalid)
+{
+    const char* invalid[] =
+    {
+        "region_add\n",
+        "region_add x\n",
+        "region_add -1\n",
+        "region_add 4294967296\n",
+        "region_add 32 64\n",
+        "region_unknown 32\n",
+        "region_subtract 16\nregion_add\n"
+    };
+
+    for (const char* text : invalid)
+    {
+        SCOPED_TRACE(testing::Message() << "text: " << text);
+
+        std::stringstream stream(text);
+
+        fifi::region_thresholds thresholds;
+        thresholds[fifi::region_thresholds::region_add] = 8U;
+
+        EXPECT_FALSE(thresholds.read(stream));
+
+        // The thresholds are unchanged if the stream is invalid
+        EXPECT_EQ(8U, thresholds[fifi::region_thresholds::region_add]);
+        EXPECT_EQ(0U, thresholds[fifi::region_thresholds::region_subtract]);
+    }
+}
@@ -0,0 +1,91 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <cstdint>
+#include <vector>
+
+#include <fifi/scheduler_job.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    /// Job recording the executed tasks
+    class dummy_job : public fifi::scheduler_job
+    {
+    public:
+
+        dummy_job(uint32_t tasks) :
+            m_executed(tasks, 0)
+        { }
+
+        ~dummy_job()
+        {
+            wait();
+        }
+
+        uint32_t tasks() const
+        {
+            return (uint32_t) m_executed.size();
+        }
+
+        void execute(uint32_t index)
+        {
+            ++m_executed[index];
+        }
+
+        std::vector<uint32_t> m_executed;
+    };
+}
+
+TEST(test_scheduler_job, run)
+{
+    dummy_job job(3);
+    EXPECT_TRUE(job.is_done());
+
+    uint32_t callbacks = 0;
+    job.start([&] { ++callbacks; });
+    EXPECT_FALSE(job.is_done());
+
+    for (uint32_t i = 0; i < job.tasks(); ++i)
+    {
+        job.execute(i);
+        job.finish();
+
+        // The callback is called when the last task is finished
+        EXPECT_EQ(i == 2 ? 1U : 0U, callbacks);
+    }
+
+    EXPECT_TRUE(job.is_done());
+    job.wait();
+
+    EXPECT_EQ(std::vector<uint32_t>({1, 1, 1}), job.m_executed);
+
+    // The job can be run again
+    job.start(fifi::scheduler_job::callback_type());
+    EXPECT_FALSE(job.is_done());
+
+    for (uint32_t i = 0; i < job.tasks(); ++i)
+    {
+        job.execute(i);
+        job.finish();
+    }
+
+    EXPECT_TRUE(job.is_done());
+    EXPECT_EQ(1U, callbacks);
+    EXPECT_EQ(std::vector<uint32_t>({2, 2, 2}), job.m_executed);
+}
+
+TEST(test_scheduler_job, empty)
+{
+    dummy_job job(0);
+
+    // A job without tasks completes when it is started
+    uint32_t callbacks = 0;
+    job.start([&] { ++callbacks; });
+
+    EXPECT_TRUE(job.is_done());
+    EXPECT_EQ(1U, callbacks);
+}
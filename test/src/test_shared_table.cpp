@@ -0,0 +1,81 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <fifi/binary8.hpp>
+#include <fifi/full_table.hpp>
+#include <fifi/shared_table.hpp>
+
+#include <gtest/gtest.h>
+
+namespace fifi
+{
+    // Put dummy layers and tests classes in an anonymous namespace
+    // to avoid violations of ODF (one-definition-rule) in other
+    // translation units
+    namespace
+    {
+        /// Table counting the number of times it has been built
+        struct counting_table
+        {
+            counting_table()
+            {
+                ++m_constructions;
+            }
+
+            static uint32_t m_constructions;
+        };
+
+        uint32_t counting_table::m_constructions = 0;
+    }
+}
+
+TEST(test_shared_table, built_once)
+{
+    const fifi::counting_table* first =
+        &fifi::shared_table<fifi::counting_table>();
+
+    std::vector<std::thread> threads;
+    std::vector<const fifi::counting_table*> tables(8, nullptr);
+
+    for (uint32_t i = 0; i < tables.size(); ++i)
+    {
+        threads.push_back(std::thread([&tables, i]()
+        {
+            tables[i] = &fifi::shared_table<fifi::counting_table>();
+        }));
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (auto table : tables)
+    {
+        EXPECT_EQ(first, table);
+    }
+
+    EXPECT_EQ(1U, fifi::counting_table::m_constructions);
+}
+
+TEST(test_shared_table, stacks_share_tables)
+{
+    fifi::full_table<fifi::binary8> stack_one;
+    fifi::full_table<fifi::binary8> stack_two;
+
+    EXPECT_EQ(stack_one.multiplication_row(0),
+              stack_two.multiplication_row(0));
+    EXPECT_EQ(stack_one.division_row(0), stack_two.division_row(0));
+
+    // A copy uses the same tables
+    fifi::full_table<fifi::binary8> stack_three(stack_one);
+    EXPECT_EQ(stack_one.multiplication_row(0),
+              stack_three.multiplication_row(0));
+    EXPECT_EQ(stack_one.multiply(7, 9), stack_three.multiply(7, 9));
+}
@@ -100,3 +100,13 @@ TEST(test_simple_online, region_multiply_subtract)
 {
     fifi::check_region_multiply_subtract<fifi::simple_online>();
 }
+
+TEST(test_simple_online, region_linear_combination)
+{
+    fifi::check_region_linear_combination<fifi::simple_online>();
+}
+
+TEST(test_simple_online, region_multiply_add_many)
+{
+    fifi::check_region_multiply_add_many<fifi::simple_online>();
+}
@@ -0,0 +1,28 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <fifi/binary16.hpp>
+#include <fifi/split_table.hpp>
+
+#include <gtest/gtest.h>
+
+#include "fifi_unit_test/helper_test_arithmetic.hpp"
+#include "fifi_unit_test/helper_test_packed_arithmetic.hpp"
+#include "fifi_unit_test/helper_test_region_arithmetic.hpp"
+
+TEST(test_split_table, binary16)
+{
+    fifi::check_all<fifi::split_table<fifi::binary16>>();
+}
+
+TEST(test_split_table, packed_binary16)
+{
+    fifi::check_packed_all<fifi::split_table<fifi::binary16>>();
+}
+
+TEST(test_split_table, region_binary16)
+{
+    fifi::check_region_all<fifi::split_table<fifi::binary16>>();
+}
@@ -61,3 +61,23 @@ TEST(test_ssse3_binary4_full_table, region_multiply_subtract)
             fifi::ssse3_binary4_full_table>();
     }
 }
+
+TEST(test_ssse3_binary4_full_table, region_linear_combination)
+{
+    fifi::ssse3_binary4_full_table stack;
+    if (stack.enabled())
+    {
+        check_results_region_linear_combination<
+            fifi::ssse3_binary4_full_table>();
+    }
+}
+
+TEST(test_ssse3_binary4_full_table, region_multiply_add_many)
+{
+    fifi::ssse3_binary4_full_table stack;
+    if (stack.enabled())
+    {
+        check_results_region_multiply_add_many<
+            fifi::ssse3_binary4_full_table>();
+    }
+}
@@ -3,6 +3,10 @@
 // See accompanying file LICENSE.rst or
 // http://www.steinwurf.com/licensing
 
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <cpuid/cpuinfo.hpp>
@@ -12,6 +16,7 @@
 #include "fifi_unit_test/helper_test_arithmetic.hpp"
 #include "fifi_unit_test/helper_test_packed_arithmetic.hpp"
 #include "fifi_unit_test/helper_test_region_arithmetic.hpp"
+#include "fifi_unit_test/random_constant.hpp"
 
 
 TEST(test_ssse3_binary8_full_table, region_add)
@@ -61,3 +66,99 @@ TEST(test_ssse3_binary8_full_table, region_multiply_subtract)
             fifi::ssse3_binary8_full_table>();
     }
 }
+
+TEST(test_ssse3_binary8_full_table, region_linear_combination)
+{
+    fifi::ssse3_binary8_full_table stack;
+    if (stack.enabled())
+    {
+        check_results_region_linear_combination<
+            fifi::ssse3_binary8_full_table>();
+    }
+}
+
+TEST(test_ssse3_binary8_full_table, region_multiply_add_many)
+{
+    fifi::ssse3_binary8_full_table stack;
+    if (stack.enabled())
+    {
+        check_results_region_multiply_add_many<
+            fifi::ssse3_binary8_full_table>();
+    }
+}
+
+TEST(test_ssse3_binary8_full_table, region_stream)
+{
+    fifi::ssse3_binary8_full_table stack;
+    if (!stack.enabled())
+    {
+        return;
+    }
+
+    fifi::random_constant<fifi::binary8> constants;
+
+    const uint32_t size = 1 << 20;
+
+    std::vector<uint8_t> src(size);
+    for (auto& v : src)
+    {
+        v = constants.pack();
+    }
+
+    std::vector<uint8_t> initial(size + 16);
+    for (auto& v : initial)
+    {
+        v = constants.pack();
+    }
+
+    // Test aligned and unaligned destinations
+    std::vector<uint8_t> buffer(size + 32);
+    uint8_t* aligned = (uint8_t*)(((uintptr_t)buffer.data() + 15) & ~15);
+
+    for (uint8_t* dest : { aligned, aligned + 1 })
+    {
+        for (uint32_t length : { 16U, 4096U, 65536U + 48U, size })
+        {
+            SCOPED_TRACE(testing::Message() << "length: " << length
+                         << " aligned: " << (dest == aligned));
+
+            uint8_t constant = constants.pack();
+
+            // The reference results are computed without streaming with
+            // the regular stores of the same stack
+            std::vector<uint8_t> expected(
+                initial.begin(), initial.begin() + length);
+
+            for (uint32_t i = 0; i < length; i += 16)
+            {
+                stack.region_multiply_add(
+                    &expected[i], &src[i], constant, 16);
+            }
+
+            std::copy(initial.begin(), initial.begin() + length, dest);
+            stack.region_multiply_add_stream(dest, src.data(), constant,
+                length);
+            EXPECT_TRUE(std::equal(expected.begin(), expected.end(), dest));
+
+            std::copy(initial.begin(), initial.begin() + length, dest);
+            stack.region_multiply_add(dest, src.data(), constant, length);
+            EXPECT_TRUE(std::equal(expected.begin(), expected.end(), dest));
+
+            for (uint32_t i = 0; i < length; i += 16)
+            {
+                stack.region_multiply_constant(&expected[i], constant, 16);
+            }
+
+            stack.region_multiply_constant_stream(dest, constant, length);
+            EXPECT_TRUE(std::equal(expected.begin(), expected.end(), dest));
+
+            for (uint32_t i = 0; i < length; i += 16)
+            {
+                stack.region_multiply_constant(&expected[i], constant, 16);
+            }
+
+            stack.region_multiply_constant(dest, constant, length);
+            EXPECT_TRUE(std::equal(expected.begin(), expected.end(), dest));
+        }
+    }
+}
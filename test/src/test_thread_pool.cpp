@@ -0,0 +1,110 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <fifi/thread_pool.hpp>
+
+#include <gtest/gtest.h>
+
+TEST(test_thread_pool, threads)
+{
+    EXPECT_EQ(1U, fifi::thread_pool(1).threads());
+    EXPECT_EQ(4U, fifi::thread_pool(4).threads());
+}
+
+TEST(test_thread_pool, single_thread)
+{
+    fifi::thread_pool pool(1);
+
+    std::thread::id caller = std::this_thread::get_id();
+
+    std::vector<uint32_t> calls;
+    pool.run(5, [&](uint32_t task)
+    {
+        // All tasks run in order on the calling thread
+        EXPECT_EQ(caller, std::this_thread::get_id());
+        calls.push_back(task);
+    });
+
+    EXPECT_EQ(std::vector<uint32_t>({0, 1, 2, 3, 4}), calls);
+}
+
+TEST(test_thread_pool, run)
+{
+    fifi::thread_pool pool(4);
+
+    for (uint32_t tasks = 0; tasks < 100; ++tasks)
+    {
+        SCOPED_TRACE(testing::Message() << "tasks: " << tasks);
+
+        std::vector<std::atomic<uint32_t>> calls(tasks);
+        for (auto& c : calls)
+        {
+            c = 0;
+        }
+
+        pool.run(tasks, [&](uint32_t task)
+        {
+            ASSERT_LT(task, tasks);
+            ++calls[task];
+        });
+
+        // Every task is called exactly once before run() returns
+        for (uint32_t i = 0; i < tasks; ++i)
+        {
+            EXPECT_EQ(1U, calls[i]);
+        }
+    }
+}
+
+TEST(test_thread_pool, uses_workers)
+{
+    fifi::thread_pool pool(4);
+
+    std::mutex mutex;
+    std::set<std::thread::id> ids;
+
+    // Each task waits for a moment so that the workers join the job
+    pool.run(64, [&](uint32_t)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        std::lock_guard<std::mutex> lock(mutex);
+        ids.insert(std::this_thread::get_id());
+    });
+
+    EXPECT_LE(ids.size(), 4U);
+    EXPECT_GT(ids.size(), 1U);
+}
+
+TEST(test_thread_pool, concurrent_run)
+{
+    fifi::thread_pool pool(3);
+
+    std::atomic<uint32_t> sum(0);
+
+    auto job = [&]()
+    {
+        for (uint32_t i = 0; i < 50; ++i)
+        {
+            pool.run(10, [&](uint32_t task) { sum += task; });
+        }
+    };
+
+    // Jobs submitted from different threads run one at a time
+    std::thread first(job);
+    std::thread second(job);
+    first.join();
+    second.join();
+
+    EXPECT_EQ(2U * 50U * 45U, sum.load());
+}
@@ -0,0 +1,195 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <fifi/scheduler_job.hpp>
+#include <fifi/work_stealing_scheduler.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    /// Job counting the executions of each task and the threads
+    /// executing them
+    class dummy_job : public fifi::scheduler_job
+    {
+    public:
+
+        dummy_job(uint32_t tasks) :
+            m_executed(tasks)
+        {
+            for (auto& e : m_executed)
+            {
+                e = 0;
+            }
+        }
+
+        ~dummy_job()
+        {
+            wait();
+        }
+
+        uint32_t tasks() const
+        {
+            return (uint32_t) m_executed.size();
+        }
+
+        void execute(uint32_t index)
+        {
+            ++m_executed[index];
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_threads.insert(std::this_thread::get_id());
+        }
+
+        std::vector<std::atomic<uint32_t>> m_executed;
+
+        std::mutex m_mutex;
+        std::set<std::thread::id> m_threads;
+    };
+
+    /// Job with a single task which runs until it is released
+    class blocking_job : public fifi::scheduler_job
+    {
+    public:
+
+        blocking_job(const std::atomic<bool>& release) :
+            m_release(release)
+        { }
+
+        ~blocking_job()
+        {
+            wait();
+        }
+
+        uint32_t tasks() const
+        {
+            return 1U;
+        }
+
+        void execute(uint32_t)
+        {
+            while (!m_release)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        const std::atomic<bool>& m_release;
+    };
+}
+
+TEST(test_work_stealing_scheduler, threads)
+{
+    EXPECT_EQ(1U, fifi::work_stealing_scheduler(1).threads());
+    EXPECT_EQ(3U, fifi::work_stealing_scheduler(3).threads());
+}
+
+TEST(test_work_stealing_scheduler, submit)
+{
+    fifi::work_stealing_scheduler scheduler(4);
+
+    for (uint32_t tasks = 0; tasks < 50; ++tasks)
+    {
+        SCOPED_TRACE(testing::Message() << "tasks: " << tasks);
+
+        dummy_job job(tasks);
+
+        std::atomic<uint32_t> callbacks(0);
+        scheduler.submit(job, [&] { ++callbacks; });
+        job.wait();
+
+        EXPECT_TRUE(job.is_done());
+        EXPECT_EQ(1U, callbacks.load());
+        EXPECT_EQ(0U, job.m_threads.count(std::this_thread::get_id()));
+
+        for (uint32_t i = 0; i < tasks; ++i)
+        {
+            EXPECT_EQ(1U, job.m_executed[i].load());
+        }
+    }
+}
+
+TEST(test_work_stealing_scheduler, many_jobs)
+{
+    fifi::work_stealing_scheduler scheduler(3);
+
+    std::vector<std::unique_ptr<dummy_job>> jobs;
+    for (uint32_t i = 0; i < 20; ++i)
+    {
+        jobs.emplace_back(new dummy_job(i + 1));
+    }
+
+    // Submit all jobs before waiting for any of them
+    std::atomic<uint32_t> callbacks(0);
+    for (auto& job : jobs)
+    {
+        scheduler.submit(*job, [&] { ++callbacks; });
+    }
+
+    for (auto& job : jobs)
+    {
+        job->wait();
+
+        for (uint32_t i = 0; i < job->tasks(); ++i)
+        {
+            EXPECT_EQ(1U, job->m_executed[i].load());
+        }
+    }
+
+    EXPECT_EQ(jobs.size(), callbacks.load());
+}
+
+TEST(test_work_stealing_scheduler, steal)
+{
+    fifi::work_stealing_scheduler scheduler(2);
+
+    // A job with a single task blocks one of the workers
+    std::atomic<bool> release(false);
+    blocking_job blocking(release);
+    scheduler.submit(blocking);
+
+    // The tasks of the next job are divided between both queues, so
+    // the free worker must steal the tasks queued for the blocked one
+    dummy_job job(8);
+    scheduler.submit(job);
+    job.wait();
+
+    EXPECT_EQ(1U, job.m_threads.size());
+
+    for (uint32_t i = 0; i < job.tasks(); ++i)
+    {
+        EXPECT_EQ(1U, job.m_executed[i].load());
+    }
+
+    release = true;
+    blocking.wait();
+}
+
+TEST(test_work_stealing_scheduler, destroy)
+{
+    dummy_job job(100);
+
+    {
+        fifi::work_stealing_scheduler scheduler(2);
+        scheduler.submit(job);
+    }
+
+    // The queued tasks are executed before the scheduler is destroyed
+    EXPECT_TRUE(job.is_done());
+
+    for (uint32_t i = 0; i < job.tasks(); ++i)
+    {
+        EXPECT_EQ(1U, job.m_executed[i].load());
+    }
+}